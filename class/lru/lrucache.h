@@ -24,6 +24,8 @@
 #include <unordered_map>
 #include <list>
 #include <mutex>
+#include <functional>
+#include <vector>
 
 
 namespace mariadb
@@ -36,6 +38,8 @@ namespace mariadb
     virtual VT* put(const KT& key, VT* obj2cache) {return nullptr;}
     virtual VT* get(const KT& key) {return nullptr;}
     virtual void clear() {}
+    /* Copies up to maxCount keys into the vector, most recently used first */
+    virtual std::size_t getRecentKeys(std::vector<KT>& keys, std::size_t maxCount) { return 0; }
   };
 
   template <class T> struct DefaultRemover
@@ -45,8 +49,18 @@ namespace mariadb
       delete removedCacheEntry;
     }
   };
+  /* Defines how the key is kept by the cache. The list node owns the stored copy of the key, and the index
+     gets the key returned by indexed(), which may refer to the list node's copy instead of duplicating it.
+     List nodes never move, thus such reference stays valid until the node is evicted */
+  template <class KT> struct CacheKeyTraits
+  {
+    static const KT& stored(const KT& key) { return key; }
+    static const KT& indexed(const KT& storedKey) { return storedKey; }
+  };
+
   // This does not care about the fate of obbjects removed from cache
-  template <class KT, class VT, class Remover= DefaultRemover<VT>> class LruCache : public Cache<KT,VT>
+  template <class KT, class VT, class Remover= DefaultRemover<VT>, class Hash= std::hash<KT>,
+    class KeyTraits= CacheKeyTraits<KT>> class LruCache : public Cache<KT,VT>
   {
     std::mutex lock;
     typedef std::list<std::pair<KT,VT*>> ListType;
@@ -54,7 +68,7 @@ namespace mariadb
 
     std::size_t maxSize;
     ListType lu;
-    std::unordered_map<KT, ListIterator> cache;
+    std::unordered_map<KT, ListIterator, Hash> cache;
 
   protected:
     virtual void remove(ListIterator& it)
@@ -98,15 +112,15 @@ namespace mariadb
       if (cache.size() == maxSize)
       {
         it= removeEldestEntry();
-        it->first= key;
+        it->first= KeyTraits::stored(key);
         it->second= obj2cache;
       }
       else
       {
-        lu.emplace_front(key, obj2cache);
+        lu.emplace_front(KeyTraits::stored(key), obj2cache);
         it= lu.begin();
       }
-      cache.emplace(key, it);
+      cache.emplace(KeyTraits::indexed(it->first), it);
 
       return nullptr;
     }
@@ -139,6 +153,19 @@ namespace mariadb
       }
       lu.clear();
     }
+
+
+    virtual std::size_t getRecentKeys(std::vector<KT>& keys, std::size_t maxCount)
+    {
+      std::lock_guard<std::mutex> localScopeLock(lock);
+      std::size_t count= 0;
+
+      for (auto it= lu.begin(); it != lu.end() && count < maxCount; ++it, ++count)
+      {
+        keys.push_back(it->first);
+      }
+      return count;
+    }
   };
 
 }
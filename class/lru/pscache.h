@@ -22,10 +22,128 @@
 #define _PSCACHE_H_
 
 #include <string>
+#include <cstring>
+#include <cstdint>
 #include "lrucache.h"
 
 namespace mariadb
 {
+  /* 64bit hash of the query text, processing 8 bytes at a time. Does not need to be anything cryptographic,
+     but has to be cheap on 10s of kilobytes of ORM generated SQL */
+  inline uint64_t psCacheHash(const char* str, std::size_t len)
+  {
+    const uint64_t mul= 0x9E3779B97F4A7C15ULL;
+    uint64_t h= len * mul, chunk;
+    const char* end= str + (len & ~static_cast<std::size_t>(7));
+
+    for (; str < end; str+= 8) {
+      std::memcpy(&chunk, str, 8);
+      h= (h ^ chunk) * mul;
+      h^= h >> 29;
+    }
+    chunk= 0;
+    std::memcpy(&chunk, str, len & 7);
+    h= (h ^ chunk) * mul;
+    h^= h >> 32;
+    return h;
+  }
+
+  /* Key of the prepared statements cache. Lookups are done with the key just referencing the query text, i.e. w/out
+     any allocation or copying, and the text is hashed only once, when the key is constructed. Only when the key goes
+     to the cache, the copy owning the text is created. */
+  class PsCacheKey
+  {
+    std::string owned;
+    const char* sql= nullptr;
+    std::size_t sqlLen= 0;
+    uint64_t    hash= 0;
+    uint32_t    schemaId= 0;
+
+  public:
+    PsCacheKey(uint32_t _schemaId, const char* _sql, std::size_t len)
+      : sql(_sql)
+      , sqlLen(len)
+      , hash(psCacheHash(_sql, len) ^ _schemaId)
+      , schemaId(_schemaId)
+    {}
+
+    PsCacheKey(uint32_t _schemaId, const std::string& _sql)
+      : PsCacheKey(_schemaId, _sql.data(), _sql.length())
+    {}
+
+    PsCacheKey() {}
+
+    PsCacheKey(const PsCacheKey& other)
+    {
+      *this= other;
+    }
+
+    /* Copy references same text as the original, unless the original owns it */
+    PsCacheKey& operator=(const PsCacheKey& other)
+    {
+      hash=     other.hash;
+      schemaId= other.schemaId;
+      sqlLen=   other.sqlLen;
+      if (other.sql == other.owned.data()) {
+        owned.assign(other.owned);
+        sql= owned.data();
+      }
+      else {
+        owned.clear();
+        sql= other.sql;
+      }
+      return *this;
+    }
+
+    /* Returns key owning the copy of the query text */
+    PsCacheKey makeOwned() const
+    {
+      PsCacheKey result;
+      result.hash=     hash;
+      result.schemaId= schemaId;
+      result.sqlLen=   sqlLen;
+      result.owned.assign(sql, sqlLen);
+      result.sql= result.owned.data();
+      return result;
+    }
+
+    /* Returns key referencing this key's text */
+    PsCacheKey makeView() const
+    {
+      PsCacheKey result;
+      result.hash=     hash;
+      result.schemaId= schemaId;
+      result.sqlLen=   sqlLen;
+      result.sql=      sql;
+      return result;
+    }
+
+    std::size_t length() const { return sqlLen; }
+    uint64_t getHash() const { return hash; }
+    uint32_t getSchemaId() const { return schemaId; }
+    const char* getSql() const { return sql; }
+
+    bool operator==(const PsCacheKey& other) const
+    {
+      return hash == other.hash && schemaId == other.schemaId && sqlLen == other.sqlLen &&
+        (sql == other.sql || std::memcmp(sql, other.sql, sqlLen) == 0);
+    }
+  };
+
+  struct PsCacheKeyHash
+  {
+    std::size_t operator()(const PsCacheKey& key) const
+    {
+      return static_cast<std::size_t>(key.getHash());
+    }
+  };
+
+  template <> struct CacheKeyTraits<PsCacheKey>
+  {
+    static PsCacheKey stored(const PsCacheKey& key) { return key.makeOwned(); }
+    static PsCacheKey indexed(const PsCacheKey& storedKey) { return storedKey.makeView(); }
+  };
+
   template <class T> struct PsRemover
   {
     // std::mutex lock;
@@ -40,9 +158,9 @@ namespace mariadb
     }
   };
 
-  template <class VT> class PsCache : public LruCache<std::string,VT, PsRemover<VT>>
+  template <class VT> class PsCache : public LruCache<PsCacheKey, VT, PsRemover<VT>, PsCacheKeyHash>
   {
-    typedef LruCache<std::string, VT, PsRemover<VT>> parentLru;
+    typedef LruCache<PsCacheKey, VT, PsRemover<VT>, PsCacheKeyHash> parentLru;
     std::size_t maxKeyLen;
 
   public:
@@ -57,7 +175,7 @@ namespace mariadb
     }
 
 
-    virtual VT* put(const std::string& key, VT* obj2cache)
+    virtual VT* put(const PsCacheKey& key, VT* obj2cache)
     {
       if (key.length() > maxKeyLen) {
         return nullptr;
@@ -75,7 +193,7 @@ namespace mariadb
     }
 
 
-    virtual VT* get(const std::string& key)
+    virtual VT* get(const PsCacheKey& key)
     {
       auto result= this->parentLru::get(key);
       if (result != nullptr)
@@ -18,6 +18,7 @@
 *************************************************************************************/
 
 #include <cstring>
+#include <cstdio>
 
 #include "Parameter.h"
 #include "ColumnDefinition.h"
@@ -218,6 +219,125 @@ namespace mariadb
   }
 
 
+  /**
+   * Appends the value as the field of LOAD DATA input with default field and line terminators and escape character,
+   * i.e. tab separated, with tab, new line, backslash and zero byte escaped, and NULL as \N.
+   *
+   * @return false if the value can't be represented there - that is the case of the column default, or of the type
+   *         isLoadDataType does not accept
+   */
+  bool Parameter::toLoadData(SQLString& out, MYSQL_BIND& param, std::size_t row)
+  {
+    if (param.u.indicator != nullptr) {
+      switch (param.u.indicator[row]) {
+      case STMT_INDICATOR_NULL:
+        out.append("\\N");
+        return true;
+      case STMT_INDICATOR_IGNORE:
+      case STMT_INDICATOR_DEFAULT:
+        return false;
+      }
+    }
+    void* value= getBuffer(param, row);
+    unsigned long length= getLength(param, row);
+
+    if (param.buffer_type > MYSQL_TYPE_TIME2 || typeLen[param.buffer_type] < 0) {
+      const char* str= static_cast<const char*>(value);
+      for (unsigned long i= 0; i < length; ++i) {
+        switch (str[i]) {
+        case '\\': out.append("\\\\"); break;
+        case '\t': out.append("\\t"); break;
+        case '\n': out.append("\\n"); break;
+        case '\0': out.append("\\0"); break;
+        default:   out.append(1, str[i]);
+        }
+      }
+      return true;
+    }
+    char number[32];
+    switch (param.buffer_type)
+    {
+    case MYSQL_TYPE_BIT:
+    case MYSQL_TYPE_TINY:
+      out.append(param.is_unsigned ? std::to_string(*static_cast<uint8_t*>(value)) : std::to_string(*static_cast<int8_t*>(value)));
+      break;
+    case MYSQL_TYPE_YEAR:
+    case MYSQL_TYPE_SHORT:
+      out.append(param.is_unsigned ? std::to_string(*static_cast<uint16_t*>(value)) : std::to_string(*static_cast<int16_t*>(value)));
+      break;
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+      out.append(param.is_unsigned ? std::to_string(*static_cast<uint32_t*>(value)) : std::to_string(*static_cast<int32_t*>(value)));
+      break;
+    case MYSQL_TYPE_LONGLONG:
+      out.append(param.is_unsigned ? std::to_string(*static_cast<uint64_t*>(value)) : std::to_string(*static_cast<int64_t*>(value)));
+      break;
+    // Shortest text, that is read back to the same value
+    case MYSQL_TYPE_FLOAT:
+      out.append(number, std::snprintf(number, sizeof(number), "%.9g", *static_cast<float*>(value)));
+      break;
+    case MYSQL_TYPE_DOUBLE:
+      out.append(number, std::snprintf(number, sizeof(number), "%.17g", *static_cast<double*>(value)));
+      break;
+    case MYSQL_TYPE_NULL:
+      out.append("\\N");
+      break;
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_NEWDATE:
+      addDate(out, static_cast<MYSQL_TIME*>(value));
+      break;
+    case MYSQL_TYPE_TIME:
+    case MYSQL_TYPE_TIME2:
+      addTime(out, static_cast<MYSQL_TIME*>(value));
+      break;
+    case MYSQL_TYPE_TIMESTAMP:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_DATETIME2:
+    case MYSQL_TYPE_TIMESTAMP2:
+      addDate(out, static_cast<MYSQL_TIME*>(value));
+      out.append(1, ' ');
+      addTime(out, static_cast<MYSQL_TIME*>(value));
+      break;
+    default:
+      return false;
+    }
+    return true;
+  }
+
+
+  /* Returns true if values of the parameter's type can be written by toLoadData */
+  bool Parameter::isLoadDataType(const MYSQL_BIND& param)
+  {
+    if (param.buffer_type > MYSQL_TYPE_TIME2 || typeLen[param.buffer_type] < 0) {
+      return true;
+    }
+    switch (param.buffer_type)
+    {
+    case MYSQL_TYPE_BIT:
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_YEAR:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+    case MYSQL_TYPE_FLOAT:
+    case MYSQL_TYPE_DOUBLE:
+    case MYSQL_TYPE_NULL:
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_NEWDATE:
+    case MYSQL_TYPE_TIME:
+    case MYSQL_TYPE_TIME2:
+    case MYSQL_TYPE_TIMESTAMP:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_DATETIME2:
+    case MYSQL_TYPE_TIMESTAMP2:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+
   std::size_t Parameter::getApproximateStringLength(MYSQL_BIND& param, std::size_t row)
   {
     unsigned long length= getLength(param, row);
@@ -39,6 +39,8 @@ public:
   static SQLString& toString(SQLString& query, MYSQL_BIND& param, std::size_t row, bool noBackslashEscapes);
 
   static std::size_t getApproximateStringLength(MYSQL_BIND& param, std::size_t row);
+  static bool toLoadData(SQLString& out, MYSQL_BIND& param, std::size_t row);
+  static bool isLoadDataType(const MYSQL_BIND& param);
 };
 
 }
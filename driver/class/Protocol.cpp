@@ -20,8 +20,16 @@
 
 #include <random>
 #include <chrono>
+#include <algorithm>
 
 #include "mysqld_error.h"
+#include "errmsg.h"
+
+#ifndef _WIN32
+# include <poll.h>
+# include <sys/socket.h>
+# include <errno.h>
+#endif
 
 #include "lru/pscache.h"
 
@@ -31,6 +39,7 @@
 #include "ServerPrepareResult.h"
 #include "Exception.h"
 #include "interface/ResultSet.h"
+#include "interface/PreparedStatement.h"
 #include "Results.h"
 
 #define DEFAULT_TRX_ISOL_VARNAME "tx_isolation"
@@ -77,6 +86,31 @@ namespace mariadb
     return query;
   }
 
+  /* Appends assignment of the session isolation level variable, i.e. the form that can be combined with other variables
+     in one SET */
+  SQLString& addTxIsolationAssignment2Query(SQLString& query, const SQLString& varName, enum IsolationLevel txIsolation)
+  {
+    SQLString levelName(TxIsolationLevel2Name.at(txIsolation));
+    std::replace(levelName.begin(), levelName.end(), ' ', '-');
+
+    return query.append("@@SESSION.").append(varName.empty() ? DEFAULT_TRX_ISOL_VARNAME : varName)
+      .append("='").append(levelName).append(1, '\'');
+  }
+
+
+  /* Appends the identifier in backticks, that it may contain, doubled */
+  static SQLString& appendQuotedIdentifier(SQLString& query, const SQLString& identifier)
+  {
+    query.append(1, '`');
+    for (auto c : identifier) {
+      if (c == '`') {
+        query.append(1, '`');
+      }
+      query.append(1, c);
+    }
+    return query.append(1, '`');
+  }
+
 
   SQLException fromStmtError(MYSQL_STMT* stmt)
   {
@@ -103,13 +137,71 @@ namespace mariadb
 
   void Protocol::unsyncedReset()
   {
+    std::vector<PsCacheKey> hotSet;
+
+    // Reset closes all statements on the server. Remembering those most used, to prepare them again
+    if (psCacheWarmup > 0) {
+      serverPrepareStatementCache->getRecentKeys(hotSet, psCacheWarmup);
+    }
+    invalidateResultCache();
     if (mysql_reset_connection(connection.get()))
     {
       // I wonder if connection in this case may stay ok, and we shouldn't clear the cache anyway
       throw SQLException("Connection reset failed");
     }
-    serverPrepareStatementCache->clear();
+    const uint32_t schemaId= getPsCacheSchemaId();
+    clearPsCache();
     cmdEpilog();
+    // Schema ids have been re-assigned with the cache cleared - re-keying remembered statements of the current schema
+    const uint32_t newSchemaId= getPsCacheSchemaId();
+    std::vector<PsCacheKey> warmupSet;
+    for (const auto& key : hotSet) {
+      if (key.getSchemaId() == schemaId) {
+        warmupSet.emplace_back(newSchemaId, key.getSql(), key.length());
+      }
+    }
+    warmUpPsCache(warmupSet);
+  }
+
+
+  /* Clears the prepared statements cache together with the schema ids used in its keys */
+  void Protocol::clearPsCache()
+  {
+    serverPrepareStatementCache->clear();
+    psCacheSchemaIds.clear();
+    psCacheSchema.clear();
+    psCacheSchemaId= 0;
+  }
+
+  /**
+   * Prepares statements from the list and puts them to the cache. Statements are prepared in reverse order, i.e. the
+   * least recently used first, so that the cache order stays the same. Only statements prepared in the current schema
+   * are re-prepared. Failure to prepare is not an error here - application will get it, if it prepares the query itself.
+   */
+  void Protocol::warmUpPsCache(const std::vector<PsCacheKey>& keys)
+  {
+    const uint32_t schemaId= getPsCacheSchemaId();
+
+    for (auto it= keys.rbegin(); it != keys.rend(); ++it) {
+      if (it->getSchemaId() != schemaId) {
+        continue;
+      }
+      try {
+        ServerPrepareResult* pr= prepareInternal(SQLString(it->getSql(), it->length()));
+        // Nobody uses this result but the cache. If it didn't go to the cache, it's not needed at all
+        if (pr->getShareCounter() > 1) {
+          pr->decrementShareCounter();
+        }
+        else {
+          delete pr;
+        }
+      }
+      catch (SQLException&) {
+        if (mysql_get_socket(connection.get()) == MARIADB_INVALID_SOCKET) {
+          throw;
+        }
+      }
+    }
   }
 
   void Protocol::reset()
@@ -126,15 +218,16 @@ namespace mariadb
  * @param 
  * @param 
  */
-  Protocol::Protocol(MYSQL* connectedHandle, const SQLString& defaultDb, Cache<std::string, ServerPrepareResult> *psCache, const char *trIsolVarName,
+  Protocol::Protocol(MYSQL* connectedHandle, const SQLString& defaultDb, Cache<PsCacheKey, ServerPrepareResult> *psCache, const char *trIsolVarName,
     enum IsolationLevel txIsolation )
     : connection(connectedHandle, &mysql_close)
-    , transactionIsolationLevel(txIsolation)
+    , transactionIsolationLevel(txIsolation != TRANSACTION_NONE ? txIsolation : TRANSACTION_REPEATABLE_READ)
     , database(defaultDb)
     , connected(true)
     , serverVersion(mysql_get_server_info(connectedHandle))
     , serverPrepareStatementCache(psCache)
     , txIsolationVarName(trIsolVarName ? trIsolVarName : "")
+    , lastIoTime(std::chrono::steady_clock::now())
   {
     parseVersion(serverVersion);
 
@@ -153,33 +246,51 @@ namespace mariadb
     serverCaps= serverCaps << 32;
     serverCaps|= baseCaps;
     this->serverCapabilities= serverCaps;
+    multiStatements= (connectedHandle->client_flag & CLIENT_MULTI_STATEMENTS) != 0;
 
     getServerStatus();
-    if (sessionStateAware())
-      sendSessionInfos(trIsolVarName);
+    sendSessionInfos(txIsolation);
   }
 
-
-  void Protocol::sendSessionInfos(const char *trIsolVarName)
+  /**
+   * Post-connect session setup. Session tracking configuration and the requested isolation level are sent with a single
+   * query. MySQL does not have ansi_quotes in the server status, and we need to track sql_mode. Its initial value is
+   * obtained by re-assigning sql_mode in the same query, i.e. it comes with the session tracking info of its response.
+   * The separate query to read it is only the fallback, if the server did not report the change.
+   */
+  void Protocol::sendSessionInfos(enum IsolationLevel txIsolation)
   {
-    if (!trIsolVarName) {
-      trIsolVarName= DEFAULT_TRX_ISOL_VARNAME;
-    }
+    SQLString query("SET ");
 
-    SQLString sessionOption("SET session_track_schema=1,session_track_system_variables='auto_increment_increment,");
+    if (sessionStateAware()) {
+      query.append("session_track_schema=1,session_track_system_variables='auto_increment_increment,")
+        .append(txIsolationVarName.empty() ? DEFAULT_TRX_ISOL_VARNAME : txIsolationVarName);
+      if (!serverMariaDb) {
+        query.append(",sql_mode',sql_mode=@@sql_mode");
+      }
+      else {
+        query.append(1, '\'');
+      }
+    }
+    if (txIsolation != TRANSACTION_NONE) {
+      if (query.length() > 4) {
+        query.append(1, ',');
+      }
+      addTxIsolationAssignment2Query(query, txIsolationVarName, txIsolation);
+    }
+    // Nothing to set
+    if (query.length() == 4) {
+      return;
+    }
+    realQuery(query);
+    cmdEpilog();
 
-    sessionOption.append(trIsolVarName);
-    // MySQL does not have ansi_quotes in status, need to track it
-    if (!serverMariaDb) {
-      sessionOption.append(",sql_mode");
-      // Getting initial value
+    if (sessionStateAware() && !serverMariaDb && !sqlModeTracked) {
       realQuery("SELECT 1 FROM DUAL WHERE @@sql_mode LIKE '%ansi_quotes%'");
       auto res= mysql_store_result(connection.get());
       ansiQuotes= (mysql_fetch_row(res) != nullptr);
       mysql_free_result(res);
     }
-    sessionOption.append(1,'\'');
-    realQuery(sessionOption);
   }
 
   /**
@@ -200,8 +311,11 @@ namespace mariadb
   void Protocol::executeQuery(Results* results, const SQLString& sql)
   {
     std::lock_guard<std::mutex> localScopeLock(lock);
-    cmdPrologue();
-    
+    cmdPrologue(true);
+
+    if (resultCache && executeWithCache(results, sql)) {
+      return;
+    }
     realQuery(sql);
     getResult(results);
 
@@ -213,6 +327,62 @@ namespace mariadb
   }
 
 
+  /**
+   * Serves the query result from the results cache, or executes the query and caches its result. Only a single cacheable
+   * SELECT is served, in autocommit mode outside of transaction, and only if its result is to be stored - not streamed,
+   * and not spilled to disk. Results with warnings are not cached, since warnings wouldn't be there for the cached copy.
+   * Nothing is served from the cache while session state changes are pending - they have to go with the query.
+   *
+   * @return false if the query has to be executed the usual way
+   */
+  bool Protocol::executeWithCache(Results* results, const SQLString& sql)
+  {
+    PreparedStatement* statement= results->getStatement();
+
+    if (results->getFetchSize() != 0 || (statement != nullptr && statement->getResultMemoryLimit() > 0) ||
+        sessionStatePending() || (serverStatus & SERVER_STATUS_AUTOCOMMIT) == 0 || inTransaction() ||
+        !ResultCache::isCacheable(sql, noBackslashEscapes())) {
+      return false;
+    }
+    const std::string key(ResultCache::makeKey(database, maxRows, sql));
+    std::shared_ptr<const ResultCache::Entry> entry(resultCache->get(key));
+
+    if (!entry) {
+      realQuery(sql);
+      lastIoTime= std::chrono::steady_clock::now();
+      if (mysql_field_count(connection.get()) == 0) {
+        getResult(results);
+        return true;
+      }
+      MYSQL_RES* result= mysql_store_result(connection.get());
+      if (result == nullptr) {
+        throwConnError(connection.get());
+      }
+      std::shared_ptr<ResultCache::Entry> created;
+      try {
+        created= ResultCache::createEntry(result);
+      }
+      catch (...) {
+        mysql_free_result(result);
+        throw;
+      }
+      mysql_free_result(result);
+      getServerStatus();
+      hasWarningsFlag= mysql_warning_count(connection.get()) > 0;
+
+      if (!hasWarningsFlag && !hasMoreResults()) {
+        resultCache->put(key, created);
+      }
+      entry= std::move(created);
+    }
+    else {
+      hasWarningsFlag= false;
+    }
+    results->addResultSet(ResultCache::createResultSet(entry, this, results->getResultSetScrollType()), hasMoreResults());
+    return true;
+  }
+
+
   SQLString& addQueryTimeout(SQLString& sql, int32_t queryTimeout)
   {
     if (queryTimeout > 0) {
@@ -585,7 +755,7 @@ namespace mariadb
   void Protocol::executeBatchStmt(bool mustExecuteOnMaster, Results* results, const std::vector<SQLString>& queries)
   {
     std::lock_guard<std::mutex> localScopeLock(lock);
-    cmdPrologue();
+    cmdPrologue(true);
 
     // check that queries are rewritable
     bool canAggregateSemiColumn= true;
@@ -630,9 +800,27 @@ namespace mariadb
   }
 
 
+  /* Returns the id of the current schema to be used in the prepared statements cache key. Ids are assigned to schema
+     names in order of their appearance, and only the name comparison is needed if the schema has not changed */
+  uint32_t Protocol::getPsCacheSchemaId()
+  {
+    if (psCacheSchemaId == 0 || psCacheSchema.compare(database) != 0) {
+      // Schema names are never forgotten otherwise. Starting over, if the application walks through too many of them
+      if (psCacheSchemaIds.size() >= MAX_PS_CACHE_SCHEMAS && psCacheSchemaIds.find(database) == psCacheSchemaIds.end()) {
+        clearPsCache();
+      }
+      auto it= psCacheSchemaIds.emplace(database, static_cast<uint32_t>(psCacheSchemaIds.size() + 1)).first;
+      psCacheSchemaId= it->second;
+      psCacheSchema= database;
+    }
+    return psCacheSchemaId;
+  }
+
+
   ServerPrepareResult* Protocol::prepareInternal(const SQLString& sql)
   {
-    const SQLString key(getDatabase() + "-" + sql);
+    // Key only references the query text, the text is copied only if the prepare result goes to the cache
+    const PsCacheKey key(getPsCacheSchemaId(), sql);
     ServerPrepareResult* pr= serverPrepareStatementCache->get(key);
 
     if (pr) {
@@ -1008,6 +1196,9 @@ namespace mariadb
     std::lock_guard<std::mutex> localScopeLock(lock);
     cmdPrologue();
 
+    if (resultCache && !resultCache->empty() && !ResultCache::isReadOnly(serverPrepareResult->getSql(), noBackslashEscapes())) {
+      resultCache->clear();
+    }
     //try {
     if (mysql_stmt_execute(serverPrepareResult->getStatementId()) != 0) {
       throwStmtError(serverPrepareResult->getStatementId());
@@ -1020,11 +1211,31 @@ namespace mariadb
     //}
   }
 
+  /**
+   * Fetches next row of the result read via server-side cursor. When prefetched rows are exhausted, C/C sends
+   * COM_STMT_FETCH. Other commands can run on the connection between those, thus the fetch is done under the lock, and
+   * the streamed result, if any, has to be read first.
+   *
+   * @param row - row object of the cursor result
+   * @return mysql_stmt_fetch return code
+   */
+  int32_t Protocol::fetchCursorRow(Row* row)
+  {
+    std::lock_guard<std::mutex> localScopeLock(lock);
+    Results* activeStream= getActiveStreamingResult();
+    if (activeStream) {
+      activeStream->loadFully(false, this);
+      activeStreamingResult= nullptr;
+    }
+    return row->fetchNext();
+  }
+
   /** Rollback transaction. */
   void Protocol::commit()
   {
     std::lock_guard<std::mutex> localScopeLock(lock);
     cmdPrologue();
+    invalidateResultCache();
     if (inTransaction() && mysql_commit(getCHandle())) {
       throwConnError(getCHandle());
     }
@@ -1035,6 +1246,7 @@ namespace mariadb
   {
     std::lock_guard<std::mutex> localScopeLock(lock);
     cmdPrologue();
+    invalidateResultCache();
     
     if (inTransaction() && mysql_rollback(getCHandle())) {
       throwConnError(getCHandle());
@@ -1095,7 +1307,111 @@ namespace mariadb
   {
     std::lock_guard<std::mutex> localScopeLock(lock);
     cmdPrologue();
-    return mysql_ping(connection.get()) == 0;
+    if (mysql_ping(connection.get()) == 0) {
+      lastIoTime= std::chrono::steady_clock::now();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Checks socket state without blocking and without sending anything.
+   *
+   * @return 0 if there is nothing to read, -1 if the peer has closed the connection or the socket is in error state,
+   *         1 if there is unread data
+   */
+  static int probeSocket(my_socket s)
+  {
+    char c;
+#ifdef _WIN32
+    fd_set readSet;
+    struct timeval noWait= {0, 0};
+
+    FD_ZERO(&readSet);
+    FD_SET(s, &readSet);
+
+    int ready= select(0, &readSet, nullptr, nullptr, &noWait);
+    if (ready == 0) {
+      return 0;
+    }
+    if (ready < 0) {
+      return -1;
+    }
+    // select says it won't block
+    int peeked= recv(s, &c, 1, MSG_PEEK);
+    if (peeked < 0) {
+      return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+    }
+#else
+    struct pollfd pfd;
+    pfd.fd= s;
+    pfd.events= POLLIN;
+    pfd.revents= 0;
+
+    int ready;
+    // Interrupted by a signal means nothing about the connection
+    do {
+      ready= poll(&pfd, 1, 0);
+    } while (ready < 0 && errno == EINTR);
+
+    if (ready == 0) {
+      return 0;
+    }
+    if (ready < 0) {
+      return -1;
+    }
+    if ((pfd.revents & (POLLERR | POLLNVAL)) != 0) {
+      return -1;
+    }
+    ssize_t peeked= recv(s, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (peeked < 0) {
+      return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+#endif
+    // 0 bytes on readable socket is EOF
+    return peeked == 0 ? -1 : 1;
+  }
+
+  /**
+   * Liveness check, that normally does not cost a roundtrip. The socket is probed first - closed socket means the
+   * connection is dead. Unsolicited data on idle connection may only be the error packet server sends before closing
+   * it, and that is regarded as dead connection as well. COM_PING is sent only if the connection has been idle longer
+   * than maxIdleTime, or if the socket cannot be probed (e.g. named pipe or shared memory).
+   *
+   * @param maxIdleTime - milliseconds since last server response, that connection is trusted for. 0 means to always ping
+   * @return false if the connection is dead
+   */
+  bool Protocol::isAlive(uint32_t maxIdleTime)
+  {
+    std::lock_guard<std::mutex> localScopeLock(lock);
+
+    if (!connected) {
+      return false;
+    }
+    // Streamed result is being read - data on the socket is expected and connection is obviously in use
+    if (activeStreamingResult != nullptr) {
+      return true;
+    }
+    my_socket s= mysql_get_socket(connection.get());
+
+    if (s != MARIADB_INVALID_SOCKET) {
+      switch (probeSocket(s)) {
+      case 0:
+        if (maxIdleTime > 0 && std::chrono::steady_clock::now() - lastIoTime < std::chrono::milliseconds(maxIdleTime)) {
+          return true;
+        }
+        break;
+      default:
+        return false;
+      }
+    }
+    if (mysql_ping(connection.get()) == 0) {
+      lastIoTime= std::chrono::steady_clock::now();
+      return true;
+    }
+    // ping may fail if status isn't ready, so we need to check errors
+    uint32_t err= mysql_errno(connection.get());
+    return err != CR_SERVER_GONE_ERROR && err != CR_SERVER_LOST;
   }
 
 
@@ -1117,6 +1433,9 @@ namespace mariadb
 
   const SQLString& Protocol::getSchema()
   {
+    if (schemaPending) {
+      return pendingSchema;
+    }
     if (sessionStateAware()) {
 
       return database;
@@ -1141,15 +1460,28 @@ namespace mariadb
   }
 
 
+  /**
+   * Schema change is deferred till next command. It is not sent at all, if the schema with session tracking is known to
+   * be current already. Thus setting the current schema again also cancels the change, that the server has rejected.
+   */
   void Protocol::setSchema(const SQLString& _database)
   {
-    std::unique_lock<std::mutex> localScopeLock(lock);
-    cmdPrologue();
+    std::lock_guard<std::mutex> localScopeLock(lock);
+    if (sessionStateAware() && database.compare(_database) == 0) {
+      schemaPending= false;
+      return;
+    }
+    pendingSchema= _database;
+    schemaPending= true;
+  }
+
+
+  void Protocol::selectDb(const SQLString& _database)
+  {
     if (mysql_select_db(connection.get(), _database.c_str()) != 0) {
       if (mysql_get_socket(connection.get()) == MARIADB_INVALID_SOCKET) {
         std::string msg("Connection lost: ");
         msg.append(mysql_error(connection.get()));
-        localScopeLock.unlock();
         throw SQLException(msg);
       }
       else {
@@ -1177,9 +1509,31 @@ namespace mariadb
 
   bool Protocol::getAutocommit()
   {
+    if (pendingAutocommit >= 0) {
+      return pendingAutocommit != 0;
+    }
     return ((serverStatus & SERVER_STATUS_AUTOCOMMIT) != 0);
   }
 
+  /**
+   * Autocommit mode change is deferred till next command. Server status always has current autocommit mode, and
+   * if it does not change, nothing is sent. Switching autocommit on while in transaction commits it, and that has to
+   * happen now - the application may disconnect without running anything else.
+   */
+  void Protocol::setAutocommit(bool autocommit)
+  {
+    std::lock_guard<std::mutex> localScopeLock(lock);
+    if (((serverStatus & SERVER_STATUS_AUTOCOMMIT) != 0) == autocommit) {
+      pendingAutocommit= -1;
+    }
+    else {
+      pendingAutocommit= autocommit ? 1 : 0;
+      if (autocommit && inTransaction()) {
+        cmdPrologue();
+      }
+    }
+  }
+
   bool Protocol::inTransaction()
   {
     return ((serverStatus & SERVER_STATUS_IN_TRANS) != 0);
@@ -1245,6 +1599,9 @@ namespace mariadb
  
   int32_t Protocol::getTransactionIsolationLevel()
   {
+    if (pendingTxIsolation != TRANSACTION_NONE) {
+      return pendingTxIsolation;
+    }
     if (sessionStateAware())
       return transactionIsolationLevel;
     SQLString query("SELECT @@");
@@ -1365,6 +1722,7 @@ namespace mariadb
     switch (rc)//errorOccurred(pr))
     {
       case 0:
+        lastIoTime= std::chrono::steady_clock::now();
         if (fieldCount(pr) == 0)
         {
           readOk(results, pr);
@@ -1412,33 +1770,37 @@ namespace mariadb
       {
         switch (type) {
         case SESSION_TRACK_SYSTEM_VARIABLES:
-        {
-          mysql_session_track_get_next(getCHandle(), SESSION_TRACK_SYSTEM_VARIABLES, &value, &valueLen);
-
-          if (std::strncmp(key, "auto_increment_increment", len) == 0)
-          {
-            autoIncrementIncrement= std::stoi(value);
-          }
-          else if (std::strncmp(key, txIsolationVarName.c_str(), len) == 0)
-          {
-            transactionIsolationLevel= mapStr2TxIsolation(value, valueLen);
-          }
-          else if (std::strncmp(key, "sql_mode", len) == 0) {
-            ansiQuotes= false;
-            if (valueLen > 10/*ANSI_QUOTES*/) {
-              for (std::size_t i= 0; i < valueLen - 10; ++i) {
-                if (value[i] == 'A' && value[++i] == 'N' && value[++i] == 'S' && value[++i] == 'I' &&
-                  value[++i] == '_' && value[++i] == 'Q') {// That's enough. Even one byte more than enough
-                  ansiQuotes= true;
-                  break;
+          // Several variables may have been changed by one command. They come as name/value pairs
+          do {
+            if (mysql_session_track_get_next(getCHandle(), SESSION_TRACK_SYSTEM_VARIABLES, &value, &valueLen) != 0) {
+              break;
+            }
+            if (std::strncmp(key, "auto_increment_increment", len) == 0)
+            {
+              autoIncrementIncrement= std::stoi(value);
+            }
+            else if (std::strncmp(key, txIsolationVarName.c_str(), len) == 0)
+            {
+              transactionIsolationLevel= mapStr2TxIsolation(value, valueLen);
+            }
+            else if (std::strncmp(key, "sql_mode", len) == 0) {
+              sqlModeTracked= true;
+              ansiQuotes= false;
+              if (valueLen > 10/*ANSI_QUOTES*/) {
+                for (std::size_t i= 0; i < valueLen - 10; ++i) {
+                  if (value[i] == 'A' && value[++i] == 'N' && value[++i] == 'S' && value[++i] == 'I' &&
+                    value[++i] == '_' && value[++i] == 'Q') {// That's enough. Even one byte more than enough
+                    ansiQuotes= true;
+                    break;
+                  }
+                  // Moving to the separator before next mode name
+                  while (i < valueLen - 11 && value[i] != ',') ++i;
                 }
-                // Moving to the separator before next mode name
-                while (i < valueLen - 11 && value[i] != ',') ++i;
               }
             }
-          }
+          } while (mysql_session_track_get_next(getCHandle(), SESSION_TRACK_SYSTEM_VARIABLES, &key, &len) == 0);
           break;
-        }
+
         case SESSION_TRACK_SCHEMA:
           database.assign(key, len);
           break;
@@ -1579,13 +1941,19 @@ namespace mariadb
   }
 
 
-  ServerPrepareResult* Protocol::addPrepareInCache(const SQLString& key, ServerPrepareResult* serverPrepareResult)
+  ServerPrepareResult* Protocol::addPrepareInCache(const PsCacheKey& key, ServerPrepareResult* serverPrepareResult)
   {
     return serverPrepareStatementCache->put(key, serverPrepareResult);
   }
 
 
-  void Protocol::cmdPrologue()
+  /**
+   * Preparation before command. Pending session state changes are sent here, unless the command is the text query -
+   * then they go in front of it with the query itself.
+   *
+   * @param textQuery the command is COM_QUERY sent with realQuery
+   */
+  void Protocol::cmdPrologue(bool textQuery)
   {
     rc= 0;
     if (mustReset)
@@ -1598,6 +1966,9 @@ namespace mariadb
       activeStream->loadFully(false, this);
       activeStreamingResult= nullptr;
     }
+    if (!textQuery) {
+      flushSessionState();
+    }
 
     forceReleaseWaitingPrepareStatement();
 
@@ -1609,6 +1980,7 @@ namespace mariadb
 
   void Protocol::cmdEpilog()
   {
+    lastIoTime= std::chrono::steady_clock::now();
     getServerStatus();
     if (sessionStateChanged())
       handleStateChange();
@@ -1742,7 +2114,7 @@ namespace mariadb
 
   void Protocol::cleanMemory()
   {
-    serverPrepareStatementCache->clear();
+    clearPsCache();
   }
 
   void Protocol::setServerStatus(uint32_t serverStatus)
@@ -1822,6 +2194,9 @@ namespace mariadb
 
   const SQLString& Protocol::getDatabase() const
   {
+    if (schemaPending) {
+      return pendingSchema;
+    }
     return database;
   }
 
@@ -2001,7 +2376,7 @@ namespace mariadb
   }
 
 
-  Cache<std::string, ServerPrepareResult>* Protocol::prepareStatementCache()
+  Cache<PsCacheKey, ServerPrepareResult>* Protocol::prepareStatementCache()
   {
     return serverPrepareStatementCache.get();
   }
@@ -2029,6 +2404,17 @@ namespace mariadb
 
   void Protocol::realQuery(const SQLString& sql)
   {
+    // Anything, that may change the data, makes all cached results stale
+    if (resultCache && !resultCache->empty() && !ResultCache::isReadOnly(sql, noBackslashEscapes())) {
+      resultCache->clear();
+    }
+    if (sessionStatePending()) {
+      if (multiStatements) {
+        realQueryWithSessionState(sql);
+        return;
+      }
+      flushSessionState();
+    }
     if ((rc= mysql_real_query(connection.get(), sql.c_str(),
       static_cast<unsigned long>(sql.length())))) {
       throwConnError(getCHandle());
@@ -2039,7 +2425,7 @@ namespace mariadb
      prolog and epilog, but not synced */
   void Protocol::safeRealQuery(const SQLString& sql)
   {
-    cmdPrologue();
+    cmdPrologue(true);
     realQuery(sql);
     cmdEpilog();
   }
@@ -2053,11 +2439,115 @@ namespace mariadb
   void Protocol::setTransactionIsolation(enum IsolationLevel level)
   {
     std::lock_guard<std::mutex> localScopeLock(lock);
-    cmdPrologue();
-    SQLString query("SET SESSION TRANSACTION ISOLATION LEVEL ");
+    // Throwing on unknown level right away
+    if (TxIsolationLevel2Name.find(level) == TxIsolationLevel2Name.end()) {
+      throw 1;
+    }
+    // Without session tracking we can't be sure, that current level is what we've set last time
+    if (sessionStateAware() && transactionIsolationLevel == level) {
+      pendingTxIsolation= TRANSACTION_NONE;
+    }
+    else {
+      pendingTxIsolation= level;
+    }
+  }
 
-    realQuery(addTxIsolationName2Query(query, level));
+  /* Appends SET of pending autocommit and isolation level changes to the query */
+  void Protocol::appendPendingSet(SQLString& query)
+  {
+    query.append("SET ");
+    if (pendingAutocommit >= 0) {
+      query.append("autocommit=").append(pendingAutocommit != 0 ? "1" : "0");
+    }
+    if (pendingTxIsolation != TRANSACTION_NONE) {
+      if (pendingAutocommit >= 0) {
+        query.append(1, ',');
+      }
+      addTxIsolationAssignment2Query(query, txIsolationVarName, pendingTxIsolation);
+    }
+  }
 
-    transactionIsolationLevel= static_cast<enum IsolationLevel>(level);
+
+  void Protocol::pendingSetApplied()
+  {
+    if (pendingTxIsolation != TRANSACTION_NONE) {
+      transactionIsolationLevel= pendingTxIsolation;
+    }
+    pendingAutocommit=  -1;
+    pendingTxIsolation= TRANSACTION_NONE;
+  }
+
+  /**
+   * Sends session state changes, that have been requested since last command, as separate commands. Autocommit mode and
+   * isolation level are set with the single query, schema change requires COM_INIT_DB. The change stays pending until
+   * the server accepts it, so the session does not silently diverge from what the application has set. The error is
+   * reported by the command, that caused the flush, and the change is attempted again with the next one, unless the
+   * application sets the attribute again.
+   */
+  void Protocol::flushSessionState()
+  {
+    if (pendingAutocommit >= 0 || pendingTxIsolation != TRANSACTION_NONE) {
+      SQLString query;
+      appendPendingSet(query);
+
+      if ((rc= mysql_real_query(connection.get(), query.c_str(), static_cast<unsigned long>(query.length())))) {
+        throwConnError(getCHandle());
+      }
+      pendingSetApplied();
+      cmdEpilog();
+    }
+    if (schemaPending) {
+      selectDb(pendingSchema);
+      schemaPending= false;
+    }
+  }
+
+  /**
+   * Sends the query with pending session state changes in front of it, i.e. in the same packet. The results of the state
+   * changing statements are skipped, and the connection is left at the query's result, as after mysql_real_query. If the
+   * server rejects the change, the query is not executed, and the change stays pending, as with flushSessionState.
+   */
+  void Protocol::realQueryWithSessionState(const SQLString& sql)
+  {
+    const bool setPending= pendingAutocommit >= 0 || pendingTxIsolation != TRANSACTION_NONE;
+    const bool usePending= schemaPending;
+    SQLString query;
+
+    if (setPending) {
+      appendPendingSet(query);
+      query.append(1, ';');
+    }
+    if (usePending) {
+      query.append("USE ");
+      appendQuotedIdentifier(query, pendingSchema);
+      query.append(1, ';');
+    }
+    query.append(sql);
+
+    rc= mysql_real_query(connection.get(), query.c_str(), static_cast<unsigned long>(query.length()));
+    if (setPending) {
+      if (rc != 0) {
+        throwConnError(getCHandle());
+      }
+      pendingSetApplied();
+      rc= mysql_next_result(connection.get());
+    }
+    if (usePending) {
+      if (rc != 0) {
+        if (mysql_get_socket(connection.get()) == MARIADB_INVALID_SOCKET) {
+          throwConnError(getCHandle());
+        }
+        throw SQLException(
+          "Could not select database '" + pendingSchema + "' : " + mysql_error(connection.get()),
+          mysql_sqlstate(connection.get()),
+          mysql_errno(connection.get()));
+      }
+      database= pendingSchema;
+      schemaPending= false;
+      rc= mysql_next_result(connection.get());
+    }
+    if (rc != 0) {
+      throwConnError(getCHandle());
+    }
   }
 }
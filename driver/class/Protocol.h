@@ -24,10 +24,13 @@
 #include <vector>
 #include <mutex>
 #include <memory>
+#include <map>
+#include <chrono>
 
 #include "mysql.h"
 
 #include "lru/pscache.h"
+#include "ResultCache.h"
 #include "SQLString.h"
 #include "Exception.h"
 #include "pimpls.h"
@@ -50,6 +53,7 @@ void         throwStmtError(MYSQL_STMT* stmt);
 SQLException fromConnError(MYSQL* dbc);
 void         throwConnError(MYSQL* dbc);
 SQLString&   addTxIsolationName2Query(SQLString& query, enum IsolationLevel txIsolation);
+SQLString&   addTxIsolationAssignment2Query(SQLString& query, const SQLString& varName, enum IsolationLevel txIsolation);
 
 SQLString&   addQueryTimeout(SQLString& sql, int32_t queryTimeout);
 
@@ -76,7 +80,15 @@ class Protocol
   bool explicitClosed= false;
   SQLString database;
  
-  std::unique_ptr<Cache<std::string, ServerPrepareResult>> serverPrepareStatementCache;
+  std::unique_ptr<Cache<PsCacheKey, ServerPrepareResult>> serverPrepareStatementCache;
+  // Schema names, that have been used for prepared statements cache keys, and their ids in the key
+  std::map<SQLString, uint32_t> psCacheSchemaIds;
+  uint32_t  psCacheSchemaId= 0;
+  SQLString psCacheSchema;
+  // Number of most recently used cached statements to re-prepare after the connection reset
+  std::size_t psCacheWarmup= 0;
+  // Cache of text protocol results, if enabled for the connection
+  std::unique_ptr<ResultCache> resultCache;
 
   int64_t serverCapabilities= 0;
   int32_t socketTimeout= 0;
@@ -89,9 +101,20 @@ class Protocol
   SQLString txIsolationVarName;
   bool     mustReset= false;
   bool     ansiQuotes= false;
+  // If sql_mode has been reported by session tracking. Needed for MySQL only
+  bool     sqlModeTracked= false;
+  // Session state changes requested by application, but not yet sent to the server. They go in front of the next query
+  // if multi-statements are enabled, and are sent separately before next command otherwise
+  int8_t              pendingAutocommit= -1; // -1 - no change pending
+  enum IsolationLevel pendingTxIsolation= TRANSACTION_NONE;
+  bool                schemaPending= false;
+  SQLString           pendingSchema;
+  bool                multiStatements= false;
+  // Time of the last server response. Used to decide whether the liveness check has to go to the server
+  std::chrono::steady_clock::time_point lastIoTime;
 
   // ----- private methods -----
-  void cmdPrologue();
+  void cmdPrologue(bool textQuery= false);
   void cmdEpilog();
   void executeBatch(Results*, const std::vector<SQLString>& queries);
   void executeBatchAggregateSemiColon(Results*, const std::vector<SQLString>& queries, std::size_t totalLenEstimation);
@@ -106,26 +129,39 @@ class Protocol
   void parseVersion(const SQLString& _serverVersion);
   void destroySocket();
   void abortActiveStream();
-  void sendSessionInfos(const char *trIsolVarName);
+  void sendSessionInfos(enum IsolationLevel txIsolation);
   uint32_t             errorOccurred(ServerPrepareResult *pr);
   SQLException         processError(Results*, ServerPrepareResult *pr);
   ServerPrepareResult* prepareInternal(const SQLString& sql);
+  uint32_t getPsCacheSchemaId();
   Protocol()= delete;
   void unsyncedReset();
+  void warmUpPsCache(const std::vector<PsCacheKey>& keys);
+  void clearPsCache();
+  inline bool sessionStatePending() const { return pendingAutocommit >= 0 || pendingTxIsolation != TRANSACTION_NONE || schemaPending; }
+  void flushSessionState();
+  void appendPendingSet(SQLString& query);
+  void pendingSetApplied();
+  void realQueryWithSessionState(const SQLString& sql);
+  void selectDb(const SQLString& database);
+  bool executeWithCache(Results*, const SQLString& sql);
 
   static void resetError(MYSQL_STMT *stmt);
 
 public:
   static const int64_t MAX_PACKET_LENGTH;
+  // Max number of schema names remembered for prepared statements cache keys
+  static const std::size_t MAX_PS_CACHE_SCHEMAS= 256;
   static bool checkRemainingSize(int64_t newQueryLen);
 
   ~Protocol() {}
-  Protocol(MYSQL *connectedHandle, const SQLString& defaultDb, Cache<std::string,
+  Protocol(MYSQL *connectedHandle, const SQLString& defaultDb, Cache<PsCacheKey,
     ServerPrepareResult> *psCache= nullptr, /* Temporary before move things here */const char *trIsolVarName= nullptr,
-    enum IsolationLevel txIsolation= TRANSACTION_REPEATABLE_READ);
+    enum IsolationLevel txIsolation= TRANSACTION_NONE);
 
   ServerPrepareResult* prepare(const SQLString& sql);
   bool getAutocommit();
+  void setAutocommit(bool autocommit);
   bool noBackslashEscapes();
   //void connect(); //not used
   bool inTransaction();
@@ -150,10 +186,12 @@ public:
   const SQLString& getUsername() const;
   bool ping();
   bool isValid(int32_t timeout);
+  bool isAlive(uint32_t maxIdleTime);
   void executeQuery(const SQLString& sql);
   void executeQuery(Results*, const SQLString& sql);
   void executeBatchStmt(bool mustExecuteOnMaster, Results*, const std::vector<SQLString>& queries);
   void executePreparedQuery(ServerPrepareResult* serverPrepareResult, Results*);
+  int32_t fetchCursorRow(Row* row);
   void moveToNextSpsResult(Results*, ServerPrepareResult* spr);
   //void skipNextResult(ServerPrepareResult* spr= nullptr);
   void skipAllResults(ServerPrepareResult* spr);
@@ -191,7 +229,7 @@ public:
   uint32_t getServerStatus();
   void removeHasMoreResults();
   void setHasWarnings(bool hasWarnings);
-  ServerPrepareResult* addPrepareInCache(const SQLString& key, ServerPrepareResult* serverPrepareResult);
+  ServerPrepareResult* addPrepareInCache(const PsCacheKey& key, ServerPrepareResult* serverPrepareResult);
   void realQuery(const SQLString& sql);
   void safeRealQuery(const SQLString& sql);
   void removeActiveStreamingResult();
@@ -201,11 +239,15 @@ public:
   bool sessionStateAware();
   bool isInterrupted();
   void stopIfInterrupted();
-  Cache<std::string, ServerPrepareResult>* prepareStatementCache();
+  Cache<PsCacheKey, ServerPrepareResult>* prepareStatementCache();
   inline MYSQL* getCHandle() { return connection.get(); }
   void setTransactionIsolation(enum IsolationLevel level);
   inline bool sessionStateChanged() { return (serverStatus & SERVER_SESSION_STATE_CHANGED) != 0; }
-  void deferredReset() { mustReset= true; }
+  void setPsCacheWarmup(std::size_t count) { psCacheWarmup= count; }
+  // Changes made by other sessions are not seen while the result is cached, thus the cache without TTL is not allowed
+  void setResultCache(std::size_t budget, uint32_t ttlSeconds) { resultCache.reset(budget > 0 && ttlSeconds > 0 ? new ResultCache(budget, ttlSeconds) : nullptr); }
+  inline void invalidateResultCache() { if (resultCache) resultCache->clear(); }
+  void deferredReset() { mustReset= true; pendingAutocommit= -1; pendingTxIsolation= TRANSACTION_NONE; schemaPending= false; }
   inline bool getAnsiQuotes() const { return serverMariaDb ? serverStatus & SERVER_STATUS_ANSI_QUOTES : ansiQuotes; }
   };
 
@@ -0,0 +1,370 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation AB
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+
+
+#include <cstring>
+#include <cctype>
+#include <unordered_set>
+
+#include "ResultCache.h"
+#include "ResultSetText.h"
+
+namespace mariadb
+{
+  namespace
+  {
+    // Words, that make the result depend on something besides the data and the query - time, randomness, session
+    // state, sequences or locks. Besides that, SELECT's with locking clauses or INTO are not cached either
+    const std::unordered_set<std::string>& volatileWords()
+    {
+      static const std::unordered_set<std::string> words{
+        "NOW", "SYSDATE", "CURDATE", "CURTIME", "CURRENT_DATE", "CURRENT_TIME", "CURRENT_TIMESTAMP", "LOCALTIME",
+        "LOCALTIMESTAMP", "UTC_DATE", "UTC_TIME", "UTC_TIMESTAMP", "UNIX_TIMESTAMP", "RAND", "RANDOM_BYTES", "UUID",
+        "UUID_SHORT", "SYS_GUID", "NEXTVAL", "LASTVAL", "SETVAL", "NEXT", "PREVIOUS", "LAST_INSERT_ID", "ROW_COUNT",
+        "FOUND_ROWS", "CONNECTION_ID", "SLEEP", "BENCHMARK", "GET_LOCK", "RELEASE_LOCK", "RELEASE_ALL_LOCKS",
+        "IS_FREE_LOCK", "IS_USED_LOCK", "MASTER_POS_WAIT", "MASTER_GTID_WAIT", "USER", "CURRENT_USER", "SESSION_USER",
+        "SYSTEM_USER", "CURRENT_ROLE", "LOAD_FILE", "PERFORMANCE_SCHEMA", "SQL_NO_CACHE", "FOR", "LOCK", "INTO"
+      };
+      return words;
+    }
+
+
+    inline bool isWordChar(char c)
+    {
+      return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$' || (c & 0x80) != 0;
+    }
+
+
+    std::size_t skipQuoted(const SQLString& sql, std::size_t pos, bool noBackslashEscapes)
+    {
+      const char quote= sql[pos];
+      for (++pos; pos < sql.length(); ++pos) {
+        if (sql[pos] == '\\' && quote != '`' && !noBackslashEscapes) {
+          ++pos;
+        }
+        else if (sql[pos] == quote) {
+          return pos + 1;
+        }
+      }
+      return pos;
+    }
+
+    /* Query timeout is set by the prefix, that does not change what the query does. Returns the position of the query
+     * after it */
+    std::size_t skipTimeoutPrefix(const SQLString& sql)
+    {
+      static const char prefix[]= "SET STATEMENT max_statement_time=";
+      const std::size_t prefixLen= sizeof(prefix) - 1;
+
+      if (sql.compare(0, prefixLen, prefix) != 0) {
+        return 0;
+      }
+      std::size_t pos= prefixLen;
+      while (pos < sql.length() && std::isdigit(static_cast<unsigned char>(sql[pos]))) {
+        ++pos;
+      }
+      return sql.compare(pos, 5, " FOR ") == 0 ? pos + 5 : 0;
+    }
+
+    /**
+     * Walks thru the query and calls the visitor for each word, and for '@', outside of literals, quoted identifiers and
+     * comments. Returns false if the query consists of more than one statement, if it has executable comments, or if
+     * the visitor returns false
+     */
+    template <typename Visitor>
+    bool scanQuery(const SQLString& sql, bool noBackslashEscapes, Visitor visit)
+    {
+      const std::size_t len= sql.length();
+      std::size_t pos= skipTimeoutPrefix(sql);
+
+      while (pos < len) {
+        switch (sql[pos]) {
+        case '\'':
+        case '"':
+        case '`':
+          pos= skipQuoted(sql, pos, noBackslashEscapes);
+          break;
+        case '/':
+          if (pos + 1 < len && sql[pos + 1] == '*') {
+            if (pos + 2 < len && (sql[pos + 2] == '!' || (sql[pos + 2] == 'M' && pos + 3 < len && sql[pos + 3] == '!'))) {
+              return false;
+            }
+            pos= sql.find("*/", pos + 2);
+            pos= pos == std::string::npos ? len : pos + 2;
+          }
+          else {
+            ++pos;
+          }
+          break;
+        case '-':
+          if (!(pos + 1 < len && sql[pos + 1] == '-' &&
+               (pos + 2 == len || std::isspace(static_cast<unsigned char>(sql[pos + 2]))))) {
+            ++pos;
+            break;
+          }
+          /* fall through */
+        case '#':
+          pos= sql.find('\n', pos);
+          pos= pos == std::string::npos ? len : pos + 1;
+          break;
+        case ';':
+          for (++pos; pos < len; ++pos) {
+            if (sql[pos] != ';' && !std::isspace(static_cast<unsigned char>(sql[pos]))) {
+              return false;
+            }
+          }
+          break;
+        case '@':
+          if (!visit("@", 1)) {
+            return false;
+          }
+          ++pos;
+          break;
+        default:
+          if (isWordChar(sql[pos])) {
+            std::size_t start= pos;
+            while (pos < len && isWordChar(sql[pos])) {
+              ++pos;
+            }
+            if (!visit(sql.data() + start, pos - start)) {
+              return false;
+            }
+          }
+          else {
+            ++pos;
+          }
+        }
+      }
+      return true;
+    }
+
+
+    bool isKeyword(const char* word, std::size_t length, const char* keyword)
+    {
+      for (std::size_t i= 0; i < length; ++i) {
+        if (keyword[i] == '\0' || std::toupper(static_cast<unsigned char>(word[i])) != keyword[i]) {
+          return false;
+        }
+      }
+      return keyword[length] == '\0';
+    }
+
+
+    std::string toUpper(const char* word, std::size_t length)
+    {
+      std::string result(word, length);
+      for (auto& c : result) {
+        c= static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+      }
+      return result;
+    }
+
+    /* The result set over the rows of the cache entry. It keeps the entry alive, even if it is evicted from the cache
+     * in the meantime */
+    class ResultSetCached : public ResultSetText
+    {
+      const std::shared_ptr<const ResultCache::Entry> entry;
+
+    public:
+      ResultSetCached(std::vector<ColumnDefinition>& columns, const std::shared_ptr<const ResultCache::Entry>& _entry,
+        Protocol* protocol, int32_t resultSetScrollType)
+        : ResultSetText(columns, _entry->rows, protocol, resultSetScrollType)
+        , entry(_entry)
+      {}
+    };
+  }
+
+
+  ResultCache::ResultCache(std::size_t _budget, uint32_t ttlSeconds)
+    : budget(_budget)
+    , ttl(ttlSeconds)
+  {
+  }
+
+
+  bool ResultCache::isReadOnly(const SQLString& sql, bool noBackslashEscapes)
+  {
+    bool first= true, readOnly= false;
+
+    return scanQuery(sql, noBackslashEscapes, [&](const char* word, std::size_t length) {
+      if (first) {
+        first= false;
+        readOnly= isKeyword(word, length, "SELECT") || isKeyword(word, length, "SHOW") ||
+          isKeyword(word, length, "DESC") || isKeyword(word, length, "DESCRIBE");
+      }
+      return readOnly;
+    }) && readOnly;
+  }
+
+
+  bool ResultCache::isCacheable(const SQLString& sql, bool noBackslashEscapes)
+  {
+    const std::unordered_set<std::string>& words= volatileWords();
+    bool first= true, cacheable= false;
+
+    return scanQuery(sql, noBackslashEscapes, [&](const char* word, std::size_t length) {
+      if (first) {
+        first= false;
+        cacheable= isKeyword(word, length, "SELECT");
+      }
+      else if (*word == '@' || words.find(toUpper(word, length)) != words.end()) {
+        cacheable= false;
+      }
+      return cacheable;
+    }) && cacheable;
+  }
+
+  /* The schema and the rows limit are the part of the key, since the same query text may mean different things with
+   * different ones. The query timeout is not */
+  std::string ResultCache::makeKey(const SQLString& schema, int64_t maxRows, const SQLString& sql)
+  {
+    std::string key(schema);
+    key.push_back('\0');
+    key.append(std::to_string(maxRows));
+    key.push_back('\0');
+    std::size_t start= skipTimeoutPrefix(sql), end= sql.length();
+    while (start < end && std::isspace(static_cast<unsigned char>(sql[start]))) {
+      ++start;
+    }
+    while (end > start && (std::isspace(static_cast<unsigned char>(sql[end - 1])) || sql[end - 1] == ';')) {
+      --end;
+    }
+    key.append(sql, start, end - start);
+    return key;
+  }
+
+  /* Values are copied into one buffer in two passes - the first one gets the total length. Each value is terminated
+   * with null, as they are in the stored result, and the text row may rely on that */
+  std::shared_ptr<ResultCache::Entry> ResultCache::createEntry(MYSQL_RES* result)
+  {
+    std::shared_ptr<Entry> entry(new Entry());
+    const unsigned int fieldCount= mysql_num_fields(result);
+    const MYSQL_FIELD* fields= mysql_fetch_fields(result);
+    const std::size_t rowCount= static_cast<std::size_t>(mysql_num_rows(result));
+    std::size_t total= 0;
+    MYSQL_ROW row;
+
+    entry->columns.reserve(fieldCount);
+    for (unsigned int i= 0; i < fieldCount; ++i) {
+      entry->columns.emplace_back(&fields[i]);
+      total+= sizeof(ColumnDefinition) + fields[i].name_length + fields[i].org_name_length + fields[i].table_length +
+        fields[i].org_table_length + fields[i].db_length;
+    }
+    entry->size= total;
+    total= 0;
+
+    mysql_data_seek(result, 0);
+    while ((row= mysql_fetch_row(result)) != nullptr) {
+      unsigned long* lengths= mysql_fetch_lengths(result);
+      for (unsigned int i= 0; i < fieldCount; ++i) {
+        if (row[i] != nullptr) {
+          total+= lengths[i] + 1;
+        }
+      }
+    }
+    entry->values.reset(new char[total]);
+    entry->rows.reserve(rowCount);
+
+    char* pos= entry->values.get();
+    mysql_data_seek(result, 0);
+    while ((row= mysql_fetch_row(result)) != nullptr) {
+      unsigned long* lengths= mysql_fetch_lengths(result);
+      entry->rows.emplace_back();
+      std::vector<bytes_view>& values= entry->rows.back();
+      values.reserve(fieldCount);
+      for (unsigned int i= 0; i < fieldCount; ++i) {
+        if (row[i] == nullptr) {
+          values.emplace_back();
+        }
+        else {
+          std::memcpy(pos, row[i], lengths[i]);
+          pos[lengths[i]]= '\0';
+          values.emplace_back(pos, static_cast<std::size_t>(lengths[i]));
+          pos+= lengths[i] + 1;
+        }
+      }
+    }
+    entry->size+= sizeof(Entry) + total + rowCount*(sizeof(std::vector<bytes_view>) + fieldCount*sizeof(bytes_view));
+
+    return entry;
+  }
+
+  /* The result set gets its own copy of the columns, since it takes them over, and of the row views. Values stay in
+   * the entry */
+  ResultSet* ResultCache::createResultSet(const std::shared_ptr<const Entry>& entry, Protocol* protocol,
+    int32_t resultSetScrollType)
+  {
+    std::vector<ColumnDefinition> columns(entry->columns);
+    return new ResultSetCached(columns, entry, protocol, resultSetScrollType);
+  }
+
+
+  std::shared_ptr<const ResultCache::Entry> ResultCache::get(const std::string& key)
+  {
+    auto it= index.find(key);
+    if (it == index.end()) {
+      return nullptr;
+    }
+    if (it->second->second->expires <= std::chrono::steady_clock::now()) {
+      remove(it->second);
+      return nullptr;
+    }
+    lru.splice(lru.begin(), lru, it->second);
+    return it->second->second;
+  }
+
+
+  bool ResultCache::put(const std::string& key, std::shared_ptr<Entry> entry)
+  {
+    if (entry->size > budget) {
+      return false;
+    }
+    entry->expires= std::chrono::steady_clock::now() + ttl;
+
+    auto it= index.find(key);
+    if (it != index.end()) {
+      remove(it->second);
+    }
+    used+= entry->size;
+    lru.emplace_front(key, std::move(entry));
+    index.emplace(key, lru.begin());
+
+    while (used > budget) {
+      remove(std::prev(lru.end()));
+    }
+    return true;
+  }
+
+
+  void ResultCache::remove(ListType::iterator it)
+  {
+    used-= it->second->size;
+    index.erase(it->first);
+    lru.erase(it);
+  }
+
+
+  void ResultCache::clear()
+  {
+    index.clear();
+    lru.clear();
+    used= 0;
+  }
+
+} // namespace mariadb
@@ -0,0 +1,91 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation AB
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+
+
+#ifndef _RESULTCACHE_H_
+#define _RESULTCACHE_H_
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <chrono>
+#include <string>
+
+#include "mysql.h"
+
+#include "CArray.h"
+#include "ColumnDefinition.h"
+#include "SQLString.h"
+#include "pimpls.h"
+
+namespace mariadb
+{
+/**
+  * Client side cache of text protocol results of the connection. Results are kept with their column definitions and
+  * rows in one piece of memory, and are shared between the cache and result sets served from it. Entries live till
+  * their time to live expires, or are evicted least recently used first, when the total size exceeds the budget.
+  * The cache is not thread-safe - it's used by the protocol under its lock.
+  */
+class ResultCache
+{
+public:
+  struct Entry
+  {
+    std::vector<ColumnDefinition> columns;
+    std::vector<std::vector<bytes_view>> rows;
+    std::unique_ptr<char[]> values;
+    std::size_t size= 0;
+    std::chrono::steady_clock::time_point expires;
+  };
+
+private:
+  typedef std::list<std::pair<std::string, std::shared_ptr<const Entry>>> ListType;
+
+  const std::size_t budget;
+  const std::chrono::seconds ttl;
+  std::size_t used= 0;
+  ListType lru;
+  std::unordered_map<std::string, ListType::iterator> index;
+
+  void remove(ListType::iterator it);
+
+public:
+  ResultCache(std::size_t budget, uint32_t ttlSeconds);
+  ResultCache(const ResultCache&)= delete;
+  ResultCache& operator=(const ResultCache&)= delete;
+
+  // Query, that can't change anything, and thus does not invalidate the cache
+  static bool isReadOnly(const SQLString& sql, bool noBackslashEscapes);
+  // Read only query, which result depends only on the data - e.g. does not use session variables or time functions
+  static bool isCacheable(const SQLString& sql, bool noBackslashEscapes);
+  static std::string makeKey(const SQLString& schema, int64_t maxRows, const SQLString& sql);
+  // Copies the stored result into the new entry, that is not in the cache yet
+  static std::shared_ptr<Entry> createEntry(MYSQL_RES* result);
+  static ResultSet* createResultSet(const std::shared_ptr<const Entry>& entry, Protocol* protocol, int32_t resultSetScrollType);
+
+  std::shared_ptr<const Entry> get(const std::string& key);
+  // Returns false if the entry does not fit the budget, and has not been cached
+  bool put(const std::string& key, std::shared_ptr<Entry> entry);
+  void clear();
+  bool empty() const { return lru.empty(); }
+};
+
+} // namespace mariadb
+#endif
@@ -22,6 +22,7 @@
 #include <array>
 #include <sstream>
 #include <algorithm>
+#include <cstring>
 
 #include "ResultSetBin.h"
 #include "Results.h"
@@ -42,6 +43,8 @@
 
 namespace mariadb
 {
+  long getTypeBinLength(enum_field_types type);
+
   /**
     * Create Streaming resultSet.
     *
@@ -59,14 +62,37 @@ namespace mariadb
       resultBind(nullptr),
       cache(mysql_stmt_field_count(spr->getStatementId()))
   {
-    if (fetchSize == 0 || callableResult) {
+    unsigned long cursorType= CURSOR_TYPE_NO_CURSOR;
+    mysql_stmt_attr_get(capiStmtHandle, STMT_ATTR_CURSOR_TYPE, &cursorType);
+    const uint32_t serverStatus= protocol->getServerStatus();
+    // Server may decide not to open the cursor, then the result is sent as usual
+    cursorFetch= cursorType != CURSOR_TYPE_NO_CURSOR && (serverStatus & SERVER_STATUS_CURSOR_EXISTS) != 0;
+    // Status is remembered with the result, since the connection's one changes as next results are read
+    callableResult= (serverStatus & SERVER_PS_OUT_PARAMS) != 0;
+
+    if (cursorFetch) {
+      // Rows come in batches of STMT_ATTR_PREFETCH_ROWS by COM_STMT_FETCH, and the connection is free between them.
+      // Thus the result does not become the active streaming one, and does not block other statements
+      fetchSize= 1;
+      data.reserve(10);
+      row= new BinRow(columnsInformation, columnInformationLength, capiStmtHandle);
+      streaming= true;
+    }
+    else if (fetchSize == 0 || callableResult) {
+      const std::size_t memoryLimit= statement != nullptr ? statement->getResultMemoryLimit() : 0;
       data.reserve(10);//= new char[10]; // This has to be array of arrays. Need to decide what to use for its representation
-      if (mysql_stmt_store_result(capiStmtHandle)) {
-        throw 1;
+      row= new BinRow(columnsInformation, columnInformationLength, capiStmtHandle);
+      if (memoryLimit > 0) {
+        spillResult(memoryLimit);
+        dataSize= spill->size();
+      }
+      else {
+        if (mysql_stmt_store_result(capiStmtHandle)) {
+          throw 1;
+        }
+        dataSize= static_cast<std::size_t>(mysql_stmt_num_rows(capiStmtHandle));
       }
-      dataSize= static_cast<std::size_t>(mysql_stmt_num_rows(capiStmtHandle));
       resetVariables();
-      row= new BinRow(columnsInformation, columnInformationLength, capiStmtHandle);
     }
     else {
 
@@ -83,7 +109,10 @@ namespace mariadb
 
   ResultSetBin::~ResultSetBin()
   {
-    if (!isFullyLoaded()) {
+    if (cursorFetch) {
+      closeCursor();
+    }
+    else if (!isFullyLoaded()) {
       //close();
       flushPendingServerResults();
     }
@@ -101,6 +130,17 @@ namespace mariadb
   }
 
 
+  /* Unread rows of the cursor do not need to be read - they are not sent until requested. Server closes the cursor on next
+     execution or reset of the statement */
+  void ResultSetBin::closeCursor()
+  {
+    if (!isEof) {
+      mysql_stmt_free_result(capiStmtHandle);
+      resetVariables();
+    }
+  }
+
+
   void ResultSetBin::flushPendingServerResults()
   {
     dataSize= 0;
@@ -110,9 +150,70 @@ namespace mariadb
   }
 
 
+  /**
+    * Reads the whole result into the local store instead of mysql_stmt_store_result, so it takes at most memoryLimit bytes
+    * of memory. Values are stored in the format of the row's default bind, as in the local cache.
+    */
+  void ResultSetBin::spillResult(std::size_t memoryLimit)
+  {
+    MYSQL_BIND* valueBind= static_cast<BinRow*>(row)->getDefaultBind();
+    // The row fetch gives lengths and NULL flags, and values of fixed length types. Longer values are then fetched by column
+    // right into the store
+    std::vector<MYSQL_BIND> fetchBind(valueBind, valueBind + columnInformationLength);
+    std::vector<MYSQL_TIME> shortValues(columnInformationLength);
+    std::vector<bool> fixedLength(columnInformationLength);
+
+    for (int32_t i= 0; i < columnInformationLength; ++i) {
+      fixedLength[i]= getTypeBinLength(columnsInformation[i].getColumnType()) > 0;
+      fetchBind[i].buffer= &shortValues[i];
+      fetchBind[i].buffer_length= std::min<unsigned long>(fetchBind[i].buffer_length, sizeof(MYSQL_TIME));
+    }
+    if (mysql_stmt_bind_result(capiStmtHandle, fetchBind.data())) {
+      throw 1;
+    }
+    spill.reset(new SpillStore(columnInformationLength, memoryLimit));
+
+    int rc;
+    while ((rc= mysql_stmt_fetch(capiStmtHandle)) == 0 || rc == MYSQL_DATA_TRUNCATED) {
+      spill->startRow();
+      for (int32_t i= 0; i < columnInformationLength; ++i) {
+        MYSQL_BIND& column= fetchBind[i];
+        if (valueBind[i].is_null_value != '\0') {
+          spill->addNull();
+          continue;
+        }
+        unsigned long length= fixedLength[i] ? column.buffer_length : valueBind[i].length_value;
+        char* value= spill->addValue(length);
+        if (length <= column.buffer_length) {
+          std::memcpy(value, &shortValues[i], length);
+        }
+        else {
+          MYSQL_BIND longValue(column);
+          longValue.buffer= value;
+          longValue.buffer_length= length;
+          longValue.length= &longValue.length_value;
+          longValue.is_null= &longValue.is_null_value;
+          longValue.error= &longValue.error_value;
+          if (mysql_stmt_fetch_column(capiStmtHandle, &longValue, static_cast<unsigned int>(i), 0)) {
+            throw 1;
+          }
+        }
+      }
+      // C/C only sets the flag for NULL values
+      for (int32_t i= 0; i < columnInformationLength; ++i) {
+        valueBind[i].is_null_value= '\0';
+      }
+    }
+    if (rc != MYSQL_NO_DATA) {
+      throw 1;
+    }
+    spill->finish();
+  }
+
+
   void ResultSetBin::cacheCompleteLocally()
   {
-    if (data.size()) {
+    if (data.size() || spill) {
       // we have already it cached
       return;
     }
@@ -236,7 +337,7 @@ namespace mariadb
     */
   bool ResultSetBin::readNextValue(bool cacheLocally)
   {
-    switch (row->fetchNext()) {
+    switch (cursorFetch ? protocol->fetchCursorRow(row) : row->fetchNext()) {
     case 1: {
       SQLString err("Internal error: most probably fetch on not yet executed statment handle. ");
       err.append(getErrMessage());
@@ -256,7 +357,7 @@ namespace mariadb
         callableResult= (serverStatus & SERVER_PS_OUT_PARAMS) != 0;
       }
 
-      if ((serverStatus & SERVER_MORE_RESULTS_EXIST) == 0) {
+      if ((serverStatus & SERVER_MORE_RESULTS_EXIST) == 0 && !cursorFetch) {
         protocol->removeActiveStreamingResult();
       }
       resetVariables();
@@ -774,7 +875,10 @@ namespace mariadb
   void ResultSetBin::realClose(bool noLock)
   {
     isClosedFlag= true;
-    if (!isEof) {
+    if (cursorFetch) {
+      closeCursor();
+    }
+    else if (!isEof) {
       try {
         while (!isEof) {
           dataSize= 0; // to avoid storing data
@@ -791,12 +895,78 @@ namespace mariadb
     resetVariables();
 
     data.clear();
+    spill.reset();
 
     if (statement != nullptr) {
       statement= nullptr;
     }
   }
 
+  /* Fixed-width types, which C/C copies from the row packet as is, if the bound buffer is of the same type */
+  static bool directFetchType(enum enum_field_types type)
+  {
+    switch (type) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+    case MYSQL_TYPE_FLOAT:
+    case MYSQL_TYPE_DOUBLE:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  /* Length of the value in the binary protocol row for fixed-width types, 0 for length-encoded ones */
+  static uint32_t binaryFixedLength(enum enum_field_types type)
+  {
+    switch (type) {
+    case MYSQL_TYPE_TINY:
+      return 1;
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_YEAR:
+      return 2;
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_FLOAT:
+      return 4;
+    case MYSQL_TYPE_LONGLONG:
+    case MYSQL_TYPE_DOUBLE:
+      return 8;
+    default:
+      return 0;
+    }
+  }
+
+  /* Checks the bound buffers against the plan and re-compiles it, if buffer types have changed. Since the application
+   * can re-bind columns between fetches, this has to be checked on every bind, but that is just the comparison of types
+   */
+  void ResultSetBin::compileBindPlan()
+  {
+    if (bindPlanValid) {
+      for (int32_t i= 0; i < columnInformationLength; ++i) {
+        if (bindPlanTypes[i] != resultBind[i].buffer_type) {
+          bindPlanValid= false;
+          break;
+        }
+      }
+      if (bindPlanValid) {
+        return;
+      }
+    }
+    bindPlan.assign(columnInformationLength, BIND_CONVERT);
+    bindPlanTypes.resize(columnInformationLength);
+
+    for (int32_t i= 0; i < columnInformationLength; ++i) {
+      bindPlanTypes[i]= resultBind[i].buffer_type;
+      if (resultBind[i].buffer_type == columnsInformation[i].getColumnType() && directFetchType(resultBind[i].buffer_type)) {
+        bindPlan[i]= BIND_DIRECT;
+      }
+    }
+    bindPlanValid= true;
+  }
+
   /*{{{ ResultSetBin::bind
    * Binding MYSQL_BIND structures to columns. Should be called *after* setting callbacks.
    * (this constraint can be removed if really needed)
@@ -804,11 +974,28 @@ namespace mariadb
   void ResultSetBin::bind(MYSQL_BIND* bind)
   {
     //mysql_stmt_bind_result(capiStmtHandle, bind);
-    resultBind.reset(new MYSQL_BIND[columnInformationLength]());
+    if (!resultBind) {
+      resultBind.reset(new MYSQL_BIND[columnInformationLength]());
+    }
     std::memcpy(resultBind.get(), bind, columnInformationLength*sizeof(MYSQL_BIND));
-    if (!resultCodec.empty()) {
-      for (const auto& it : resultCodec) {
-        resultBind[it.first].flags|= MADB_BIND_DUMMY;
+    if (resultCodecCount > 0) {
+      for (int32_t i= 0; i < columnInformationLength; ++i) {
+        if (resultCodec[i].codec != nullptr) {
+          resultBind[i].flags|= MADB_BIND_DUMMY;
+        }
+      }
+    }
+    else {
+      compileBindPlan();
+      for (int32_t i= 0; i < columnInformationLength; ++i) {
+        MYSQL_BIND& column= resultBind[i];
+        if (column.error == nullptr) {
+          column.error= &column.error_value;
+        }
+        // Only direct columns are converted by C/C on row fetch, the rest will be fetched in get() anyway
+        if (bindPlan[i] != BIND_DIRECT || column.buffer == nullptr) {
+          column.flags|= MADB_BIND_DUMMY;
+        }
       }
     }
     if (dataSize > 0) {
@@ -822,7 +1009,7 @@ namespace mariadb
   {
     checkObjectRange(colIdx0based + 1);
     // If cached result - write to buffers with own means, otherwise let c/c do it
-    if (data.size()) {
+    if (data.size() || spill) {
       return getCached(bind, colIdx0based, offset);
     }
     else {
@@ -835,19 +1022,25 @@ namespace mariadb
   {
     bool truncations= false;
     if (resultBind) {
+      // If the row is fetched from the server right now with current buffers bound, values of the direct
+      // columns are already in the application buffers
+      bool fetchedIntoBind= false;
       // Ugly - we don't want resetRow to call mysql_stmt_fetch. Maybe it just never should,
       // but it is like it is, and now is not the right time to change that.
       if (lastRowPointer != rowPointer || reBound/* && (rowPointer != lastRowPointer + 1 || streaming)*/) {
+        fetchedIntoBind= reBound && data.empty() && !spill;
         resetRow();
         reBound= false;
       }
-      if (resultCodec.empty()) {
+      if (resultCodecCount == 0) {
         for (int32_t i= 0; i < columnInformationLength; ++i) {
           MYSQL_BIND* bind= resultBind.get() + i;
           if (bind->error == nullptr) {
             bind->error= &bind->error_value;
           }
-          get(bind, i, 0);
+          if (!fetchedIntoBind || bindPlan[i] != BIND_DIRECT || bind->buffer == nullptr) {
+            get(bind, i, 0);
+          }
           if (*bind->error) {
             truncations= true;
           }
@@ -864,7 +1057,14 @@ namespace mariadb
 
   bool ResultSetBin::setResultCallback(ResultCodec* callback, uint32_t column)
   {
+    // The callback indexes it with the column number for any column, thus it has to be sized right away
+    if (resultCodec.empty()) {
+      resultCodec.resize(columnInformationLength);
+    }
     if (column == uint32_t(-1)) {
+      if (callback != nullptr && callback == nullResultCodec) {
+        return false;
+      }
       if (mysql_stmt_attr_set(capiStmtHandle, STMT_ATTR_CB_USER_DATA, callback ? (void*)this : nullptr)) {
         return true;
       }
@@ -874,9 +1074,21 @@ namespace mariadb
     if (column >= static_cast<uint32_t>(columnInformationLength)) {
       throw SQLException("No such column: " + std::to_string(column + 1), "22023");
     }
-
-    resultCodec[column]= callback;
-    if (resultCodec.size() == 1 && nullResultCodec == nullptr) {
+    CodecSlot& slot= resultCodec[column];
+    // Application normally does not change bindings between fetches, and then there is nothing to do
+    if (slot.codec == callback) {
+      return false;
+    }
+    if (slot.codec == nullptr) {
+      ++resultCodecCount;
+    }
+    else if (callback == nullptr) {
+      --resultCodecCount;
+    }
+    slot.codec= callback;
+    slot.fixedLength= binaryFixedLength(columnsInformation[column].getColumnType());
+    bindPlanValid= false;
+    if (resultCodecCount == 1 && callback != nullptr && nullResultCodec == nullptr) {
       mysql_stmt_attr_set(capiStmtHandle, STMT_ATTR_CB_USER_DATA, (void*)this);
       return mysql_stmt_attr_set(capiStmtHandle, STMT_ATTR_CB_RESULT, (const void*)defaultResultCallback);
     }
@@ -890,20 +1102,20 @@ namespace mariadb
     // the protocol broken
     try
     {
-      // Assuming so far, that Null value codec is always present. In this project it's the case.
       ResultSetBin *rs= reinterpret_cast<ResultSetBin*>(data);
+      // C/C calls back only for columns we have set codecs for, but for NULL values - for any column
+      const ResultSetBin::CodecSlot& slot= rs->resultCodec[column];
+
       if (row == nullptr) {
-        (*rs->nullResultCodec)(rs->callbackData, column, nullptr, NULL_LENGTH);
+        // Assuming so far, that Null value codec is always present. In this project it's the case.
+        (*(slot.codec != nullptr ? slot.codec : rs->nullResultCodec))(rs->callbackData, column, nullptr, NULL_LENGTH);
       }
-
-      const auto& it= rs->resultCodec.find(column);
-
-      if (it != rs->resultCodec.end()) {
-        auto length= mysql_net_field_length(row);
-        (*it->second)(rs->callbackData, column, *row, length);
+      else if (slot.codec != nullptr) {
+        // mysql_net_field_length moves the pointer past the length prefix
+        unsigned long length= slot.fixedLength > 0 ? slot.fixedLength : mysql_net_field_length(row);
+        (*slot.codec)(rs->callbackData, column, *row, length);
         *row+= length;
       }
-      //else if ()
     }
     catch (...)
     {
@@ -914,6 +1126,10 @@ namespace mariadb
 
   bool ResultSetBin::setCallbackData(void * data)
   {
+    // Callbacks work only on rows fetched from the server, and the spilled result is read from the local store
+    if (spill) {
+      return true;
+    }
     callbackData= data;
     // if C/C does not support callbacks 
     return mysql_stmt_attr_set(capiStmtHandle, STMT_ATTR_CB_USER_DATA, (void*)this);
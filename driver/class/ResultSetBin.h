@@ -49,17 +49,35 @@ class ResultSetBin : public ResultSet
   friend void defaultResultCallback(void* data, uint32_t column, unsigned char **row);
 
   bool callableResult= false;
+  // Result is read via server-side read-only cursor
+  bool cursorFetch= false;
   MYSQL_STMT* capiStmtHandle;
   std::unique_ptr<MYSQL_BIND[]> resultBind;
   std::vector<std::unique_ptr<int8_t[]>> cache;
 
-  std::map<std::size_t, ResultCodec*> resultCodec;
+  struct CodecSlot {
+    ResultCodec* codec= nullptr;
+    // Length of the value in the binary row packet for fixed-width types. 0 - the value is length-encoded
+    uint32_t fixedLength= 0;
+  };
+  // Column indexed, so the callback does not need any lookup. Sized on first callback set
+  std::vector<CodecSlot> resultCodec;
+  std::size_t resultCodecCount= 0;
   // For NULL value C/C may call back even for those columns which we haven't marked as dummy. Thus atm we either always need a codec for each column
   // or have one special codec. That makes sense since we don't won't to transcode all possible type combinations.
   ResultCodec* nullResultCodec= nullptr;
   void* callbackData= nullptr;
   bool reBound= false;
 
+  enum BindPlanStep {
+    BIND_CONVERT= 0, // Value is fetched into the bound buffer with mysql_stmt_fetch_column
+    BIND_DIRECT      // C/C writes fixed-width value from the row packet directly into the bound buffer on row fetch
+  };
+  // Per-column plan, compiled from the bound buffers, and buffer types it has been compiled for
+  std::vector<int8_t> bindPlan;
+  std::vector<enum enum_field_types> bindPlanTypes;
+  bool bindPlanValid= false;
+
 public:
 
   ResultSetBin(
@@ -70,10 +88,13 @@ public:
   ~ResultSetBin();
 
   bool isFullyLoaded() const;
+  bool isCursorFetch() const override { return cursorFetch; }
   void fetchRemaining();
 
 private:
   void flushPendingServerResults();
+  void closeCursor();
+  void spillResult(std::size_t memoryLimit);
   void cacheCompleteLocally() override;
 
   const char* getErrMessage();
@@ -92,6 +113,7 @@ protected:
 
 private:
   void growDataArray(bool complete= false);
+  void compileBindPlan();
 
 public:
   void abort();
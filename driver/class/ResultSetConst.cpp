@@ -0,0 +1,246 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation AB
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+
+
+#include <cstring>
+#include <cstdio>
+#include <limits>
+#include <algorithm>
+
+#include "ResultSetConst.h"
+#include "ColumnDefinition.h"
+#include "Exception.h"
+
+namespace mariadb
+{
+  static const std::vector<std::vector<bytes_view>> noRows;
+
+  template <typename T>
+  static void storeInt(MYSQL_BIND* bind, int64_t value)
+  {
+    if (value < static_cast<int64_t>(std::numeric_limits<T>::min()) ||
+        value > static_cast<int64_t>(std::numeric_limits<T>::max())) {
+      throw MYSQL_DATA_TRUNCATED;
+    }
+    T typed= static_cast<T>(value);
+    std::memcpy(bind->buffer, &typed, sizeof(T));
+    *bind->length= sizeof(T);
+  }
+
+
+  ResultSetConst::ResultSetConst(
+    std::vector<ColumnDefinition>& columnInformation,
+    const std::vector<bytes_view>* _rows,
+    std::size_t rowCount)
+    : ResultSetText(columnInformation, noRows, nullptr, TYPE_SCROLL_SENSITIVE)
+    , rows(_rows)
+  {
+    dataSize= rowCount;
+  }
+
+
+  void ResultSetConst::bind(MYSQL_BIND* bind)
+  {
+    resultBind= bind;
+  }
+
+  /* Same as the text result does with its values, the value length is written to the length buffer, and the error flag
+   * stays set if the value does not fit into the buffer */
+  bool ResultSetConst::putString(MYSQL_BIND* bind, const char* value, std::size_t length, uint64_t offset) const
+  {
+    std::size_t terminateWithNull= 1;
+
+    switch (bind->buffer_type) {
+    case MARIADB_BINARY_TYPES:
+      terminateWithNull= 0;
+    default:
+      break;
+    }
+    *bind->length= static_cast<unsigned long>(length);
+
+    if (bind->buffer != nullptr && bind->buffer_length > 0) {
+      if (offset > length) {
+        return true;
+      }
+      std::size_t bytesToCopy= std::min(static_cast<std::size_t>(bind->buffer_length) - terminateWithNull,
+        static_cast<std::size_t>(length - offset));
+      std::memcpy(bind->buffer, value + offset, bytesToCopy);
+      if (terminateWithNull > 0) {
+        *(static_cast<char*>(bind->buffer) + bytesToCopy)= '\0';
+      }
+      if (bytesToCopy < length - offset) {
+        return false;
+      }
+    }
+    *bind->error= '\0';
+    return false;
+  }
+
+
+  bool ResultSetConst::putNumber(MYSQL_BIND* bind, int64_t value, uint64_t offset) const
+  {
+    switch (bind->buffer_type) {
+    case MYSQL_TYPE_BIT:
+    case MYSQL_TYPE_TINY:
+      if (bind->is_unsigned) {
+        storeInt<uint8_t>(bind, value);
+      }
+      else {
+        storeInt<int8_t>(bind, value);
+      }
+      break;
+    case MYSQL_TYPE_YEAR:
+    case MYSQL_TYPE_SHORT:
+      if (bind->is_unsigned) {
+        storeInt<uint16_t>(bind, value);
+      }
+      else {
+        storeInt<int16_t>(bind, value);
+      }
+      break;
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+      if (bind->is_unsigned) {
+        storeInt<uint32_t>(bind, value);
+      }
+      else {
+        storeInt<int32_t>(bind, value);
+      }
+      break;
+    case MYSQL_TYPE_LONGLONG:
+      if (bind->is_unsigned && value < 0) {
+        throw MYSQL_DATA_TRUNCATED;
+      }
+      storeInt<int64_t>(bind, value);
+      break;
+    case MYSQL_TYPE_FLOAT:
+    {
+      float typed= static_cast<float>(value);
+      std::memcpy(bind->buffer, &typed, sizeof(typed));
+      *bind->length= sizeof(typed);
+      break;
+    }
+    case MYSQL_TYPE_DOUBLE:
+    {
+      double typed= static_cast<double>(value);
+      std::memcpy(bind->buffer, &typed, sizeof(typed));
+      *bind->length= sizeof(typed);
+      break;
+    }
+    case MYSQL_TYPE_NULL:
+      *bind->length= 0;
+      break;
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_NEWDATE:
+    case MYSQL_TYPE_TIME:
+    case MYSQL_TYPE_TIME2:
+    case MYSQL_TYPE_TIMESTAMP:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_DATETIME2:
+    case MYSQL_TYPE_TIMESTAMP2:
+      throw SQLException("Restricted data type attribute violation", "07006");
+    default:
+    {
+      // Text length includes terminating null, as in text values of the table
+      char text[24];
+      int length= std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(value));
+      return putString(bind, text, static_cast<std::size_t>(length) + 1, offset);
+    }
+    }
+    *bind->error= '\0';
+    return false;
+  }
+
+
+  bool ResultSetConst::get(MYSQL_BIND* bind, uint32_t column0basedIdx, uint64_t offset)
+  {
+    if (rowPointer < 0) {
+      throw SQLException("Current position is before the first row", "22023");
+    }
+    if (static_cast<std::size_t>(rowPointer) >= dataSize) {
+      throw SQLException("Current position is after the last row", "22023");
+    }
+    if (column0basedIdx >= static_cast<uint32_t>(columnInformationLength)) {
+      throw SQLException("No such column: " + std::to_string(column0basedIdx + 1), "22023");
+    }
+
+    if (bind->error == nullptr) {
+      bind->error= &bind->error_value;
+    }
+    if (bind->is_null == nullptr) {
+      bind->is_null= &bind->is_null_value;
+    }
+    if (bind->length == nullptr) {
+      bind->length= &bind->length_value;
+    }
+
+    const bytes_view& value= rows[rowPointer][column0basedIdx];
+    if (value.arr == nullptr) {
+      *bind->is_null= '\1';
+      return true;
+    }
+    *bind->is_null= '\0';
+    // Reset if nothing throws, and the value fits
+    *bind->error= '\1';
+
+    switch (columnsInformation[column0basedIdx].getColumnType()) {
+    case MYSQL_TYPE_SHORT:
+    {
+      int16_t typed;
+      std::memcpy(&typed, value.arr, sizeof(typed));
+      return putNumber(bind, typed, offset);
+    }
+    case MYSQL_TYPE_LONG:
+    {
+      int32_t typed;
+      std::memcpy(&typed, value.arr, sizeof(typed));
+      return putNumber(bind, typed, offset);
+    }
+    case MYSQL_TYPE_LONGLONG:
+    {
+      int64_t typed;
+      std::memcpy(&typed, value.arr, sizeof(typed));
+      return putNumber(bind, typed, offset);
+    }
+    default:
+      break;
+    }
+
+    switch (bind->buffer_type) {
+    case MYSQL_TYPE_NULL:
+      *bind->length= 0;
+      *bind->error= '\0';
+      return false;
+    case MYSQL_TYPE_STRING:
+    case MYSQL_TYPE_VAR_STRING:
+    case MYSQL_TYPE_VARCHAR:
+    case MARIADB_BINARY_TYPES:
+      return putString(bind, value.arr, value.size(), offset);
+    default:
+      throw SQLException("Restricted data type attribute violation", "07006");
+    }
+  }
+
+
+  bool ResultSetConst::get()
+  {
+    return fillBuffers(resultBind);
+  }
+
+} // namespace mariadb
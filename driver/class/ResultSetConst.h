@@ -0,0 +1,57 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation AB
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+
+
+#ifndef _RESULTSETCONST_H_
+#define _RESULTSETCONST_H_
+
+#include <vector>
+
+#include "ResultSetText.h"
+
+namespace mariadb
+{
+/**
+  * Result set over the rows of a constant table, that lives longer than the result set, and is not copied by it.
+  * Values are stored in binary form of the column type - int16_t for MYSQL_TYPE_SHORT, int32_t for MYSQL_TYPE_LONG,
+  * int64_t for MYSQL_TYPE_LONGLONG, and bytes for everything else. They are written to the bound buffers directly,
+  * only conversion to string goes through the text form.
+  * Navigation is inherited from the text result set, that does not need anything besides the rows count.
+  */
+class ResultSetConst : public ResultSetText
+{
+  const std::vector<bytes_view>* rows;
+  MYSQL_BIND* resultBind= nullptr;
+
+  bool putString(MYSQL_BIND* bind, const char* value, std::size_t length, uint64_t offset) const;
+  bool putNumber(MYSQL_BIND* bind, int64_t value, uint64_t offset) const;
+
+public:
+  ResultSetConst(
+    std::vector<ColumnDefinition>& columnInformation,
+    const std::vector<bytes_view>* rows,
+    std::size_t rowCount);
+
+  void bind(MYSQL_BIND* bind);
+  bool get(MYSQL_BIND* bind, uint32_t column0basedIdx, uint64_t offset);
+  bool get();
+};
+
+} // namespace mariadb
+#endif
@@ -22,6 +22,7 @@
 #include <array>
 #include <sstream>
 #include <algorithm>
+#include <cstring>
 
 #include "ResultSetText.h"
 #include "Results.h"
@@ -45,13 +46,21 @@ namespace mariadb
   {
     MYSQL_RES* textNativeResults= nullptr;
     if (fetchSize == 0) {
-      data.reserve(10);
-      textNativeResults= mysql_store_result(capiConnHandle);
+      const std::size_t memoryLimit= statement != nullptr ? statement->getResultMemoryLimit() : 0;
+      // Rows are read directly from the stored result, the local cache is only needed if the cursor gets modified.
+      // With the memory limit, rows are read into the local store instead, that spills to disk what does not fit
+      textNativeResults= memoryLimit > 0 ? mysql_use_result(capiConnHandle) : mysql_store_result(capiConnHandle);
 
       if (textNativeResults == nullptr && mysql_errno(capiConnHandle) != 0) {
         throw 1;
       }
-      dataSize= static_cast<size_t>(textNativeResults != nullptr ? mysql_num_rows(textNativeResults) : 0);
+      if (memoryLimit > 0 && textNativeResults != nullptr) {
+        spillResult(textNativeResults, memoryLimit);
+        dataSize= spill->size();
+      }
+      else {
+        dataSize= static_cast<size_t>(textNativeResults != nullptr ? mysql_num_rows(textNativeResults) : 0);
+      }
       streaming= false;
       resetVariables();
     }
@@ -71,7 +80,7 @@ namespace mariadb
     for (size_t i= 0; i < fieldCnt; ++i) {
       columnsInformation.emplace_back(mysql_fetch_field(textNativeResults));
     }
-    row= new TextRow(textNativeResults);
+    row= new TextRow(textNativeResults, !streaming && !spill);
 
     columnInformationLength= static_cast<int32_t>(columnsInformation.size());
 
@@ -128,6 +137,15 @@ namespace mariadb
     return isEof;
   }
 
+  /* Only the result stored by the Connector/C knows its size. Local cache and spill store are not accounted */
+  std::size_t ResultSetText::storedSize() const
+  {
+    if (capiConnHandle == nullptr || streaming || spill || row == nullptr) {
+      return 0;
+    }
+    return static_cast<TextRow*>(row)->storedSize();
+  }
+
   // Reading everything w/out caching
   void ResultSetText::flushPendingServerResults()
   {
@@ -284,6 +302,7 @@ namespace mariadb
     */
   void ResultSetText::updateRowData(std::vector<mariadb::bytes_view>& rawData)
   {
+    materializeRows();
     data[rowPointer]= rawData;
     row->resetRow(data[rowPointer]);
   }
@@ -294,7 +313,7 @@ namespace mariadb
     * @throws SQLException if previous() fail.
     */
   void ResultSetText::deleteCurrentRowData() {
-
+    materializeRows();
     data.erase(data.begin()+lastRowPointer);
     dataSize--;
     lastRowPointer= -1;
@@ -302,6 +321,7 @@ namespace mariadb
   }
 
   void ResultSetText::addRowData(std::vector<mariadb::bytes_view>& rawData) {
+    materializeRows();
     if (dataSize + 1 >= data.size()) {
       growDataArray();
     }
@@ -310,6 +330,54 @@ namespace mariadb
     ++dataSize;
   }
 
+  /* Reads the whole result into the local store, that keeps at most memoryLimit bytes in memory */
+  void ResultSetText::spillResult(MYSQL_RES* textNativeResults, std::size_t memoryLimit)
+  {
+    const unsigned int fieldCount= mysql_num_fields(textNativeResults);
+    MYSQL_ROW rowData;
+
+    spill.reset(new SpillStore(fieldCount, memoryLimit));
+    while ((rowData= mysql_fetch_row(textNativeResults)) != nullptr) {
+      const unsigned long* length= mysql_fetch_lengths(textNativeResults);
+      spill->startRow();
+      for (unsigned int i= 0; i < fieldCount; ++i) {
+        if (rowData[i] == nullptr) {
+          spill->addNull();
+        }
+        else {
+          std::memcpy(spill->addValue(length[i]), rowData[i], length[i]);
+        }
+      }
+    }
+    if (mysql_errno(capiConnHandle) != 0) {
+      throw 1;
+    }
+    spill->finish();
+  }
+
+  /**
+    * Copies views of the stored result rows into the local cache. Stored results are read directly from the C/C
+    * structures, and that is only needed when the cursor is going to be modified.
+    */
+  void ResultSetText::materializeRows()
+  {
+    if (spill) {
+      throw SQLException("Modification of the result, that is spilled to disk, is not supported", "HYC00");
+    }
+    if (streaming || data.size() >= dataSize) {
+      return;
+    }
+    std::size_t cached= data.size();
+    data.resize(dataSize);
+    row->installCursorAtPosition(static_cast<int32_t>(cached));
+    for (std::size_t i= cached; i < dataSize; ++i) {
+      row->fetchNext();
+      row->cacheCurrentRow(data[i], columnsInformation.size());
+    }
+    // Making resetRow to take the row from the cache
+    lastRowPointer= -1;
+  }
+
   /** Grow data array. */
   void ResultSetText::growDataArray() {
     std::size_t curSize= data.size();
@@ -774,6 +842,7 @@ namespace mariadb
     resetVariables();
 
     data.clear();
+    spill.reset();
 
     if (statement != nullptr) {
       statement= nullptr;
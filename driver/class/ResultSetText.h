@@ -63,6 +63,7 @@ public:
   ~ResultSetText();
 
   bool isFullyLoaded() const;
+  std::size_t storedSize() const override;
 
 private:
   void flushPendingServerResults();
@@ -86,6 +87,8 @@ protected:
 
 private:
   void growDataArray();
+  void materializeRows();
+  void spillResult(MYSQL_RES* textNativeResults, std::size_t memoryLimit);
 
 public:
   void abort();
@@ -17,6 +17,9 @@
    51 Franklin St., Fifth Floor, Boston, MA 02110, USA
 *************************************************************************************/
 
+#include <chrono>
+#include <system_error>
+
 #include "Results.h"
 #include "ServerPrepareResult.h"
 #include "ClientSidePreparedStatement.h"
@@ -128,6 +131,7 @@ namespace mariadb
 
 
   Results::~Results() {
+    cancelPrefetch();
     if (resultSet != nullptr) {
       resultSet->close();
       // Mutually forgetting each other. While we should probably just close the RS
@@ -386,6 +390,12 @@ namespace mariadb
     }
 
     bool haveCachedResult= cmdInformation && cmdInformation->moreResults() && !batch;
+    // Error, if there was one, is the last result read in the background
+    if (haveCachedResult && prefetchError && cmdInformation->hasMoreResults() == 0) {
+      std::exception_ptr error;
+      std::swap(error, prefetchError);
+      std::rethrow_exception(error);
+    }
     if (!haveCachedResult && guard->hasMoreResults(this)) {
       guard->moveToNextResult(this, serverPrepResult);
       haveCachedResult= true;
@@ -403,7 +413,11 @@ namespace mariadb
         currentRs.reset(executionResults.begin()->release());
         executionResults.pop_front();
       }
-      return (currentRs.get() != nullptr);
+      if (currentRs) {
+        startPrefetch(guard);
+        return true;
+      }
+      return false;
     } else {
 
       currentRs.reset(nullptr);
@@ -464,6 +478,7 @@ namespace mariadb
   }
 
   void Results::close(){
+    cancelPrefetch();
     if (resultSet != nullptr) {
       resultSet->close();
       // We don't need to remember it any more
@@ -526,4 +541,112 @@ namespace mariadb
     return false;
   }
 
+  /**
+   * Starts reading of next results in the background, while the app reads the current one. Only stored text results
+   * are read ahead, since only they do not need the connection, once they are read. Next results are read till they
+   * take the prefetch threshold of the statement, and the prefetch is restarted each time the app moves to the next
+   * result. The threshold is checked before reading each result - the size of a result is not known till it is read,
+   * thus the last one read may go beyond the threshold by any amount.
+   *
+   * <p><i>Lock must be set before using this method</i>
+   *
+   * @param guard current protocol
+   */
+  void Results::startPrefetch(Protocol* guard)
+  {
+    const std::size_t threshold= statement != nullptr ? statement->getPrefetchThreshold() : 0;
+
+    if (threshold == 0 || batch || serverPrepResult != nullptr || fetchSize != 0 || prefetching || prefetchError ||
+      !guard->hasMoreResults(this)) {
+      return;
+    }
+    std::lock_guard<std::mutex> localScopeLock(prefetchLock);
+    // Cancelled prefetch is not restarted
+    if (stopPrefetch) {
+      return;
+    }
+    // The thread is done or about to return, since it has reset the flag
+    if (prefetcher.joinable()) {
+      prefetcher.join();
+    }
+    prefetching= true;
+    try {
+      prefetcher= std::thread(&Results::prefetch, this, guard, threshold);
+    }
+    catch (std::system_error&) {
+      // Then results are read when the app asks for them
+      prefetching= false;
+    }
+  }
+
+  /**
+   * Stops reading of next results in the background, and waits till the thread is done, unless told not to. Results
+   * read so far stay, and the prefetch is not started again. Can be called with the lock set - the thread does not
+   * block on the lock, and checks if it has to stop. But it can be blocked on the server, while holding the lock, till
+   * the next result arrives. Thus the caller, that can't wait that long, has to only raise the flag, kill the query,
+   * and then wait. Can be called from other thread, than the one using the results.
+   */
+  void Results::cancelPrefetch(bool wait)
+  {
+    std::lock_guard<std::mutex> localScopeLock(prefetchLock);
+    stopPrefetch= true;
+    if (wait && prefetcher.joinable()) {
+      prefetcher.join();
+    }
+  }
+
+
+  void Results::prefetch(Protocol* guard, std::size_t threshold)
+  {
+    std::size_t buffered= 0;
+    bool first= true;
+
+    while (!stopPrefetch) {
+      std::unique_lock<std::mutex> localScopeLock(guard->getLock(), std::try_to_lock);
+      if (!localScopeLock.owns_lock()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        continue;
+      }
+      if (first) {
+        buffered= bufferedSize();
+        first= false;
+      }
+      // The flag is reset under the lock, so the app moving to the next result sees if the prefetch has to be restarted
+      if (stopPrefetch || buffered >= threshold || !guard->hasMoreResults(this)) {
+        prefetching= false;
+        return;
+      }
+      const std::size_t resultsCount= executionResults.size();
+      const int32_t statsCount= getCurrentStatNumber();
+      try {
+        guard->moveToNextResult(this, nullptr);
+      }
+      catch (...) {
+        // Server errors have their stat already. Any other error has to take its place in the results too
+        if (getCurrentStatNumber() == statsCount) {
+          addStatsError(false);
+        }
+        prefetchError= std::current_exception();
+        prefetching= false;
+        return;
+      }
+      if (executionResults.size() > resultsCount && executionResults.back()) {
+        buffered+= executionResults.back()->storedSize();
+      }
+    }
+    prefetching= false;
+  }
+
+
+  std::size_t Results::bufferedSize() const
+  {
+    std::size_t size= 0;
+    for (const auto& rs : executionResults) {
+      if (rs) {
+        size+= rs->storedSize();
+      }
+    }
+    return size;
+  }
+
 } // namespace mariadb
@@ -21,6 +21,10 @@
 #define _RESULTS_H_
 
 #include <deque>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
 
 #include "SQLString.h"
 #include "CmdInformation.h"
@@ -47,6 +51,18 @@ class Results  {
   SQLString sql;
   MYSQL_BIND* parameters;
   bool cachingLocally= false;
+  // Background reading of next results into executionResults, while the app consumes the current one
+  std::thread prefetcher;
+  std::atomic<bool> prefetching{false};
+  // Once raised, stays - the prefetch is not started again for these results
+  std::atomic<bool> stopPrefetch{false};
+  // Guards the prefetcher thread object. SQLCancel stops the prefetch from another thread, without the protocol lock
+  std::mutex prefetchLock;
+  // Error of the result read in the background. Thrown, when the app gets to that result
+  std::exception_ptr prefetchError;
+
+  void prefetch(Protocol* guard, std::size_t threshold);
+  std::size_t bufferedSize() const;
 
 public:
   enum {
@@ -117,6 +133,8 @@ public:
   void setRewritten(bool rewritten);
   void checkOut(ResultSet* iamleaving);
   bool nextIsLast(Protocol* protocol);
+  void startPrefetch(Protocol* guard);
+  void cancelPrefetch(bool wait= true);
 };
 
 } // namespace mariadb
@@ -181,6 +181,8 @@ namespace mariadb
     if (param != nullptr) {
       mysql_stmt_bind_param(serverPrepareResult->getStatementId(), param);
     }
+    // Array execution goes around the protocol, that otherwise takes care of it
+    guard->invalidateResultCache();
     int32_t rc= mysql_stmt_execute(serverPrepareResult->getStatementId());
     if ( rc == 0)
     {
@@ -234,7 +236,14 @@ namespace mariadb
         sql,
         param));
 
-      
+    // Attributes are set on each execution, since the handle can be shared via the cache of prepared statements
+    unsigned long cursorType= cursorFetchRows > 0 && batchArraySize <= 1 ? CURSOR_TYPE_READ_ONLY : CURSOR_TYPE_NO_CURSOR;
+    mysql_stmt_attr_set(serverPrepareResult->getStatementId(), STMT_ATTR_CURSOR_TYPE, &cursorType);
+    if (cursorType != CURSOR_TYPE_NO_CURSOR) {
+      unsigned long prefetchRows= cursorFetchRows;
+      mysql_stmt_attr_set(serverPrepareResult->getStatementId(), STMT_ATTR_PREFETCH_ROWS, &prefetchRows);
+    }
+
     guard->executePreparedQuery(serverPrepareResult, results.get());
 
     //try
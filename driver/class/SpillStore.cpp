@@ -0,0 +1,280 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation AB
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+
+
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <unistd.h>
+# include <errno.h>
+# include <sys/mman.h>
+#endif
+
+#include "SpillStore.h"
+#include "Exception.h"
+
+namespace mariadb
+{
+  const uint64_t SpillStore::NULL_VALUE;
+  const uint64_t SpillStore::MAP_GRANULARITY;
+  const std::size_t SpillStore::MAP_WINDOW;
+  const std::size_t SpillStore::WRITE_BUFFER_SIZE;
+
+  /* Values are stored as 8 bytes length followed by the value padded to 8 bytes, so binary protocol values are aligned */
+  static inline std::size_t padded(std::size_t length)
+  {
+    return (length + 7) & ~static_cast<std::size_t>(7);
+  }
+
+
+  SpillStore::SpillStore(std::size_t _columnCount, std::size_t _memoryBudget)
+    : columnCount(_columnCount)
+    , memoryBudget(_memoryBudget)
+  {
+  }
+
+
+  SpillStore::~SpillStore()
+  {
+    unmapWindow();
+#ifdef _WIN32
+    if (mapping != nullptr) {
+      CloseHandle(mapping);
+    }
+    // The file is created with FILE_FLAG_DELETE_ON_CLOSE
+    if (file != nullptr) {
+      CloseHandle(file);
+    }
+#else
+    // The file has been unlinked right after creation
+    if (file >= 0) {
+      close(file);
+    }
+#endif
+  }
+
+
+  void SpillStore::startRow()
+  {
+    rowOffset.push_back(storedSize());
+  }
+
+
+  char* SpillStore::addValue(std::size_t length)
+  {
+    uint64_t header= length;
+    char* buffer= reserve(sizeof(header) + padded(length));
+    std::memcpy(buffer, &header, sizeof(header));
+    return buffer + sizeof(header);
+  }
+
+
+  void SpillStore::addNull()
+  {
+    std::memcpy(reserve(sizeof(NULL_VALUE)), &NULL_VALUE, sizeof(NULL_VALUE));
+  }
+
+
+  char* SpillStore::reserve(std::size_t length)
+  {
+    if (!spilling) {
+      if (memSize + length <= memoryBudget) {
+        if (memSize + length > memCapacity) {
+          std::size_t newCapacity= std::min(memoryBudget, std::max(memCapacity * 2, static_cast<std::size_t>(memSize + length)));
+          char* grown= new char[newCapacity];
+          if (memSize > 0) {
+            std::memcpy(grown, memRows.get(), static_cast<std::size_t>(memSize));
+          }
+          memRows.reset(grown);
+          memCapacity= newCapacity;
+        }
+        char* result= memRows.get() + memSize;
+        memSize+= length;
+        return result;
+      }
+      startSpilling();
+    }
+    if (writeBufferUsed + length > writeBuffer.size()) {
+      flushWriteBuffer();
+      if (length > writeBuffer.size()) {
+        writeBuffer.resize(length);
+      }
+    }
+    char* result= writeBuffer.data() + writeBufferUsed;
+    writeBufferUsed+= length;
+    return result;
+  }
+
+  /* The row has to be in one piece, thus already stored values of the current row move from memory to the file */
+  void SpillStore::startSpilling()
+  {
+    openFile();
+    spilling= true;
+
+    const uint64_t rowStart= rowOffset.empty() ? memSize : rowOffset.back();
+    const std::size_t partialRow= static_cast<std::size_t>(memSize - rowStart);
+
+    writeBuffer.resize(std::max(WRITE_BUFFER_SIZE, partialRow));
+    if (partialRow > 0) {
+      std::memcpy(writeBuffer.data(), memRows.get() + rowStart, partialRow);
+    }
+    writeBufferUsed= partialRow;
+    memSize= rowStart;
+  }
+
+
+  void SpillStore::openFile()
+  {
+#ifdef _WIN32
+    char dir[MAX_PATH + 1], path[MAX_PATH + 1];
+    if (GetTempPathA(sizeof(dir), dir) == 0 || GetTempFileNameA(dir, "mdb", 0, path) == 0) {
+      throw SQLException("Could not create temporary file for the result", "HY000");
+    }
+    file= CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                      FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+      file= nullptr;
+      DeleteFileA(path);
+      throw SQLException("Could not create temporary file for the result", "HY000");
+    }
+#else
+    const char* dir= std::getenv("TMPDIR");
+    std::string path(dir != nullptr && *dir != '\0' ? dir : "/tmp");
+    path.append("/maodbc_rsXXXXXX");
+
+    file= mkstemp(&path[0]);
+    if (file < 0) {
+      throw SQLException("Could not create temporary file for the result", "HY000");
+    }
+    // Nobody else needs it, and this way it's gone as soon as it's closed, or if the process dies
+    unlink(path.c_str());
+#endif
+  }
+
+
+  void SpillStore::flushWriteBuffer()
+  {
+    const char* pos= writeBuffer.data();
+    std::size_t remaining= writeBufferUsed;
+
+    while (remaining > 0) {
+#ifdef _WIN32
+      DWORD written= 0;
+      if (!WriteFile(file, pos, static_cast<DWORD>(std::min<std::size_t>(remaining, 1 << 30)), &written, NULL)) {
+        throw SQLException("Could not write the result to the temporary file", "HY000");
+      }
+#else
+      ssize_t written= write(file, pos, remaining);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw SQLException("Could not write the result to the temporary file", "HY000", errno);
+      }
+#endif
+      pos+= written;
+      remaining-= static_cast<std::size_t>(written);
+    }
+    fileSize+= writeBufferUsed;
+    writeBufferUsed= 0;
+  }
+
+
+  void SpillStore::finish()
+  {
+    if (!spilling) {
+      return;
+    }
+    flushWriteBuffer();
+    std::vector<char>().swap(writeBuffer);
+#ifdef _WIN32
+    if (fileSize > 0) {
+      mapping= CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (mapping == NULL) {
+        mapping= nullptr;
+        throw SQLException("Could not map the temporary file of the result", "HY001");
+      }
+    }
+#endif
+  }
+
+
+  void SpillStore::unmapWindow()
+  {
+    if (window != nullptr) {
+#ifdef _WIN32
+      UnmapViewOfFile(window);
+#else
+      munmap(const_cast<char*>(window), windowLength);
+#endif
+      window= nullptr;
+    }
+  }
+
+  /* Returns pointer to the range of the file, remapping the window if the range is not in it */
+  const char* SpillStore::mapRange(uint64_t offset, std::size_t length)
+  {
+    if (window == nullptr || offset < windowOffset || offset + length > windowOffset + windowLength) {
+      unmapWindow();
+      windowOffset= offset - offset % MAP_GRANULARITY;
+      windowLength= static_cast<std::size_t>(std::min<uint64_t>(fileSize - windowOffset,
+        std::max<uint64_t>(MAP_WINDOW, offset + length - windowOffset)));
+#ifdef _WIN32
+      window= static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(windowOffset >> 32),
+        static_cast<DWORD>(windowOffset & 0xFFFFFFFF), windowLength));
+#else
+      void* mapped= mmap(nullptr, windowLength, PROT_READ, MAP_SHARED, file, static_cast<off_t>(windowOffset));
+      window= mapped == MAP_FAILED ? nullptr : static_cast<const char*>(mapped);
+#endif
+      if (window == nullptr) {
+        throw SQLException("Could not map the temporary file of the result", "HY001");
+      }
+    }
+    return window + (offset - windowOffset);
+  }
+
+
+  void SpillStore::get(std::size_t rowNr, std::vector<bytes_view>& row)
+  {
+    const uint64_t offset= rowOffset[rowNr];
+    const uint64_t end= rowNr + 1 < rowOffset.size() ? rowOffset[rowNr + 1] : memSize + fileSize;
+    const char* pos= offset < memSize ? memRows.get() + offset :
+      mapRange(offset - memSize, static_cast<std::size_t>(end - offset));
+
+    row.resize(columnCount);
+    for (auto& value : row) {
+      uint64_t length;
+      std::memcpy(&length, pos, sizeof(length));
+      pos+= sizeof(length);
+      if (length == NULL_VALUE) {
+        value.wrap(nullptr, 0);
+      }
+      else {
+        value.wrap(pos, static_cast<std::size_t>(length));
+        pos+= padded(static_cast<std::size_t>(length));
+      }
+    }
+  }
+
+} // namespace mariadb
@@ -0,0 +1,97 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation AB
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+
+
+#ifndef _SPILLSTORE_H_
+#define _SPILLSTORE_H_
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "CArray.h"
+
+namespace mariadb
+{
+/**
+  * Local copy of the result rows with the limited memory footprint. Rows are kept in memory till their total size reaches
+  * the budget, all following rows are written to the temporary file, and are read back via memory mapped window of it.
+  * Random access to rows is provided by the index of row offsets.
+  * Rows are added first, and read only after finish() has been called.
+  */
+class SpillStore
+{
+  static const uint64_t NULL_VALUE= ~static_cast<uint64_t>(0);
+  // Mapping offsets have to be multiple of the page size, or of the allocation granularity on Windows
+  static const uint64_t MAP_GRANULARITY= 64*1024;
+  static const std::size_t MAP_WINDOW= 64*1024*1024;
+  static const std::size_t WRITE_BUFFER_SIZE= 1024*1024;
+
+  const std::size_t columnCount;
+  const std::size_t memoryBudget;
+  // Offset of each row in the store. Offsets below memSize are in memory, the rest are in the file
+  std::vector<uint64_t> rowOffset;
+  std::unique_ptr<char[]> memRows;
+  std::size_t memCapacity= 0;
+  uint64_t memSize= 0;
+  bool spilling= false;
+
+  std::vector<char> writeBuffer;
+  std::size_t writeBufferUsed= 0;
+  uint64_t fileSize= 0;
+
+  const char* window= nullptr;
+  uint64_t windowOffset= 0;
+  std::size_t windowLength= 0;
+
+#ifdef _WIN32
+  void* file= nullptr;
+  void* mapping= nullptr;
+#else
+  int file= -1;
+#endif
+
+  uint64_t storedSize() const { return memSize + fileSize + writeBufferUsed; }
+  char* reserve(std::size_t length);
+  void startSpilling();
+  void openFile();
+  void flushWriteBuffer();
+  void unmapWindow();
+  const char* mapRange(uint64_t offset, std::size_t length);
+
+public:
+  SpillStore(std::size_t columnCount, std::size_t memoryBudget);
+  ~SpillStore();
+  SpillStore(const SpillStore&)= delete;
+  SpillStore& operator=(const SpillStore&)= delete;
+
+  void startRow();
+  // Returns buffer for the value of the given length in the current row, that has to be filled by the caller right away
+  char* addValue(std::size_t length);
+  void addNull();
+  void finish();
+
+  std::size_t size() const { return rowOffset.size(); }
+  bool isSpilled() const { return spilling; }
+  // Views are valid till the next call
+  void get(std::size_t rowNr, std::vector<bytes_view>& row);
+};
+
+} // namespace mariadb
+#endif
@@ -34,11 +34,12 @@ namespace mariadb
  * @param maxFieldSize max field size
  * @param options connection options
  */
-  TextRow::TextRow(MYSQL_RES* capiTextResults)
+  TextRow::TextRow(MYSQL_RES* capiTextResults, bool storedResult)
     : Row()
     , capiResults(capiTextResults, &mysql_free_result)
     , rowData(nullptr)
     , lengthArr(nullptr)
+    , stored(storedResult && capiTextResults != nullptr)
  {
  }
 
@@ -407,7 +408,7 @@ namespace mariadb
      case MYSQL_TYPE_FLOAT:
      case MYSQL_TYPE_DOUBLE:
      {
-       long double doubleValue= std::stold(fieldBuf.arr);
+       long double doubleValue= stringToDouble(fieldBuf.arr + pos, length);
        if (doubleValue > static_cast<long double>(INT64_MAX)) {
          throw SQLException(
            "Out of range value for column '"
@@ -472,7 +473,7 @@ namespace mariadb
      case MYSQL_TYPE_FLOAT:
      case MYSQL_TYPE_DOUBLE:
      {
-       long double doubleValue= std::stold(fieldBuf.arr);
+       long double doubleValue= stringToDouble(fieldBuf.arr + pos, length);
        if (doubleValue < 0 || doubleValue > static_cast<long double>(UINT64_MAX)) {
          throw SQLException(
            "Out of range value for column '"
@@ -493,7 +494,7 @@ namespace mariadb
      case MYSQL_TYPE_LONG:
      case MYSQL_TYPE_INT24:
      case MYSQL_TYPE_LONGLONG:
-       value= mariadb::stoull(fieldBuf.arr);
+       value= mariadb::stoull(fieldBuf.arr + pos, length);
        break;
      case MYSQL_TYPE_TIMESTAMP:
      case MYSQL_TYPE_DATETIME:
@@ -722,8 +723,42 @@ namespace mariadb
  }
 
 
+ /* Walks the list of stored rows once and remembers their positions. mysql_data_seek walks the list from the start on
+    each call, i.e. scrolling the cursor would be O(n) on every move otherwise */
+ void TextRow::indexRows()
+ {
+   rowOffsets.reserve(static_cast<std::size_t>(mysql_num_rows(capiResults.get())));
+   mysql_data_seek(capiResults.get(), 0);
+   for (MYSQL_ROW_OFFSET it= mysql_row_tell(capiResults.get()); it != nullptr; it= it->next) {
+     rowOffsets.push_back(it);
+   }
+ }
+
+
+ std::size_t TextRow::storedSize() const
+ {
+   std::size_t size= 0;
+
+   if (stored && capiResults && capiResults->data != nullptr) {
+     for (MYSQL_ROW_OFFSET it= capiResults->data->data; it != nullptr; it= it->next) {
+       size+= sizeof(MYSQL_ROWS) + it->length;
+     }
+   }
+   return size;
+ }
+
+
  void TextRow::installCursorAtPosition(int32_t rowPtr)
  {
+   if (stored) {
+     if (rowOffsets.empty()) {
+       indexRows();
+     }
+     if (static_cast<std::size_t>(rowPtr) < rowOffsets.size()) {
+       mysql_row_seek(capiResults.get(), rowOffsets[rowPtr]);
+       return;
+     }
+   }
    mysql_data_seek(capiResults.get(), static_cast<unsigned long long>(rowPtr));
  }
 
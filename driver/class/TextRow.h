@@ -22,6 +22,7 @@
 #define _TEXTROW_H_
 
 #include <memory>
+#include <vector>
 
 #include "Row.h"
 #include "mysql.h"
@@ -34,15 +35,22 @@ class TextRow  : public Row
   std::unique_ptr<MYSQL_RES, decltype(&mysql_free_result)> capiResults;
   MYSQL_ROW  rowData;
   unsigned long* lengthArr;
+  /* Positions of rows in the stored result. Built on first random access, so forward reading does not need it */
+  std::vector<MYSQL_ROW_OFFSET> rowOffsets;
+  bool stored;
+
+  void indexRows();
 
 public:
-  TextRow(MYSQL_RES* capiTextResults);
+  TextRow(MYSQL_RES* capiTextResults, bool storedResult= false);
   ~TextRow() {}
 
   void setPosition(int32_t newIndex);
 
   int32_t fetchNext();
   void installCursorAtPosition(int32_t rowPtr);
+  // Size of the rows stored by the Connector/C. Does not move the cursor
+  std::size_t storedSize() const;
 
   Date getInternalDate(const ColumnDefinition*  columnInfo);
   Time getInternalTime(const ColumnDefinition* columnInfo, MYSQL_TIME *dest= nullptr);
@@ -0,0 +1,113 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation AB
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+
+
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+#include "WorkerPool.h"
+
+namespace mariadb
+{
+  WorkerPool::~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> localScopeLock(lock);
+      stopping= true;
+    }
+    jobAdded.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+
+  void WorkerPool::workerLoop()
+  {
+    while (true) {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> localScopeLock(lock);
+        jobAdded.wait(localScopeLock, [this]() { return stopping || !jobs.empty(); });
+        if (jobs.empty()) {
+          return;
+        }
+        job= std::move(jobs.front());
+        jobs.pop_front();
+      }
+      job();
+    }
+  }
+
+
+  void WorkerPool::run(std::size_t taskCount, std::size_t parallelism, const std::function<void(std::size_t)>& task)
+  {
+    /* Tasks are not bound to threads - every participant takes next not started task, till they are over. Thus helper
+       job that has been picked up too late, simply finds nothing to do. The state is shared, since such job may outlive
+       this call */
+    struct Batch
+    {
+      std::atomic<std::size_t> next;
+      std::size_t remaining;
+      std::mutex lock;
+      std::condition_variable done;
+    };
+    std::shared_ptr<Batch> batch(new Batch());
+    const std::function<void(std::size_t)>* taskPtr= &task;
+
+    batch->next= 0;
+    batch->remaining= taskCount;
+
+    auto participate= [batch, taskPtr, taskCount]() {
+      std::size_t taskNr, finished= 0;
+      while ((taskNr= batch->next++) < taskCount) {
+        (*taskPtr)(taskNr);
+        ++finished;
+      }
+      if (finished > 0) {
+        std::lock_guard<std::mutex> localScopeLock(batch->lock);
+        batch->remaining-= finished;
+        if (batch->remaining == 0) {
+          batch->done.notify_all();
+        }
+      }
+    };
+
+    std::size_t helpers= std::min(std::min(taskCount, parallelism), MAX_WORKERS + 1);
+    helpers= helpers > 0 ? helpers - 1 : 0;
+
+    if (helpers > 0) {
+      std::lock_guard<std::mutex> localScopeLock(lock);
+      for (std::size_t i= 0; i < helpers; ++i) {
+        jobs.push_back(participate);
+      }
+      while (workers.size() < helpers) {
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+      }
+    }
+    jobAdded.notify_all();
+
+    participate();
+
+    std::unique_lock<std::mutex> localScopeLock(batch->lock);
+    batch->done.wait(localScopeLock, [&batch]() { return batch->remaining == 0; });
+  }
+
+} // namespace mariadb
@@ -0,0 +1,63 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation AB
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+
+
+#ifndef _WORKERPOOL_H_
+#define _WORKERPOOL_H_
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace mariadb
+{
+/**
+  * Small pool of threads, that is used to split CPU bound work of a single handle(like conversion of the fetched rowset
+  * into application buffers) between cores. Threads are started on demand, and live till the pool is destroyed.
+  */
+class WorkerPool
+{
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> jobs;
+  std::mutex lock;
+  std::condition_variable jobAdded;
+  bool stopping= false;
+
+  void workerLoop();
+
+public:
+  static const std::size_t MAX_WORKERS= 64;
+
+  WorkerPool() {}
+  ~WorkerPool();
+  WorkerPool(const WorkerPool&)= delete;
+  WorkerPool& operator=(const WorkerPool&)= delete;
+
+  /**
+    * Runs task(0), ..., task(taskCount - 1) using up to parallelism threads including the calling one, and returns when
+    * all of them are done. The task must not throw.
+    */
+  void run(std::size_t taskCount, std::size_t parallelism, const std::function<void(std::size_t)>& task);
+};
+
+} // namespace mariadb
+#endif
@@ -38,6 +38,8 @@ namespace mariadb
   class PreparedStatement;
   class ParamCodec;
   class ResultCodec;
+  class WorkerPool;
+  class Row;
 
   namespace Shared
   {
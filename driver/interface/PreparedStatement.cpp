@@ -142,6 +142,23 @@ namespace mariadb
   }
 
 
+  void PreparedStatement::prefetchResults()
+  {
+    if (results) {
+      std::lock_guard<std::mutex> localScopeLock(guard->getLock());
+      results->startPrefetch(guard);
+    }
+  }
+
+
+  void PreparedStatement::cancelPrefetch(bool wait)
+  {
+    if (results) {
+      results->cancelPrefetch(wait);
+    }
+  }
+
+
   ResultSetMetaData* PreparedStatement::getEarlyMetaData()
   {
     return getPrepareResult()->getEarlyMetaData();
@@ -74,6 +74,13 @@ protected:
   bool hasLongData= false;
   bool useFractionalSeconds= true;
   int32_t fetchSize= 0;
+  // >0 - the result is read via server-side read-only cursor, with this number of rows prefetched by each COM_STMT_FETCH
+  uint32_t cursorFetchRows= 0;
+  // >0 - stored results keep at most this number of bytes in memory, and the rest goes to the temporary file
+  std::size_t resultMemoryLimit= 0;
+  // >0 - next stored results of the multi-result query are read in the background, till they take this number of bytes
+  // or more. It's checked before reading each result, i.e. the last one read may go beyond it by any amount
+  std::size_t prefetchThreshold= 0;
   int32_t resultSetScrollType= 0;
   bool closed= false;
   Longs batchRes;
@@ -150,6 +157,15 @@ public:
   Results* getInternalResults() { return results.get(); }
   inline void setFetchSize(int32_t _fetchSize) { fetchSize= _fetchSize; }
   inline int32_t getFetchSize() { return fetchSize; }
+  // Has effect only for server-side prepared statements
+  inline void setCursorFetch(uint32_t rows) { cursorFetchRows= rows; }
+  inline void setResultMemoryLimit(std::size_t limit) { resultMemoryLimit= limit; }
+  inline std::size_t getResultMemoryLimit() const { return resultMemoryLimit; }
+  inline void setPrefetchThreshold(std::size_t threshold) { prefetchThreshold= threshold; }
+  inline std::size_t getPrefetchThreshold() const { return prefetchThreshold; }
+  // Starts reading of next results in the background, if the limit is set, and the current result allows that
+  void prefetchResults();
+  void cancelPrefetch(bool wait= true);
   // Return false if callbacks are not supported
   virtual bool setParamCallback(ParamCodec* callback, uint32_t param= uint32_t(-1))= 0;
   virtual bool setCallbackData(void* data)= 0;
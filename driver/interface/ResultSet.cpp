@@ -22,6 +22,7 @@
 #include "ServerPrepareResult.h"
 #include "ResultSetBin.h"
 #include "ResultSetText.h"
+#include "ResultSetConst.h"
 #include "class/Results.h"
 #include "class/TextRow.h"
 #include "interface/Exception.h"
@@ -205,6 +206,14 @@ namespace mariadb
   }
 
 
+  ResultSet* ResultSet::createResultSet(const std::vector<ColumnDefinition>& columns,
+    const std::vector<mariadb::bytes_view>* rows, std::size_t rowCount)
+  {
+    std::vector<ColumnDefinition> columnsCopy(columns);
+    return new ResultSetConst(columnsCopy, rows, rowCount);
+  }
+
+
   ResultSet::~ResultSet()
   {
     delete row;
@@ -223,6 +232,7 @@ namespace mariadb
     resetVariables();
 
     data.clear();
+    spill.reset();
 
     if (statement != nullptr) {
       statement= nullptr;
@@ -518,6 +528,12 @@ namespace mariadb
     if (rowPointer > -1 && data.size() > static_cast<std::size_t>(rowPointer)) {
       row->resetRow(const_cast<std::vector<mariadb::bytes_view>&>(data[rowPointer]));
     }
+    else if (spill) {
+      if (rowPointer > -1 && static_cast<std::size_t>(rowPointer) < spill->size()) {
+        spill->get(rowPointer, spillRow);
+        row->resetRow(spillRow);
+      }
+    }
     else {
       if (rowPointer != lastRowPointer + 1) {
         row->installCursorAtPosition(rowPointer > -1 ? rowPointer : 0);
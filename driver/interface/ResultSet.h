@@ -29,6 +29,7 @@
 #include "CArray.h"
 #include "Row.h"
 #include "ColumnDefinition.h"
+#include "SpillStore.h"
 #include "pimpls.h"
 
 namespace mariadb
@@ -61,6 +62,9 @@ protected:
   mutable int32_t lastRowPointer=         -1;
   std::vector<std::vector<mariadb::bytes_view>> data;
   std::size_t dataSize=           0; //Should go after data
+  // Stored result, that is read into the local store with memory limit instead of C/C's store. The row being read is in spillRow
+  std::unique_ptr<SpillStore> spill;
+  mutable std::vector<mariadb::bytes_view> spillRow;
   bool        noBackslashEscapes= false;
   // we don't create buffers for all columns without call. Thus has to be mutable while getters are const
   mutable std::map<int32_t, std::unique_ptr<memBuf>> blobBuffer;
@@ -132,6 +136,18 @@ public:
   static ResultSet* createResultSet(const std::vector<SQLString>& columnNames, const std::vector<const MYSQL_FIELD*>& columnTypes,
     const std::vector<std::vector<bytes_view>>& data);
 
+  /**
+  * Create a result set over the rows of a constant table. Rows are not copied, and have to outlive the result set.
+  * Values are in binary form of the column types, see ResultSetConst
+  *
+  * @param columns - columns definitions
+  * @param rows - pointer to the first row
+  * @param rowCount - number of rows
+  * @return resultset
+  */
+  static ResultSet* createResultSet(const std::vector<ColumnDefinition>& columns, const std::vector<bytes_view>* rows,
+    std::size_t rowCount);
+
   virtual ~ResultSet();
 
   void close();
@@ -145,6 +161,10 @@ public:
   virtual void cacheCompleteLocally()=0;
   virtual ResultSetMetaData* getMetaData() const=0;
   virtual std::size_t rowsCount() const=0;
+  // Bytes the rows of the result take in the memory of the connector, if the result knows that. 0 otherwise
+  virtual std::size_t storedSize() const { return 0; }
+  // If rows are read via server-side cursor
+  virtual bool isCursorFetch() const { return false; }
 
   virtual bool isLast()=0;
   virtual bool isAfterLast()=0;
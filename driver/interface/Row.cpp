@@ -18,75 +18,182 @@
 *************************************************************************************/
 
 
+#include <cfloat>
+
 #include "Row.h"
 #include "ColumnDefinition.h"
 
 
 namespace mariadb
 {
+  /* Digits parsing 8 at a time(SWAR), that is applicable to any platform and does not require any special instruction set.
+     The bytes are expected to be loaded in the little-endian order */
+  inline uint64_t loadEightBytes(const char* str)
+  {
+    uint64_t val;
+    std::memcpy(&val, str, sizeof(val));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    val= __builtin_bswap64(val);
+#endif
+    return val;
+  }
+
+  inline bool isEightDigits(uint64_t val)
+  {
+    return (((val & 0xF0F0F0F0F0F0F0F0ULL) | (((val + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+      0x3333333333333333ULL);
+  }
+
+  inline uint32_t parseEightDigits(uint64_t val)
+  {
+    const uint64_t mask= 0x000000FF000000FFULL;
+    const uint64_t mul1= 0x000F424000000064ULL; // 100 + (1000000ULL << 32)
+    const uint64_t mul2= 0x0000271000000001ULL; // 1 + (10000ULL << 32)
+    val-= 0x3030303030303030ULL;
+    val= (val * 10) + (val >> 8);
+    val= (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(val);
+  }
+
+  /* Parses digits at str, while they are digits. Returns the pointer to the first not parsed character.
+     The value is accumulated in the unsigned, wrapping around on overflow */
+  inline const char* parseDigits(const char* str, const char* end, uint64_t& result)
+  {
+    while (end - str >= 8) {
+      uint64_t chunk= loadEightBytes(str);
+      if (!isEightDigits(chunk)) {
+        break;
+      }
+      result= result * 100000000ULL + parseEightDigits(chunk);
+      str+= 8;
+    }
+    while (str < end && *str >= '0' && *str <= '9') {
+      result= result * 10 + static_cast<uint64_t>(*str - '0');
+      ++str;
+    }
+    return str;
+  }
+
   //
   int64_t core_strtoll(const char* str, uint32_t len) {
+    uint64_t result= 0;
+    parseDigits(str, str + len, result);
+    return static_cast<int64_t>(result);
+  }
 
-    int64_t result=0, digit= 0;
-    const char* end= str + len;
 
-    while (str < end) {
-      switch (*str) {
-      case '0':
-        digit= 0;
-        break;
-      case '1':
-        digit= 1;
-        break;
-      case '2':
-        digit= 2;
-        break;
-      case '3':
-        digit= 3;
-        break;
-      case '4':
-        digit= 4;
-        break;
-      case '5':
-        digit= 5;
-        break;
-      case '6':
-        digit= 6;
-        break;
-      case '7':
-        digit= 7;
-        break;
-      case '8':
-        digit= 8;
-        break;
-      case '9':
-        digit= 9;
-        break;
-      default:
-        return result;
+  /* Fast path for the string, that consists of digits only. Returns false if the string is anything else, or if the value
+     does not fit uint64_t - the caller should use generic conversion then */
+  bool fastStoull(const char* str, std::size_t len, uint64_t& result)
+  {
+    // 19 digits always fit, 20 may not
+    if (len == 0 || len > 20) {
+      return false;
+    }
+    result= 0;
+    const char* end= str + len;
+    if (len == 20) {
+      if (parseDigits(str, end - 1, result) != end - 1 || end[-1] < '0' || end[-1] > '9' ||
+        result > (UINT64_MAX - static_cast<uint64_t>(end[-1] - '0')) / 10) {
+        return false;
       }
-      result= result * 10 + digit;
+      result= result * 10 + static_cast<uint64_t>(end[-1] - '0');
+      return true;
+    }
+    return parseDigits(str, end, result) == end;
+  }
+
+
+  /* Exactly representable powers of 10 for the fast path of the string to double conversion */
+  static const double exactPow10[]= {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  /* Clinger's fast path - if the decimal significand fits 53 bits and the decimal exponent is within the range of exactly
+     representable powers of 10, then the result of the single multiplication or division is correctly rounded. Covers
+     typical values from the database(like "1234.56"). Returns false if the string is out of its scope or is not plain
+     number, and caller should do generic conversion then */
+  bool fastStringToDouble(const char* str, std::size_t len, double& result)
+  {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+    // Extended precision of intermediate results(x87) would make the result double rounded
+    return false;
+#else
+    const char *end= str + len, *digitsStart;
+    bool negative= false;
+    uint64_t significand= 0;
+    int32_t exp10= 0, digits;
+
+    if (str < end && *str == '-') {
+      negative= true;
       ++str;
     }
-    return result;
+    digitsStart= str;
+    str= parseDigits(str, end, significand);
+    digits= static_cast<int32_t>(str - digitsStart);
+
+    if (str < end && *str == '.') {
+      const char* fracStart= ++str;
+      str= parseDigits(str, end, significand);
+      exp10= -static_cast<int32_t>(str - fracStart);
+      digits+= static_cast<int32_t>(str - fracStart);
+    }
+    if (digits == 0) {
+      return false;
+    }
+    if (str < end && (*str == 'e' || *str == 'E')) {
+      bool negativeExp= false;
+      uint64_t explicitExp= 0;
+      ++str;
+      if (str < end && (*str == '-' || *str == '+')) {
+        negativeExp= *str == '-';
+        ++str;
+      }
+      const char* expStart= str;
+      str= parseDigits(str, end, explicitExp);
+      if (str == expStart || str - expStart > 4) {
+        return false;
+      }
+      exp10+= negativeExp ? -static_cast<int32_t>(explicitExp) : static_cast<int32_t>(explicitExp);
+    }
+    // Leading zeros do not make the significand overflow
+    while (digits > 19 && *digitsStart == '0') {
+      ++digitsStart;
+      --digits;
+    }
+    if (str != end || digits > 19 || significand > (1ULL << 53) || exp10 < -22 || exp10 > 22) {
+      return false;
+    }
+    result= static_cast<double>(significand);
+    if (exp10 < 0) {
+      result/= exactPow10[-exp10];
+    }
+    else {
+      result*= exactPow10[exp10];
+    }
+    if (negative) {
+      result= -result;
+    }
+    return true;
+#endif
   }
 
   int64_t safer_strtoll(const char* str, uint32_t len) {
 
-    int64_t sign= 1;
+    bool negative= false;
 
-    while (*str == ' ') {
+    while (len > 0 && *str == ' ') {
       ++str;
       --len;
     }
 
-    if (*str == '-') {
-      sign= -1;
+    if (len > 0 && *str == '-') {
+      negative= true;
       ++str;
       --len;
     }
-
-    return core_strtoll(str, len)*sign;
+    // Negating in unsigned, since the absolute value of INT64_MIN does not fit int64_t
+    const uint64_t absValue= static_cast<uint64_t>(core_strtoll(str, len));
+    return static_cast<int64_t>(negative ? 0 - absValue : absValue);
   }
 
 
@@ -114,6 +221,13 @@ namespace mariadb
   uint64_t stoull(const char* str, std::size_t len, std::size_t* pos)
   {
     len= len == static_cast<std::size_t>(-1) ? std::strlen(str) : len;
+    uint64_t result;
+    if (fastStoull(str, len, result)) {
+      if (pos != nullptr) {
+        *pos= len;
+      }
+      return result;
+    }
     return mariadb::stoull(SQLString(str, len), pos);
   }
 
@@ -253,6 +367,10 @@ namespace mariadb
 
   long double Row::stringToDouble(const char* str, uint32_t len)
   {
+    double fastResult;
+    if (fastStringToDouble(str, len, fastResult)) {
+      return fastResult;
+    }
     std::string doubleAsString(str, len);
     std::istringstream convStream(doubleAsString);
     std::locale C("C");
@@ -40,6 +40,8 @@ class ColumnDefinition;
 int64_t safer_strtoll(const char* str, uint32_t len);
 uint64_t stoull(const SQLString& str, std::size_t* pos= nullptr);
 uint64_t stoull(const char* str, std::size_t len= -1, std::size_t* pos= nullptr);
+bool fastStoull(const char* str, std::size_t len, uint64_t& result);
+bool fastStringToDouble(const char* str, std::size_t len, double& result);
 
 struct memBuf : public std::streambuf
 {
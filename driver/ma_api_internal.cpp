@@ -272,6 +272,12 @@ SQLRETURN MA_SQLCancel(SQLHSTMT StatementHandle)
   MDBUG_C_ENTER(Stmt->Connection, "SQLCancel");
   MDBUG_C_DUMP(Stmt->Connection, Stmt, 0x);
 
+  /* Reading of next results in the background holds the lock as well, and may wait for the server for as long as the
+     query runs. Thus here it's only told to stop. It's waited for after the query is killed */
+  if (Stmt->stmt && STMT_EXECUTED(Stmt))
+  {
+    Stmt->stmt->cancelPrefetch(false);
+  }
   auto& lock= Stmt->Connection->guard->getLock();
   
   if (lock.try_lock())
@@ -316,6 +322,11 @@ SQLRETURN MA_SQLCancel(SQLHSTMT StatementHandle)
       ret= SQL_SUCCESS;
     }
     mysql_close(MariaDb);
+    /* If it was the prefetch holding the lock, it gets the error now and stops */
+    if (ret == SQL_SUCCESS && Stmt->stmt && STMT_EXECUTED(Stmt))
+    {
+      Stmt->stmt->cancelPrefetch();
+    }
   }
 end:
   MDBUG_C_RETURN(Stmt->Connection, ret, &Stmt->Error);
@@ -887,7 +898,7 @@ SQLRETURN MA_SQLEndTran(SQLSMALLINT HandleType,
     {
       MADB_Env *Env= (MADB_Env *)Handle;
 
-      for (auto& con: Env->Dbcs)
+      for (auto& con: Env->getConnections())
       {
         try
         {
@@ -1572,8 +1583,8 @@ SQLRETURN MA_SQLGetDiagRecW(SQLSMALLINT HandleType,
   if (!Handle)
     return SQL_INVALID_HANDLE;
 
-  /* Maria ODBC driver doesn't support error lists, so only the first record can be retrieved */
-  if (RecNumber != 1)
+  /* Only statements can have more than one diagnostic record */
+  if (RecNumber != 1 && HandleType != SQL_HANDLE_STMT)
     return SQL_NO_DATA_FOUND;
   
   switch (HandleType) {
@@ -1587,8 +1598,11 @@ SQLRETURN MA_SQLGetDiagRecW(SQLSMALLINT HandleType,
       break;
     case SQL_HANDLE_STMT:
       {
-        MADB_Stmt *Stmt= (MADB_Stmt *)Handle;
-        return MADB_GetDiagRec(&Stmt->Error, RecNumber, (void *)SQLState, NativeErrorPtr,
+        MADB_Stmt  *Stmt= (MADB_Stmt *)Handle;
+        MADB_Error *Err=  Stmt->DiagRecord(RecNumber);
+        if (Err == NULL)
+          return SQL_NO_DATA_FOUND;
+        return MADB_GetDiagRec(Err, 1, (void *)SQLState, NativeErrorPtr,
                                (void *)MessageText, BufferLength, TextLengthPtr, TRUE,
                                Stmt->Connection->Environment->OdbcVersion);
       }
@@ -1668,8 +1682,8 @@ SQLRETURN MA_SQLGetDiagRec(SQLSMALLINT HandleType,
   if (RecNumber < 1 || BufferLength < 0)
     MDBUG_RETURN(SQL_ERROR);
 
-  /* Maria ODBC driver doesn't support error lists, so only the first record can be retrieved */
-  if (RecNumber != 1)
+  /* Only statements can have more than one diagnostic record */
+  if (RecNumber != 1 && HandleType != SQL_HANDLE_STMT)
     MDBUG_RETURN(SQL_NO_DATA_FOUND);
   
   switch (HandleType) {
@@ -1700,7 +1714,13 @@ SQLRETURN MA_SQLGetDiagRec(SQLSMALLINT HandleType,
         MDBUG_C_DUMP(Stmt->Connection, BufferLength, d);
         MDBUG_C_DUMP(Stmt->Connection, TextLengthPtr, 0x);
 
-        ret= MADB_GetDiagRec(&Stmt->Error, RecNumber, (void *)SQLState, NativeErrorPtr,
+        MADB_Error *Err= Stmt->DiagRecord(RecNumber);
+        if (Err == NULL)
+        {
+          ret= SQL_NO_DATA_FOUND;
+          break;
+        }
+        ret= MADB_GetDiagRec(Err, 1, (void *)SQLState, NativeErrorPtr,
                                (void *)MessageText, BufferLength, TextLengthPtr, FALSE,
                                Stmt->Connection->Environment->OdbcVersion);
       }
@@ -20,11 +20,16 @@
 /* Code allowing to deploy MariaDB bulk operation functionality.
  * i.e. adapting ODBC param arrays to MariaDB arrays */
 
+#include <cctype>
+#include <algorithm>
+
 #include "ma_odbc.h"
 
 #include "class/ResultSetMetaData.h"
 #include "class/ClientSidePreparedStatement.h"
 #include "class/ServerSidePreparedStatement.h"
+#include "class/Protocol.h"
+#include "class/Parameter.h"
 
 #define MAODBC_DATTIME_AS_PTR_ARR 1
 
@@ -77,6 +82,7 @@ void MADB_CleanBulkOperData(MADB_Stmt *Stmt, unsigned int ParamOffset)
       // We were doing callbacks - there is nothing to do any more
       Stmt->Bulk.ArraySize= 0;
       Stmt->Bulk.HasRowsToSkip= 0;
+      Stmt->Bulk.LoadData= false;
       return;
     }
     MADB_DescRecord *CRec;
@@ -122,6 +128,7 @@ void MADB_CleanBulkOperData(MADB_Stmt *Stmt, unsigned int ParamOffset)
     }
     Stmt->Bulk.ArraySize= 0;
     Stmt->Bulk.HasRowsToSkip= 0;
+    Stmt->Bulk.LoadData= false;
   }
 }
 
@@ -463,13 +470,365 @@ void MADB_Stmt::setupBulkCallbacks(uint32_t parNr, MADB_DescRecord* CRec, MADB_D
   stmt->setParamCallback(paramCodec[parNr].get(), parNr);
 }
 
+/* {{{ MADB_InsertToLoadData
+       Parameter arrays of a plain INSERT IGNORE [INTO] table [(columns)] VALUES (?,...) may go as the input of
+       LOAD DATA LOCAL INFILE. Anything else in the query, comments included, makes it go the usual way. LOCAL implies
+       IGNORE on the server, i.e. failing rows of an INSERT without IGNORE would be silently skipped, thus it is not
+       accepted.
+       Returns next token of the query - a word, a quoted identifier, or a character. Length is 0 if there is nothing
+       more, or the token is not acceptable here */
+static const char* MADB_NextInsertToken(MADB_Stmt *Stmt, const char *&Pos, const char *End, std::size_t &Length)
+{
+  while (Pos < End && std::isspace(static_cast<unsigned char>(*Pos)))
+  {
+    ++Pos;
+  }
+  const char *Token= Pos;
+
+  if (Pos == End)
+  {
+    Length= 0;
+    return Token;
+  }
+  if (*Pos == '`' || (*Pos == '"' && Stmt->Query.AnsiQuotes))
+  {
+    const char Quote= *Pos;
+    for (++Pos; Pos < End; ++Pos)
+    {
+      if (*Pos == Quote)
+      {
+        /* Doubled quote is the quote character in the identifier */
+        if (Pos + 1 < End && Pos[1] == Quote)
+        {
+          ++Pos;
+          continue;
+        }
+        ++Pos;
+        Length= Pos - Token;
+        return Token;
+      }
+    }
+    Length= 0;
+    return Token;
+  }
+  while (Pos < End && (std::isalnum(static_cast<unsigned char>(*Pos)) || *Pos == '_' || *Pos == '$' || (*Pos & 0x80) != 0))
+  {
+    ++Pos;
+  }
+  if (Pos == Token)
+  {
+    ++Pos;
+  }
+  Length= Pos - Token;
+  return Token;
+}
+
+
+static bool MADB_TokenIs(const char *Token, std::size_t Length, const char *Keyword)
+{
+  return Length == strlen(Keyword) && _strnicmp(Token, Keyword, Length) == 0;
+}
+
+
+static bool MADB_TokenIsIdentifier(const char *Token, std::size_t Length)
+{
+  return Length > 0 && (Length > 1 || std::isalnum(static_cast<unsigned char>(*Token)) || *Token == '_' || *Token == '$'
+    || (*Token & 0x80) != 0);
+}
+
+
+static bool MADB_InsertToLoadData(MADB_Stmt *Stmt, SQLString &LoadStmt)
+{
+  const char  *Pos= STMT_STRING(Stmt).c_str(), *End= Pos + STMT_STRING(Stmt).length(), *Token;
+  std::size_t Length, Columns= 0, Markers= 0;
+  SQLString   Table, ColumnList;
+
+  Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  if (!MADB_TokenIs(Token, Length, "INSERT"))
+  {
+    return false;
+  }
+  Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  if (!MADB_TokenIs(Token, Length, "IGNORE"))
+  {
+    return false;
+  }
+  Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  if (MADB_TokenIs(Token, Length, "INTO"))
+  {
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  }
+  /* Table name, possibly qualified with the schema */
+  if (!MADB_TokenIsIdentifier(Token, Length) || MADB_TokenIs(Token, Length, "VALUES"))
+  {
+    return false;
+  }
+  Table.assign(Token, Length);
+  Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  if (Length == 1 && *Token == '.')
+  {
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+    if (!MADB_TokenIsIdentifier(Token, Length))
+    {
+      return false;
+    }
+    Table.append(1, '.').append(Token, Length);
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  }
+  if (Length == 1 && *Token == '(')
+  {
+    do
+    {
+      Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+      if (!MADB_TokenIsIdentifier(Token, Length))
+      {
+        return false;
+      }
+      ColumnList.append(ColumnList.empty() ? "(" : ",").append(Token, Length);
+      ++Columns;
+      Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+    } while (Length == 1 && *Token == ',');
+
+    if (Length != 1 || *Token != ')')
+    {
+      return false;
+    }
+    ColumnList.append(1, ')');
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  }
+  if (!MADB_TokenIs(Token, Length, "VALUES") && !MADB_TokenIs(Token, Length, "VALUE"))
+  {
+    return false;
+  }
+  Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  if (Length != 1 || *Token != '(')
+  {
+    return false;
+  }
+  do
+  {
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+    if (Length != 1 || *Token != '?')
+    {
+      return false;
+    }
+    ++Markers;
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  } while (Length == 1 && *Token == ',');
+
+  if (Length != 1 || *Token != ')')
+  {
+    return false;
+  }
+  Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  if (Length == 1 && *Token == ';')
+  {
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  }
+  if (Length != 0 || Pos != End || Markers != static_cast<std::size_t>(MADB_STMT_PARAM_COUNT(Stmt)) ||
+      (Columns > 0 && Columns != Markers))
+  {
+    return false;
+  }
+  /* Default field and line terminators, and escape character are what the input is generated with. The file name is
+     not used - the input comes from the handler */
+  LoadStmt.assign("LOAD DATA LOCAL INFILE 'maodbc_parameters' IGNORE INTO TABLE ").append(Table).append(" CHARACTER SET ").append(mysql_character_set_name(Stmt->Connection->mariadb));
+  if (!ColumnList.empty())
+  {
+    LoadStmt.append(1, ' ').append(ColumnList);
+  }
+  return true;
+}
+/* }}} */
+
+/* {{{ MADB_LoadDataPossible */
+static bool MADB_LoadDataPossible(MADB_Stmt *Stmt, SQLString &LoadStmt)
+{
+  return Stmt->Options.LoadData == SQL_TRUE
+      && Stmt->Options.ContinueOnError != SQL_TRUE                    /* Rows are not reported separately */
+      && Stmt->Connection->Dsn->DisableLocalInfile == '\0'
+      && Stmt->Query.QueryType == MADB_QUERY_INSERT
+      && !QUERY_IS_MULTISTMT(Stmt->Query)
+      && MADB_InsertToLoadData(Stmt, LoadStmt);
+}
+/* }}} */
+
+/* Input of LOAD DATA, generated from the bound parameters arrays by chunks of rows */
+struct MADB_LoadDataInput
+{
+  MADB_Stmt   *Stmt;
+  MYSQL_BIND  *Params;
+  std::size_t ParamCount;
+  std::size_t Row= 0;
+  std::size_t RowsSent= 0;
+  std::size_t Pos= 0;
+  SQLString   Chunk;
+  bool        Failed= false;
+
+  MADB_LoadDataInput(MADB_Stmt *_Stmt)
+    : Stmt(_Stmt)
+    , Params(_Stmt->params)
+    , ParamCount(MADB_STMT_PARAM_COUNT(_Stmt))
+  {}
+
+  bool SkipRow(std::size_t RowNr) const
+  {
+    for (std::size_t i= 0; i < ParamCount; ++i)
+    {
+      if (Params[i].u.indicator != nullptr && Params[i].u.indicator[RowNr] == STMT_INDICATOR_IGNORE_ROW)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /* Returns false if there is nothing more to send */
+  bool NextChunk()
+  {
+    const std::size_t ChunkSize= 64*1024;
+
+    Chunk.clear();
+    Pos= 0;
+    for (; Row < Stmt->Bulk.ArraySize && Chunk.length() < ChunkSize; ++Row)
+    {
+      if (SkipRow(Row))
+      {
+        continue;
+      }
+      for (std::size_t i= 0; i < ParamCount; ++i)
+      {
+        if (i > 0)
+        {
+          Chunk.append(1, '\t');
+        }
+        if (!Parameter::toLoadData(Chunk, Params[i], Row))
+        {
+          Failed= true;
+          return false;
+        }
+      }
+      Chunk.append(1, '\n');
+      ++RowsSent;
+    }
+    return !Chunk.empty();
+  }
+};
+
+
+static int MADB_LoadDataInit(void **Ptr, const char *Filename, void *UserData)
+{
+  *Ptr= UserData;
+  return 0;
+}
+
+
+static int MADB_LoadDataRead(void *Ptr, char *Buffer, unsigned int BufferLength)
+{
+  MADB_LoadDataInput *Input= static_cast<MADB_LoadDataInput*>(Ptr);
+  unsigned int Copied= 0;
+
+  while (Copied < BufferLength)
+  {
+    if (Input->Pos == Input->Chunk.length() && !Input->NextChunk())
+    {
+      break;
+    }
+    std::size_t Portion= (std::min)(static_cast<std::size_t>(BufferLength - Copied), Input->Chunk.length() - Input->Pos);
+    std::memcpy(Buffer + Copied, Input->Chunk.data() + Input->Pos, Portion);
+    Input->Pos+= Portion;
+    Copied+= static_cast<unsigned int>(Portion);
+  }
+  return Input->Failed ? -1 : static_cast<int>(Copied);
+}
+
+
+static void MADB_LoadDataEnd(void *Ptr)
+{
+}
+
+
+static int MADB_LoadDataError(void *Ptr, char *ErrorMsg, unsigned int ErrorMsgLength)
+{
+  if (ErrorMsgLength > 0)
+  {
+    strncpy(ErrorMsg, "Parameter value can't be sent as LOAD DATA input", ErrorMsgLength - 1);
+    ErrorMsg[ErrorMsgLength - 1]= '\0';
+  }
+  return CR_UNKNOWN_ERROR;
+}
+
+/* {{{ MADB_ExecuteLoadData
+       Sends the parameters array as LOAD DATA LOCAL INFILE input. Returns SQL_NO_DATA if that is not possible - some
+       value is the column default, some parameter type can't be sent this way, or the server does not allow local
+       infile. Then the array has to go the usual way. Only INSERT IGNORE gets here, rows failing on the server are
+       skipped with warnings. If any is skipped, or there are warnings, the general warning with the load info is
+       returned, and parameter statuses are not available */
+static SQLRETURN MADB_ExecuteLoadData(MADB_Stmt *Stmt, const SQLString &LoadStmt)
+{
+  MADB_LoadDataInput Input(Stmt);
+  MYSQL *Mariadb= Stmt->Connection->mariadb;
+
+  for (std::size_t i= 0; i < Input.ParamCount; ++i)
+  {
+    if (!Parameter::isLoadDataType(Stmt->params[i]))
+    {
+      return SQL_NO_DATA;
+    }
+    if (Stmt->params[i].u.indicator == nullptr)
+    {
+      continue;
+    }
+    for (std::size_t row= 0; row < Stmt->Bulk.ArraySize; ++row)
+    {
+      if (Stmt->params[i].u.indicator[row] == STMT_INDICATOR_IGNORE || Stmt->params[i].u.indicator[row] == STMT_INDICATOR_DEFAULT)
+      {
+        return SQL_NO_DATA;
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> localScopeLock(Stmt->Connection->guard->getLock());
+  mysql_set_local_infile_handler(Mariadb, MADB_LoadDataInit, MADB_LoadDataRead, MADB_LoadDataEnd, MADB_LoadDataError, &Input);
+  try
+  {
+    Stmt->Connection->guard->safeRealQuery(LoadStmt);
+  }
+  catch (SQLException &e)
+  {
+    mysql_set_local_infile_default(Mariadb);
+    /* ER_NOT_ALLOWED_COMMAND and ER_LOAD_INFILE_CAPABILITY_DISABLED - local infile is disabled on the server */
+    if (Input.RowsSent == 0 && (e.getErrorCode() == 1148 || e.getErrorCode() == 4166))
+    {
+      return SQL_NO_DATA;
+    }
+    return MADB_FromException(Stmt->Error, e);
+  }
+  mysql_set_local_infile_default(Mariadb);
+
+  Stmt->Bulk.LoadData= true;
+  Stmt->rs.reset();
+  Stmt->State= MADB_SS_EXECUTED;
+  Stmt->AffectedRows+= mysql_affected_rows(Mariadb);
+
+  if (mysql_warning_count(Mariadb) > 0 || mysql_affected_rows(Mariadb) < Input.RowsSent)
+  {
+    return MADB_SetError(&Stmt->Error, MADB_ERR_01000, mysql_info(Mariadb), 0);
+  }
+  return SQL_SUCCESS;
+}
+/* }}} */
+
 /* {{{ MADB_ExecuteBulk */
 /* Assuming that bulk insert can't go with DAE(and that unlikely ever changes). And that it has been checked before this call,
 and we can't have DAE here */
 SQLRETURN MADB_ExecuteBulk(MADB_Stmt *Stmt, unsigned int ParamOffset)
 {
   unsigned int  i, IndIdx= -1;
-  bool useCallbacks= Stmt->Connection->Dsn->ParamCallbacks;
+  SQLString     LoadStmt;
+  const bool    loadData= MADB_LoadDataPossible(Stmt, LoadStmt);
+  /* LOAD DATA input is generated from the arrays of values */
+  bool useCallbacks= Stmt->Connection->Dsn->ParamCallbacks && !loadData;
 
   if (Stmt->stmt->isServerSide() && !MADB_ServerSupports(Stmt->Connection, MADB_CAPABLE_PARAM_ARRAYS))
   {
@@ -544,6 +903,248 @@ SQLRETURN MADB_ExecuteBulk(MADB_Stmt *Stmt, unsigned int ParamOffset)
       }
     }
   }
+  if (loadData)
+  {
+    SQLRETURN rc= MADB_ExecuteLoadData(Stmt, LoadStmt);
+    if (rc != SQL_NO_DATA)
+    {
+      return rc;
+    }
+  }
   return Stmt->DoExecuteBatch();
 }
 /* }}} */
+
+/* {{{ MADB_UnquoteIdentifier
+       Returns the identifier token without the quotes, and with the doubled quote characters inside it unescaped */
+static SQLString MADB_UnquoteIdentifier(const char *Token, std::size_t Length)
+{
+  if (Length < 2 || (*Token != '`' && *Token != '"'))
+  {
+    return SQLString(Token, Length);
+  }
+  SQLString Result;
+  for (std::size_t i= 1; i < Length - 1; ++i)
+  {
+    Result.append(1, Token[i]);
+    /* Doubled quote */
+    if (Token[i] == *Token)
+    {
+      ++i;
+    }
+  }
+  return Result;
+}
+/* }}} */
+
+/* {{{ MADB_AppendStringLiteral
+       Appends the value to the query as the string literal, escaped for the connection charset */
+static void MADB_AppendStringLiteral(MADB_Stmt *Stmt, SQLString &Query, const SQLString &Value)
+{
+  std::vector<char> Escaped(Value.length()*2 + 1);
+  unsigned long     Length= mysql_real_escape_string(Stmt->Connection->mariadb, Escaped.data(), Value.c_str(),
+                                                     static_cast<unsigned long>(Value.length()));
+  Query.append(1, '\'').append(Escaped.data(), Length).append(1, '\'');
+}
+/* }}} */
+
+/* {{{ MADB_BulkIsAtomic
+       Tells if the bulk execution, that has failed, has left nothing behind, and parts of the parameters array can be
+       executed again. That is known only for INSERT into the table of a transactional engine - the server rolls back
+       the failed statement then. The answer is remembered till the statement is prepared again */
+bool MADB_BulkIsAtomic(MADB_Stmt *Stmt)
+{
+  if (Stmt->BulkAtomic >= 0)
+  {
+    return Stmt->BulkAtomic > 0;
+  }
+  Stmt->BulkAtomic= 0;
+  if (Stmt->Query.QueryType != MADB_QUERY_INSERT || QUERY_IS_MULTISTMT(Stmt->Query))
+  {
+    return false;
+  }
+
+  const char  *Pos= STMT_STRING(Stmt).c_str(), *End= Pos + STMT_STRING(Stmt).length(), *Token;
+  std::size_t Length;
+  SQLString   Schema, Table, Query;
+
+  Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  if (!MADB_TokenIs(Token, Length, "INSERT"))
+  {
+    return false;
+  }
+  Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  if (MADB_TokenIs(Token, Length, "IGNORE"))
+  {
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  }
+  if (MADB_TokenIs(Token, Length, "INTO"))
+  {
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  }
+  if (!MADB_TokenIsIdentifier(Token, Length))
+  {
+    return false;
+  }
+  Table= MADB_UnquoteIdentifier(Token, Length);
+  Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+  if (Length == 1 && *Token == '.')
+  {
+    Token= MADB_NextInsertToken(Stmt, Pos, End, Length);
+    if (!MADB_TokenIsIdentifier(Token, Length))
+    {
+      return false;
+    }
+    Schema= Table;
+    Table= MADB_UnquoteIdentifier(Token, Length);
+  }
+
+  Query.assign("SELECT 1 FROM information_schema.TABLES t JOIN information_schema.ENGINES e ON e.ENGINE=t.ENGINE "
+               "WHERE e.TRANSACTIONS='YES' AND t.TABLE_SCHEMA=");
+  if (Schema.empty())
+  {
+    Query.append("DATABASE()");
+  }
+  else
+  {
+    MADB_AppendStringLiteral(Stmt, Query, Schema);
+  }
+  Query.append(" AND t.TABLE_NAME=");
+  MADB_AppendStringLiteral(Stmt, Query, Table);
+
+  try
+  {
+    std::lock_guard<std::mutex> localScopeLock(Stmt->Connection->guard->getLock());
+    Stmt->Connection->guard->safeRealQuery(Query);
+    MYSQL_RES *Res= mysql_store_result(Stmt->Connection->mariadb);
+    if (Res != nullptr)
+    {
+      Stmt->BulkAtomic= mysql_num_rows(Res) > 0 ? 1 : 0;
+      mysql_free_result(Res);
+    }
+  }
+  catch (SQLException&)
+  {
+    /* Not known then */
+  }
+  return Stmt->BulkAtomic > 0;
+}
+/* }}} */
+
+/* {{{ MADB_ExecuteBulkByParts
+       Executes the parameters array, that has failed as a whole, by halves, and halves of failed halves, till failed
+       parameter sets are found. Parts still go the bulk way - all rows but those of the part are marked as ignored.
+       Only for the query, that MADB_BulkIsAtomic, otherwise rows applied before the failure would be applied twice.
+       Returns the number of failed parameter sets, their errors are appended to RowErrors */
+unsigned int MADB_ExecuteBulkByParts(MADB_Stmt *Stmt, unsigned int ParamOffset, unsigned int ArraySize,
+                                     std::vector<MADB_Error> &RowErrors)
+{
+  SQLUSMALLINT *AppOperation= Stmt->Apd->Header.ArrayStatusPtr,
+               *ParamStatus=  Stmt->Ipd->Header.ArrayStatusPtr;
+  const SQLULEN Start= Stmt->ArrayOffset, End= Start + ArraySize;
+  std::vector<SQLUSMALLINT> Operation(End, SQL_PARAM_IGNORE);
+  std::vector<std::pair<SQLULEN, SQLULEN>> Parts;
+  unsigned int ErrorCount= 0;
+
+  /* The whole array has failed already. Parts are taken from the back, thus first half goes last */
+  Parts.emplace_back(Start + ArraySize / 2, End);
+  Parts.emplace_back(Start, Start + ArraySize / 2);
+  Stmt->Apd->Header.ArrayStatusPtr= Operation.data();
+
+  if (ParamStatus != nullptr && AppOperation != nullptr)
+  {
+    for (SQLULEN row= Start; row < End; ++row)
+    {
+      if (AppOperation[row] == SQL_PARAM_IGNORE)
+      {
+        ParamStatus[row - Start]= SQL_PARAM_UNUSED;
+      }
+    }
+  }
+
+  while (!Parts.empty())
+  {
+    const SQLULEN PartStart= Parts.back().first, PartEnd= Parts.back().second;
+    SQLULEN       row, Active= 0, LastActive= PartStart;
+    SQLRETURN     rc;
+
+    Parts.pop_back();
+    for (row= Start; row < End; ++row)
+    {
+      if (row >= PartStart && row < PartEnd && (AppOperation == nullptr || AppOperation[row] != SQL_PARAM_IGNORE))
+      {
+        Operation[row]= SQL_PARAM_PROCEED;
+        LastActive= row;
+        ++Active;
+      }
+      else
+      {
+        Operation[row]= SQL_PARAM_IGNORE;
+      }
+    }
+    if (Active == 0)
+    {
+      continue;
+    }
+
+    Stmt->Bulk.ArraySize=     ArraySize;
+    Stmt->Bulk.HasRowsToSkip= 1;
+    rc= MADB_ExecuteBulk(Stmt, ParamOffset);
+    if (SQL_SUCCEEDED(rc) && !Stmt->rs)
+    {
+      Stmt->AffectedRows+= Stmt->stmt->getUpdateCount();
+    }
+    MADB_CleanBulkOperData(Stmt, ParamOffset);
+
+    if (SQL_SUCCEEDED(rc) || Active == 1)
+    {
+      if (!SQL_SUCCEEDED(rc))
+      {
+        RowErrors.push_back(Stmt->Error);
+        RowErrors.back().RowNumber= static_cast<SQLLEN>(LastActive - Start + 1);
+        ++ErrorCount;
+      }
+      if (ParamStatus != nullptr)
+      {
+        for (row= PartStart; row < PartEnd; ++row)
+        {
+          if (Operation[row] == SQL_PARAM_PROCEED)
+          {
+            ParamStatus[row - Start]= SQL_SUCCEEDED(rc) ? SQL_PARAM_SUCCESS : SQL_PARAM_ERROR;
+          }
+        }
+      }
+    }
+    /* Without connection there is no sense to go on. Rows not executed yet get the same error */
+    else if (strncmp(Stmt->Error.SqlState, "08", 2) == 0)
+    {
+      RowErrors.push_back(Stmt->Error);
+      Parts.emplace_back(PartStart, PartEnd);
+      for (auto& Part : Parts)
+      {
+        for (row= Part.first; row < Part.second; ++row)
+        {
+          if (AppOperation == nullptr || AppOperation[row] != SQL_PARAM_IGNORE)
+          {
+            ++ErrorCount;
+            if (ParamStatus != nullptr)
+            {
+              ParamStatus[row - Start]= SQL_PARAM_DIAG_UNAVAILABLE;
+            }
+          }
+        }
+      }
+      Parts.clear();
+    }
+    else
+    {
+      const SQLULEN Middle= PartStart + (PartEnd - PartStart) / 2;
+      Parts.emplace_back(Middle, PartEnd);
+      Parts.emplace_back(PartStart, Middle);
+    }
+  }
+  Stmt->Apd->Header.ArrayStatusPtr= AppOperation;
+
+  return ErrorCount;
+}
+/* }}} */
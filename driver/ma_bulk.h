@@ -59,5 +59,8 @@ void          MADB_InitBulkOperBuffers(MADB_Stmt *Stmt, MADB_DescRecord *CRec, v
 void          MADB_SetIndicatorValue(MADB_Stmt *Stmt, MYSQL_BIND *MaBind, unsigned int row, SQLLEN OdbcIndicator);
 
 SQLRETURN     MADB_ExecuteBulk(MADB_Stmt *Stmt, unsigned int ParamOffset);
+bool          MADB_BulkIsAtomic(MADB_Stmt *Stmt);
+unsigned int  MADB_ExecuteBulkByParts(MADB_Stmt *Stmt, unsigned int ParamOffset, unsigned int ArraySize,
+                                      std::vector<MADB_Error> &RowErrors);
 
 #endif
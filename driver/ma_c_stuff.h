@@ -76,6 +76,11 @@ struct MADB_Error
   char SqlErrorMsg[SQL_MAX_MESSAGE_LENGTH + 1];
   char SqlState[SQLSTATE_LENGTH + 1];
   SQLRETURN ReturnValue;
+  /* Row and column(or parameter) the record is about, 0 if not known */
+  SQLLEN RowNumber;
+  SQLINTEGER ColumnNumber;
+  /* Number of records following this one. They are kept by the statement, as only statement can have them */
+  unsigned int ExtraRecords;
 };
 
 /**
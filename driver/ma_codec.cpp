@@ -18,6 +18,8 @@
 *************************************************************************************/
 
 #include <cstdio>
+#include <limits>
+#include <type_traits>
 #include "ma_codec.h"
 #include "class/ResultSetMetaData.h"
 #include "ma_string.h"
@@ -468,5 +470,210 @@ namespace mariadb
       *it.length()= length;
     }
   }
-}
 
+
+  void BoundRCodec::setNull(MADB_Stmt* Stmt)
+  {
+    if (it.indicator() != nullptr) {
+      *it.indicator()= SQL_NULL_DATA;
+    }
+    else {
+      CALC_ALL_FLDS_RC(Stmt->aggRc, MADB_SetError(&Stmt->Error, MADB_ERR_22002, NULL, 0));
+    }
+  }
+
+  /* Indicator could have been set to SQL_NULL_DATA by the previous fetch */
+  void BoundRCodec::clearIndicator()
+  {
+    if (it.indicator() != nullptr && it.indicator() != it.length() && *it.indicator() < 0) {
+      *it.indicator()= 0;
+    }
+  }
+
+
+  void TimestampRCodec::operator()(void * data, uint32_t column, unsigned char* row, unsigned long length)
+  {
+    MADB_Stmt *Stmt= reinterpret_cast<MADB_Stmt*>(data);
+    MYSQL_TIME tm;
+
+    if (length == NULL_LENGTH) {
+      setNull(Stmt);
+      return;
+    }
+    clearIndicator();
+    std::memset(&tm, 0, sizeof(MYSQL_TIME));
+    // Binary protocol date is 0, 4, 7 or 11 bytes long - trailing zero parts are omitted
+    if (length >= 4) {
+      tm.year=  row[0] | (row[1] << 8);
+      tm.month= row[2];
+      tm.day=   row[3];
+      if (length >= 7) {
+        tm.hour=   row[4];
+        tm.minute= row[5];
+        tm.second= row[6];
+        if (length >= 11) {
+          tm.second_part= row[7] | (row[8] << 8) | (row[9] << 16) | (static_cast<unsigned long>(row[10]) << 24);
+        }
+      }
+    }
+    tm.time_type= fieldType == MYSQL_TYPE_DATE ? MYSQL_TIMESTAMP_DATE : MYSQL_TIMESTAMP_DATETIME;
+    CALC_ALL_FLDS_RC(Stmt->aggRc, MADB_CopyMadbTimestamp(&Stmt->Error, &tm, it.value(), it.length(), it.indicator(),
+      it.getDescRec()->Type, irdRec->ConciseType));
+  }
+
+  void NumericRCodec::operator()(void * data, uint32_t column, unsigned char* row, unsigned long length)
+  {
+    MADB_Stmt *Stmt= reinterpret_cast<MADB_Stmt*>(data);
+    SQL_NUMERIC_STRUCT *number= static_cast<SQL_NUMERIC_STRUCT*>(it.value());
+
+    if (length == NULL_LENGTH) {
+      setNull(Stmt);
+      return;
+    }
+    clearIndicator();
+    if (number != nullptr) {
+      MADB_NumericInit(number, it.getDescRec());
+      int rc= MADB_DecimalToNumeric(reinterpret_cast<const char*>(row), length, number);
+      if (rc != 0) {
+        CALC_ALL_FLDS_RC(Stmt->aggRc, MADB_SetError(&Stmt->Error, rc, NULL, 0));
+      }
+    }
+    if (it.length() != nullptr) {
+      *it.length()= sizeof(SQL_NUMERIC_STRUCT);
+    }
+  }
+
+  /* If all values of SrcT can be represented in DstT */
+  template <typename SrcT, typename DstT> struct LosslessCast
+  {
+    static const bool value= std::is_floating_point<DstT>::value ?
+      (std::is_floating_point<SrcT>::value ? sizeof(DstT) >= sizeof(SrcT) :
+        std::numeric_limits<SrcT>::digits <= std::numeric_limits<DstT>::digits) :
+      (std::is_integral<SrcT>::value &&
+        (std::is_signed<SrcT>::value == std::is_signed<DstT>::value ? sizeof(DstT) >= sizeof(SrcT) :
+          std::is_signed<DstT>::value && sizeof(DstT) > sizeof(SrcT)));
+  };
+
+  template <typename SrcT, typename DstT, bool lossless= LosslessCast<SrcT, DstT>::value> struct FixedRCodecFactory
+  {
+    static BoundRCodec* create(const DescArrayIterator& cit, SQLSMALLINT cType, const MYSQL_FIELD* field)
+    {
+      return new FixedRCodec<SrcT, DstT>(cit, cType, field);
+    }
+  };
+
+  template <typename SrcT, typename DstT> struct FixedRCodecFactory<SrcT, DstT, false>
+  {
+    static BoundRCodec* create(const DescArrayIterator& cit, SQLSMALLINT cType, const MYSQL_FIELD* field)
+    {
+      return nullptr;
+    }
+  };
+
+  template <typename SrcT>
+  BoundRCodec* createFixedRCodec(const DescArrayIterator& cit, SQLSMALLINT cType, const MYSQL_FIELD* field)
+  {
+    switch (cType) {
+    case SQL_C_TINYINT:
+    case SQL_C_STINYINT:
+      return FixedRCodecFactory<SrcT, SQLSCHAR>::create(cit, cType, field);
+    case SQL_C_UTINYINT:
+      return FixedRCodecFactory<SrcT, SQLCHAR>::create(cit, cType, field);
+    case SQL_C_SHORT:
+    case SQL_C_SSHORT:
+      return FixedRCodecFactory<SrcT, SQLSMALLINT>::create(cit, cType, field);
+    case SQL_C_USHORT:
+      return FixedRCodecFactory<SrcT, SQLUSMALLINT>::create(cit, cType, field);
+    case SQL_C_LONG:
+    case SQL_C_SLONG:
+      return FixedRCodecFactory<SrcT, SQLINTEGER>::create(cit, cType, field);
+    case SQL_C_ULONG:
+      return FixedRCodecFactory<SrcT, SQLUINTEGER>::create(cit, cType, field);
+    case SQL_C_SBIGINT:
+      return FixedRCodecFactory<SrcT, SQLBIGINT>::create(cit, cType, field);
+    case SQL_C_UBIGINT:
+      return FixedRCodecFactory<SrcT, SQLUBIGINT>::create(cit, cType, field);
+    case SQL_C_FLOAT:
+      return FixedRCodecFactory<SrcT, SQLREAL>::create(cit, cType, field);
+    case SQL_C_DOUBLE:
+      return FixedRCodecFactory<SrcT, SQLDOUBLE>::create(cit, cType, field);
+    default:
+      return nullptr;
+    }
+  }
+
+
+  BoundRCodec* createResultCodec(MADB_DescRecord* irdRec, const MYSQL_FIELD* field, SQLSMALLINT cType,
+                                 const DescArrayIterator& cit)
+  {
+    static const uint16_t endiannessProbe= 1;
+    static const bool littleEndian= *reinterpret_cast<const char*>(&endiannessProbe) == 1;
+
+    switch (cType) {
+    case SQL_C_WCHAR:
+      switch (irdRec->ConciseType)
+      {
+      case WCHAR_TYPES:
+      case CHAR_BINARY_TYPES:
+        return new WcharRCodec(irdRec, cit, field);
+      }
+      break;
+    case SQL_C_CHAR:
+      switch (irdRec->ConciseType)
+      {
+      case WCHAR_TYPES:
+      case CHAR_BINARY_TYPES:
+        return new StringRCodec(irdRec, cit, field);
+      }
+      break;
+    case SQL_C_NUMERIC:
+      if (field->type == MYSQL_TYPE_NEWDECIMAL || field->type == MYSQL_TYPE_DECIMAL) {
+        return new NumericRCodec(cit, field);
+      }
+      break;
+    case SQL_C_TIMESTAMP:
+    case SQL_C_TYPE_TIMESTAMP:
+    case SQL_C_DATE:
+    case SQL_C_TYPE_DATE:
+      switch (field->type)
+      {
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+        return new TimestampRCodec(irdRec, cit, cType, field);
+      default:
+        break;
+      }
+      break;
+    default:
+    {
+      // Values on the wire are little-endian
+      if (!littleEndian) {
+        break;
+      }
+      bool isUnsigned= (field->flags & UNSIGNED_FLAG) != 0;
+      switch (field->type)
+      {
+      case MYSQL_TYPE_TINY:
+        return isUnsigned ? createFixedRCodec<uint8_t>(cit, cType, field) : createFixedRCodec<int8_t>(cit, cType, field);
+      case MYSQL_TYPE_SHORT:
+        return isUnsigned ? createFixedRCodec<uint16_t>(cit, cType, field) : createFixedRCodec<int16_t>(cit, cType, field);
+      case MYSQL_TYPE_YEAR:
+        return createFixedRCodec<uint16_t>(cit, cType, field);
+      case MYSQL_TYPE_INT24:
+      case MYSQL_TYPE_LONG:
+        return isUnsigned ? createFixedRCodec<uint32_t>(cit, cType, field) : createFixedRCodec<int32_t>(cit, cType, field);
+      case MYSQL_TYPE_LONGLONG:
+        return isUnsigned ? createFixedRCodec<uint64_t>(cit, cType, field) : createFixedRCodec<int64_t>(cit, cType, field);
+      case MYSQL_TYPE_FLOAT:
+        return createFixedRCodec<float>(cit, cType, field);
+      case MYSQL_TYPE_DOUBLE:
+        return createFixedRCodec<double>(cit, cType, field);
+      default:
+        break;
+      }
+    }
+    }
+    return nullptr;
+  }
+}
@@ -20,6 +20,7 @@
 #define _ma_codec_h_
 
 #include <memory>
+#include <cstring>
 #include "interface/PreparedStatement.h"
 #include "ma_odbc.h"
 
@@ -223,34 +224,118 @@ public:
 };
 
 
-class WcharRCodec : public ResultCodec
+/* Base of the codecs writing column values directly to the application buffers. Codec is created once per column
+   binding, and for each row it's only moved to the row's buffers. What codec is for is defined by the C type and the
+   column type, and that is used to check if the codec still fits the binding */
+class BoundRCodec : public ResultCodec
 {
-  MADB_DescRecord* irdRec;
+protected:
   DescArrayIterator it;
+  const SQLSMALLINT cType;
+  const enum enum_field_types fieldType;
+
+  void setNull(MADB_Stmt* Stmt);
+  void clearIndicator();
 
 public:
-  WcharRCodec(MADB_DescRecord* descRec, const DescArrayIterator& cit)
-    : irdRec(descRec)
-    , it(cit)
+  BoundRCodec(const DescArrayIterator& cit, SQLSMALLINT _cType, const MYSQL_FIELD* field)
+    : it(cit)
+    , cType(_cType)
+    , fieldType(field->type)
+  {}
+
+  void moveTo(const DescArrayIterator& cit) { it= cit; }
+  bool fits(MADB_DescRecord* ardRec, SQLSMALLINT _cType, const MYSQL_FIELD* field)
+  {
+    return it.getDescRec() == ardRec && cType == _cType && fieldType == field->type;
+  }
+};
+
+
+class WcharRCodec final : public BoundRCodec
+{
+  MADB_DescRecord* irdRec;
+
+public:
+  WcharRCodec(MADB_DescRecord* descRec, const DescArrayIterator& cit, const MYSQL_FIELD* field)
+    : BoundRCodec(cit, SQL_C_WCHAR, field)
+    , irdRec(descRec)
   {}
 
   void operator()(void *data, uint32_t col_nr, unsigned char* row, unsigned long length) override;
 };
 
 
-class StringRCodec : public ResultCodec
+class StringRCodec final : public BoundRCodec
 {
   MADB_DescRecord* irdRec;
-  DescArrayIterator it;
 
 public:
-  StringRCodec(MADB_DescRecord* descRec, const DescArrayIterator& cit)
-    : irdRec(descRec)
-    , it(cit)
+  StringRCodec(MADB_DescRecord* descRec, const DescArrayIterator& cit, const MYSQL_FIELD* field)
+    : BoundRCodec(cit, SQL_C_CHAR, field)
+    , irdRec(descRec)
   {}
 
   void operator()(void *data, uint32_t col_nr, unsigned char* row, unsigned long length) override;
 };
 
+/* Binary protocol DATE, DATETIME and TIMESTAMP values to date/time/timestamp structures */
+class TimestampRCodec final : public BoundRCodec
+{
+  MADB_DescRecord* irdRec;
+
+public:
+  TimestampRCodec(MADB_DescRecord* descRec, const DescArrayIterator& cit, SQLSMALLINT _cType, const MYSQL_FIELD* field)
+    : BoundRCodec(cit, _cType, field)
+    , irdRec(descRec)
+  {}
+
+  void operator()(void *data, uint32_t col_nr, unsigned char* row, unsigned long length) override;
+};
+
+/* DECIMAL value, that comes as a string, parsed right from the packet to the SQL_NUMERIC_STRUCT */
+class NumericRCodec final : public BoundRCodec
+{
+public:
+  NumericRCodec(const DescArrayIterator& cit, const MYSQL_FIELD* field)
+    : BoundRCodec(cit, SQL_C_NUMERIC, field)
+  {}
+
+  void operator()(void *data, uint32_t col_nr, unsigned char* row, unsigned long length) override;
+};
+
+/* Fixed-width binary protocol numeric value cast to the application's type. Only created for casts that can't lose
+   anything, the rest go the usual way via C/C conversion */
+template <typename SrcT, typename DstT>
+class FixedRCodec final : public BoundRCodec
+{
+public:
+  FixedRCodec(const DescArrayIterator& cit, SQLSMALLINT _cType, const MYSQL_FIELD* field)
+    : BoundRCodec(cit, _cType, field)
+  {}
+
+  void operator()(void *data, uint32_t col_nr, unsigned char* row, unsigned long length) override
+  {
+    if (length == NULL_LENGTH) {
+      setNull(reinterpret_cast<MADB_Stmt*>(data));
+      return;
+    }
+    clearIndicator();
+    if (it.value() != nullptr) {
+      SrcT value;
+      std::memcpy(&value, row, sizeof(SrcT));
+      *static_cast<DstT*>(it.value())= static_cast<DstT>(value);
+    }
+    if (it.length() != nullptr) {
+      *it.length()= sizeof(DstT);
+    }
+  }
+};
+
+/* Returns new codec for the column, if there is one for the combination of the column and the application buffer
+   types, and nullptr otherwise */
+BoundRCodec* createResultCodec(MADB_DescRecord* irdRec, const MYSQL_FIELD* field, SQLSMALLINT cType,
+                               const DescArrayIterator& cit);
+
 } // namespace mariadb
 #endif /* _ma_xxxxxx_h_ */
@@ -18,6 +18,7 @@
 *************************************************************************************/
 
 #include <sstream>
+#include <chrono>
 #include "ma_odbc.h"
 #include "interface/ResultSet.h"
 #include "ServerPrepareResult.h"
@@ -161,6 +162,8 @@ SQLRETURN MADB_SQLDisconnect(SQLHDBC ConnectionHandle)
     NextElement= Element->next;
     MADB_DescFree((MADB_Desc*)Element->data, FALSE);
   }
+  /* Statements prefix errors with the server version, thus they can't be reused with other connection */
+  Connection->FreePooledStmts();
 
   Connection->mariadb= nullptr;
   if (Connection->guard && !Connection->guard->isClosed())
@@ -229,10 +232,8 @@ SQLRETURN MADB_Dbc::SetAttr(SQLINTEGER Attribute, SQLPOINTER ValuePtr, SQLINTEGE
         if (EnlistInDtc) {
           return MADB_SetError(&Error, MADB_ERR_25000, nullptr, 0);
         }
-        if (mysql_autocommit(mariadb, (my_bool)(size_t)ValuePtr))
-        {
-          return MADB_SetError(&Error, MADB_ERR_HY001, mysql_error(mariadb), mysql_errno(mariadb));
-        }
+        /* The change is sent along with the next command, and only if it is actually a change */
+        guard->setAutocommit((SQLULEN)ValuePtr != SQL_AUTOCOMMIT_OFF);
       }
       AutoCommit= (SQLUINTEGER)(SQLULEN)ValuePtr;
     }
@@ -268,6 +269,7 @@ SQLRETURN MADB_Dbc::SetAttr(SQLINTEGER Attribute, SQLPOINTER ValuePtr, SQLINTEGE
       }
       if (mariadb)
       {
+        /* The change is sent along with the next command */
         guard->setSchema(CatalogName);
       }
     }
@@ -383,12 +385,9 @@ SQLRETURN MADB_Dbc::GetAttr(SQLINTEGER Attribute, SQLPOINTER ValuePtr, SQLINTEGE
                                 SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF;
     break;
   case SQL_ATTR_CONNECTION_DEAD:
-    /* ping may fail if status isn't ready, so we need to check errors */
-    if (!guard->ping())
-      *(SQLUINTEGER *)ValuePtr= (mysql_errno(mariadb) == CR_SERVER_GONE_ERROR ||
-                                 mysql_errno(mariadb) == CR_SERVER_LOST) ? SQL_CD_TRUE : SQL_CD_FALSE;
-    else
-      *(SQLUINTEGER *)ValuePtr= SQL_CD_FALSE;
+    /* Pool managers query this before every checkout, thus the server is pinged only if the connection has been idle
+       for longer than configured */
+    *(SQLUINTEGER *)ValuePtr= (guard && guard->isAlive(Dsn->PingIdleTime)) ? SQL_CD_FALSE : SQL_CD_TRUE;
     break;
   case SQL_ATTR_CURRENT_CATALOG:
   {
@@ -483,8 +482,9 @@ SQLRETURN MADB_DbcFree(MADB_Dbc *Connection)
   MDBUG_C_PRINT(Connection, "%sMADB_DbcFree", "\t->");
   MDBUG_C_DUMP(Connection, Connection, 0x);
 
-  Connection->Environment->forgetConnection(Connection->ListItem);
+  Connection->Environment->forgetConnection(Connection, Connection->ListItem);
 
+  Connection->FreePooledStmts();
   MADB_FREE(Connection->CatalogName);
   CloseClientCharset(&Connection->Charset);
   MADB_DSN_Free(Connection->Dsn);
@@ -586,6 +586,28 @@ static void MADB_AddInitCommand(MYSQL* mariadb, std::ostringstream &InitCmd, boo
   }
 }
 
+/* {{{ MADB_IsLocalServer
+       Named pipe, unix socket or loopback address - compression of the traffic would only cost CPU on both ends
+*/
+static bool MADB_IsLocalServer(MADB_Dsn *Dsn)
+{
+  if (Dsn->IsNamedPipe)
+  {
+    return true;
+  }
+#ifndef _WIN32
+  if (Dsn->Socket)
+  {
+    return true;
+  }
+#endif
+  const char *Host= Dsn->ServerName ? ltrim(Dsn->ServerName) : "";
+
+  return *Host == '\0' || _stricmp(Host, "localhost") == 0 || strncmp(Host, "127.", 4) == 0 ||
+    strcmp(Host, "::1") == 0 || strcmp(Host, "[::1]") == 0;
+}
+/* }}} */
+
 /* {{{ MADB_Tokenize
 */
 std::size_t MADB_Tokenize(std::vector<bytes>& tokens, const char* cstring, const char *separator)
@@ -926,27 +948,11 @@ SQLRETURN MADB_Dbc::ConnectDB(MADB_Dsn *Dsn)
   {
     MADB_AddInitCommand(mariadb, InitCmd, DSN_OPTION(this, MADB_OPT_FLAG_MULTI_STATEMENTS), Dsn->InitCommand);
   }
-  /* Turn sql_auto_is_null behavior off.
-    For more details see: http://bugs.mysql.com/bug.php?id=47005 */
-  MADB_AddInitCommand(mariadb, InitCmd, DSN_OPTION(this, MADB_OPT_FLAG_MULTI_STATEMENTS), "SET SESSION SQL_AUTO_IS_NULL=0");
-
-  /* set autocommit behavior */
-  if (AutoCommit != 0)
-  {
-    MADB_AddInitCommand(mariadb, InitCmd, DSN_OPTION(this, MADB_OPT_FLAG_MULTI_STATEMENTS), "SET autocommit=1");
-  }
-  else
-  {
-    MADB_AddInitCommand(mariadb, InitCmd, DSN_OPTION(this, MADB_OPT_FLAG_MULTI_STATEMENTS), "SET autocommit=0");
-  }
-
-  /* Set isolation level */
-  if (TxnIsolation)
-  {
-    SQLString query("SET SESSION TRANSACTION ISOLATION LEVEL ");
-    MADB_AddInitCommand(mariadb, InitCmd, DSN_OPTION(this, MADB_OPT_FLAG_MULTI_STATEMENTS),
-      addTxIsolationName2Query(query, static_cast<enum IsolationLevel>(TxnIsolation)).c_str());
-  }
+  /* Turn sql_auto_is_null behavior off(for more details see: http://bugs.mysql.com/bug.php?id=47005), and set autocommit
+     behavior. Without multistatements every init command costs a roundtrip, thus driver's settings go in one statement.
+     Isolation level is set with the post-connect session setup in Protocol, since the variable name depends on the server */
+  MADB_AddInitCommand(mariadb, InitCmd, DSN_OPTION(this, MADB_OPT_FLAG_MULTI_STATEMENTS),
+    AutoCommit != 0 ? "SET SESSION SQL_AUTO_IS_NULL=0,autocommit=1" : "SET SESSION SQL_AUTO_IS_NULL=0,autocommit=0");
 
   /* If multistmts allowed - we've put all queries to run in InitCmd. Now need to set it to MYSQL_INIT_COMMAND option */
   if (DSN_OPTION(this, MADB_OPT_FLAG_MULTI_STATEMENTS))
@@ -966,7 +972,9 @@ SQLRETURN MADB_Dbc::ConnectDB(MADB_Dsn *Dsn)
 
   if (DSN_OPTION(this, MADB_OPT_FLAG_FOUND_ROWS))
     client_flags|= CLIENT_FOUND_ROWS;
-  if (DSN_OPTION(this, MADB_OPT_FLAG_COMPRESSED_PROTO))
+  /* Connector/C compresses zlib packets only if they are not too short, and sends them as is, if compression doesn't
+     make them smaller */
+  if (DSN_OPTION(this, MADB_OPT_FLAG_COMPRESSED_PROTO) && !(Dsn->CompressRemoteOnly && MADB_IsLocalServer(Dsn)))
     client_flags|= CLIENT_COMPRESS;
   
   if (MADB_SetAttributes(mariadb, Dsn->Attributes))
@@ -991,12 +999,14 @@ SQLRETURN MADB_Dbc::ConnectDB(MADB_Dsn *Dsn)
 
   // Protocol and encryption settings go in CoreConnect()
   /////---------------------- Connecting -------------------------/////
+  auto connectStart= std::chrono::steady_clock::now();
   if (!SQL_SUCCEEDED(CoreConnect(mariadb, Dsn, &Error, client_flags)))
   {
     mysql_close(mariadb);
     mariadb= nullptr;
     return Error.ReturnValue;
   }
+  auto handshakeEnd= std::chrono::steady_clock::now();
   
   /* I guess it is better not to do that at all. Besides SQL_ATTR_PACKET_SIZE is actually not for max packet size */
   if (PacketSize)
@@ -1008,19 +1018,34 @@ SQLRETURN MADB_Dbc::ConnectDB(MADB_Dsn *Dsn)
 
   MADB_SetCapabilities(this, mysql_get_server_version(mariadb), mysql_get_server_name(mariadb));
   {
-    Cache<std::string, ServerPrepareResult> *psCache= nullptr;
+    Cache<PsCacheKey, ServerPrepareResult> *psCache= nullptr;
     if (Dsn->PsCacheSize > 0 && Dsn->PsCacheMaxKeyLen > 0)
     {
       psCache= new odbc::PsCache(Dsn->PsCacheSize, Dsn->PsCacheMaxKeyLen);
     }
     else
     {
-      psCache= new Cache<std::string, ServerPrepareResult>();
+      psCache= new Cache<PsCacheKey, ServerPrepareResult>();
     }
     const char* defaultSchema= getDefaultSchema(Dsn);
-    guard.reset(new Protocol(mariadb, defaultSchema ? defaultSchema : emptyStr, psCache, MADB_GetTxIsolationVarName(this),
-      TxnIsolation ? static_cast<enum IsolationLevel>(TxnIsolation) : TRANSACTION_REPEATABLE_READ));
+    try
+    {
+      guard.reset(new Protocol(mariadb, defaultSchema ? defaultSchema : emptyStr, psCache, MADB_GetTxIsolationVarName(this),
+        static_cast<enum IsolationLevel>(TxnIsolation)));
+    }
+    catch (SQLException &e)
+    {
+      /* Protocol has taken ownership of the handle, and it's closed already */
+      mariadb= nullptr;
+      return MADB_FromException(Error, e);
+    }
+    guard->setPsCacheWarmup(Dsn->PsCacheWarmup);
+    guard->setResultCache(static_cast<std::size_t>(Dsn->ResultCacheSize)*1024, Dsn->ResultCacheTtl);
   }
+  ConnectTime.Handshake= std::chrono::duration_cast<std::chrono::microseconds>(handshakeEnd - connectStart).count();
+  ConnectTime.SessionSetup= std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handshakeEnd).count();
+  MDBUG_C_PRINT(this, "Connect time(us): handshake %llu(TLS: %s), session setup %llu", (unsigned long long)ConnectTime.Handshake,
+    mysql_get_ssl_cipher(mariadb) ? mysql_get_ssl_cipher(mariadb) : "none", (unsigned long long)ConnectTime.SessionSetup);
 
   if (Error.ReturnValue == SQL_ERROR && mariadb)
   {
@@ -2128,6 +2153,23 @@ MADB_Dbc::MADB_Dbc(MADB_Env* Env)
   std::memset(&ListItem, 0, sizeof(MADB_List));
 }
 
+/* {{{ MADB_Dbc::FreePooledStmts */
+void MADB_Dbc::FreePooledStmts()
+{
+  std::lock_guard<std::mutex> localScopeLock(ListsCs);
+  for (auto& Shell : FreeStmts)
+  {
+    MADB_DescFree(Shell.IApd, FALSE);
+    MADB_DescFree(Shell.IArd, FALSE);
+    MADB_DescFree(Shell.IIpd, FALSE);
+    MADB_DescFree(Shell.IIrd, FALSE);
+    /* The statement object has been destructed already, only its memory is left */
+    ::operator delete(Shell.Memory);
+  }
+  FreeStmts.clear();
+}
+/* }}} */
+
 /* {{{ MADB_DbcInit() */
 MADB_Dbc* MADB_DbcInit(MADB_Env* Env)
 {
@@ -47,6 +47,17 @@ struct MADB_Dbc
                                   codepage */
   MADB_List* Stmts= nullptr;
   MADB_List* Descrs= nullptr;
+  /* Dropped statements kept for reuse by next statement allocation - the memory of the statement object and its
+     implicit descriptors, that have been reset. Guarded by ListsCs */
+  struct StmtShell
+  {
+    void*      Memory;
+    MADB_Desc* IApd;
+    MADB_Desc* IArd;
+    MADB_Desc* IIpd;
+    MADB_Desc* IIrd;
+  };
+  std::vector<StmtShell> FreeStmts;
   /* Attributes */
   char*      CatalogName= nullptr; /* Schema name set via SQLSetConnectAttr - it can be set before connection, thus we need it to have here */
   HWND       QuietMode= nullptr;
@@ -74,6 +85,12 @@ struct MADB_Dbc
 
   bool IsAnsi= false;
   bool IsMySQL=false;
+  /* Duration of connect phases in microseconds, for diagnostics. C/C does not expose TCP connect, TLS and authentication
+     separately - they all are in the handshake together with init commands */
+  struct {
+    uint64_t Handshake= 0;
+    uint64_t SessionSetup= 0;
+  } ConnectTime;
 
   MADB_Dbc(MADB_Env* Env);
   SQLRETURN EndTran(SQLSMALLINT CompletionType);
@@ -87,6 +104,7 @@ struct MADB_Dbc
                           SQLULEN BufferLength, SQLSMALLINT *StringLength2Ptr, SQLUSMALLINT DriverCompletion);
   
   bool CheckConnection();
+  void FreePooledStmts();
 private:
   SQLRETURN GetCurrentDB(SQLPOINTER CurrentDB, SQLINTEGER CurrentDBLength, SQLSMALLINT *StringLengthPtr, bool isWChar);
   const char* getDefaultSchema(MADB_Dsn *Dsn);
@@ -108,16 +108,12 @@ MADB_Desc *MADB_DescInit(MADB_Dbc *Dbc,enum enum_madb_desc_type DescType, my_boo
 }
 /* }}} */
 
-/* {{{ MADB_DescFree */
-SQLRETURN MADB_DescFree(MADB_Desc *Desc, my_bool RecordsOnly)
+/* {{{ MADB_DescFreeRecordsData */
+static void MADB_DescFreeRecordsData(MADB_Desc *Desc)
 {
   MADB_DescRecord *Record;
   unsigned int i;
 
-  if (!Desc)
-    return SQL_ERROR;
-
-  /* We need to free internal pointers first */
   for (i=0; i < Desc->Records.elements; i++)
   {
     Record= ((MADB_DescRecord *)Desc->Records.buffer) + i;
@@ -139,6 +135,33 @@ SQLRETURN MADB_DescFree(MADB_Desc *Desc, my_bool RecordsOnly)
       MADB_FREE(Record->TypeName);
     }
   }
+}
+/* }}} */
+
+/* {{{ MADB_DescReset
+       Brings implicit descriptor to the state it has right after MADB_DescInit, but keeps the memory allocated for the
+       records, so the descriptor can be reused by other statement */
+void MADB_DescReset(MADB_Desc *Desc)
+{
+  MADB_DescFreeRecordsData(Desc);
+  Desc->Records.elements= 0;
+  memset(&Desc->Header, 0, sizeof(MADB_Header));
+  memset(&Desc->Fields, 0, sizeof(Desc->Fields));
+  Desc->Header.ArraySize= 1;
+  MADB_CLEAR_ERROR(&Desc->Error);
+}
+/* }}} */
+
+/* {{{ MADB_DescFree */
+SQLRETURN MADB_DescFree(MADB_Desc *Desc, my_bool RecordsOnly)
+{
+  unsigned int i;
+
+  if (!Desc)
+    return SQL_ERROR;
+
+  /* We need to free internal pointers first */
+  MADB_DescFreeRecordsData(Desc);
   MADB_DeleteDynamic(&Desc->Records);
 
 Desc->Header.Count= 0;
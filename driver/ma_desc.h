@@ -33,6 +33,7 @@ MADB_DescRecord *MADB_DescGetInternalRecord(MADB_Desc *Desc, SQLSMALLINT RecordN
 
 MADB_Desc *MADB_DescInit(MADB_Dbc *Dbc, enum enum_madb_desc_type DescType, my_bool isExternal);
 SQLRETURN MADB_DescFree(MADB_Desc *Desc, my_bool RecordsOnly);
+void      MADB_DescReset(MADB_Desc *Desc);
 SQLRETURN MADB_DescGetField(SQLHDESC DescriptorHandle,
                             SQLSMALLINT RecNumber,
                             SQLSMALLINT FieldIdentifier,
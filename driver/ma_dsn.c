@@ -99,6 +99,16 @@ MADB_DsnKey DsnKeys[]=
   {"PCALLBACK",      offsetof(MADB_Dsn, ParamCallbacks),    DSN_TYPE_BOOL,   0, 0},
   {"RCALLBACK",      offsetof(MADB_Dsn, ResultCallbacks),   DSN_TYPE_BOOL,   0, 0}, /* 50 */
   {"NOBIGINT",       offsetof(MADB_Dsn, NoBigint),          DSN_TYPE_OPTION, MADB_OPT_FLAG_NO_BIGINT, 0},
+  {"FETCHTHREADS",   offsetof(MADB_Dsn, FetchThreads),      DSN_TYPE_INT,    0, 0},
+  {"PINGIDLE",       offsetof(MADB_Dsn, PingIdleTime),      DSN_TYPE_INT,    0, 0},
+  {"PSWARMUP",       offsetof(MADB_Dsn, PsCacheWarmup),     DSN_TYPE_INT,    0, 0},
+  {"CURSORFETCH",    offsetof(MADB_Dsn, CursorFetch),       DSN_TYPE_INT,    0, 0},
+  {"SPILLMEM",       offsetof(MADB_Dsn, SpillMemory),       DSN_TYPE_INT,    0, 0},
+  {"RESULTCACHE",    offsetof(MADB_Dsn, ResultCacheSize),   DSN_TYPE_INT,    0, 0},
+  {"RESULTCACHETTL", offsetof(MADB_Dsn, ResultCacheTtl),    DSN_TYPE_INT,    0, 0},
+  {"COMPRESS",       offsetof(MADB_Dsn, Compress),          DSN_TYPE_OPTION, MADB_OPT_FLAG_COMPRESSED_PROTO, 0},
+  {"COMPRESSREMOTE", offsetof(MADB_Dsn, CompressRemoteOnly),DSN_TYPE_BOOL,   0, 0},
+  {"PREFETCHSTOPKB", offsetof(MADB_Dsn, PrefetchStopKb),    DSN_TYPE_INT,    0, 0},
 
   /* Aliases. Here offset is index of aliased key */
   {"SERVERNAME",     DSNKEY_SERVER_INDEX,                   DSN_TYPE_STRING, 0, 1},
@@ -164,6 +174,7 @@ MADB_Dsn *MADB_DSN_Init(MADB_Dsn *Dsn2init)
     Dsn->PsCacheSize= 250;
     Dsn->PsCacheMaxKeyLen= 2112;
     Dsn->ParamCallbacks= '\1';
+    Dsn->ResultCacheTtl= 5;
   }
   return Dsn;
 }
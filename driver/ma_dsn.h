@@ -147,6 +147,15 @@ typedef struct st_madb_dsn
   unsigned int WriteTimeout;
   unsigned int PsCacheSize;
   unsigned int PsCacheMaxKeyLen;
+  unsigned int FetchThreads; /* >1 - number of threads to convert the rowset of a cached result with */
+  unsigned int PsCacheWarmup; /* number of most recently used cached statements to re-prepare after connection reset */
+  unsigned int PingIdleTime; /* ms of idleness after which SQL_ATTR_CONNECTION_DEAD pings the server. 0 - always ping */
+  unsigned int CursorFetch; /* >0 - forward-only results are read via server-side cursor, in batches of this number of rows */
+  unsigned int SpillMemory; /* >0 - MB of memory a stored result may take, rows beyond that go to a temporary file */
+  unsigned int ResultCacheSize; /* >0 - KB of memory results of repeated read-only queries may be cached in */
+  unsigned int ResultCacheTtl; /* seconds a cached result may be served for. 0 - results are not cached */
+  unsigned int PrefetchStopKb; /* >0 - next results of a multi-result query are read in the background, till they take this
+                                 many KB or more. Soft threshold - checked between results, a single result may exceed it */
   my_bool StreamResult; /* bool so far, but in future should be changed to uint */
   my_bool Reconnect;
   my_bool MultiStatements;
@@ -168,6 +177,8 @@ typedef struct st_madb_dsn
   my_bool ParamCallbacks;
   my_bool ResultCallbacks;
   my_bool NoBigint;
+  my_bool Compress;
+  my_bool CompressRemoteOnly; /* Compression is not requested if the server is on the same host */
   //TODO: this has to be removed
   my_bool TraceFile;
 } MADB_Dsn;
@@ -17,6 +17,7 @@
    51 Franklin St., Fifth Floor, Boston, MA 02110, USA
 *************************************************************************************/
 #include "ma_odbc.h"
+#include "class/WorkerPool.h"
 
 Client_Charset utf8= { CP_UTF8, NULL };
 MARIADB_CHARSET_INFO* DmUnicodeCs= NULL;;
@@ -170,7 +171,7 @@ SQLRETURN MADB_EnvSetAttr(MADB_Env* Env, SQLINTEGER Attribute, SQLPOINTER ValueP
 
   switch (Attribute) {
    case SQL_ATTR_ODBC_VERSION:
-    if (!Env->Dbcs.empty())
+    if (Env->hasConnections())
     {
       return MADB_SetError(&Env->Error, MADB_ERR_HYC00, NULL, 0);
     }
@@ -216,15 +217,54 @@ SQLRETURN MADB_EnvGetAttr(MADB_Env *Env, SQLINTEGER Attribute, SQLPOINTER ValueP
 }
  /* }}} */
 
+MADB_Env::DbcShard& MADB_Env::getShard(const MADB_Dbc* conn)
+{
+  /* Low bits of the address are the same for all handles due to the alignment */
+  std::size_t key= reinterpret_cast<std::uintptr_t>(conn) >> 6;
+  return DbcShards[(key ^ (key >> 8)) % DbcShardCount];
+}
+
+
 MADB_Env::ListIterator MADB_Env::addConnection(MADB_Dbc* conn)
 {
-  std::lock_guard<std::mutex> localScopeLock(cs);
-  return Dbcs.insert(Dbcs.begin(), conn);
+  DbcShard& shard= getShard(conn);
+  std::lock_guard<std::mutex> localScopeLock(shard.cs);
+  DbcCount.fetch_add(1, std::memory_order_release);
+  return shard.Dbcs.insert(shard.Dbcs.begin(), conn);
 }
 
 
-void MADB_Env::forgetConnection(MADB_Env::ListIterator& it)
+void MADB_Env::forgetConnection(MADB_Dbc* conn, MADB_Env::ListIterator& it)
+{
+  DbcShard& shard= getShard(conn);
+  std::lock_guard<std::mutex> localScopeLock(shard.cs);
+  shard.Dbcs.erase(it);
+  DbcCount.fetch_sub(1, std::memory_order_release);
+}
+
+/* Returns the snapshot of registered connections, so the caller does not hold any registry lock while working with them */
+std::vector<MADB_Dbc*> MADB_Env::getConnections()
+{
+  std::vector<MADB_Dbc*> result;
+  result.reserve(DbcCount.load(std::memory_order_acquire));
+
+  for (auto& shard : DbcShards)
+  {
+    std::lock_guard<std::mutex> localScopeLock(shard.cs);
+    result.insert(result.end(), shard.Dbcs.begin(), shard.Dbcs.end());
+  }
+  return result;
+}
+
+
+/* The pool is created on first demand. It is owned by the environment(and not by a static object), so its threads are
+   joined in SQLFreeHandle, and not at the library unload */
+mariadb::WorkerPool& MADB_Env::getWorkerPool()
 {
   std::lock_guard<std::mutex> localScopeLock(cs);
-  Dbcs.erase(it);
+  if (!Workers)
+  {
+    Workers.reset(new mariadb::WorkerPool());
+  }
+  return *Workers;
 }
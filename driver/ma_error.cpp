@@ -20,6 +20,7 @@
 #include "interface/PreparedStatement.h"
 #include "interface/ResultSet.h"
 #include "class/ResultSetMetaData.h"
+#include "class/Protocol.h"
 
 extern Client_Charset utf8;
 
@@ -196,6 +197,9 @@ SQLRETURN MADB_SetNativeError(MADB_Error *Error, SQLSMALLINT HandleType, void *P
   }
 
   Error->ReturnValue= SQL_ERROR;
+  Error->RowNumber= 0;
+  Error->ColumnNumber= 0;
+  Error->ExtraRecords= 0;
   if (Errormsg)
   {
     strcpy_s(Error->SqlErrorMsg + Error->PrefixLen, SQL_MAX_MESSAGE_LENGTH + 1 - Error->PrefixLen, Errormsg);
@@ -219,6 +223,9 @@ SQLRETURN MADB_SetError(MADB_Error  *Error,
   unsigned int ErrorCode= SqlErrorCode;
 
   Error->ErrorNum= 0;
+  Error->RowNumber= 0;
+  Error->ColumnNumber= 0;
+  Error->ExtraRecords= 0;
   if ((NativeError == 2013 || NativeError == 2006 || NativeError == 1160) && SqlErrorCode == MADB_ERR_HY000)
     ErrorCode= MADB_ERR_08S01;
 
@@ -248,6 +255,10 @@ SQLRETURN MADB_CopyError(MADB_Error *ErrorTo, MADB_Error *ErrorFrom)
   ErrorTo->NativeError= ErrorFrom->NativeError;
   ErrorTo->ReturnValue= ErrorFrom->ReturnValue;
   ErrorTo->PrefixLen=   ErrorFrom->PrefixLen;
+  ErrorTo->RowNumber=   ErrorFrom->RowNumber;
+  ErrorTo->ColumnNumber= ErrorFrom->ColumnNumber;
+  /* Following records stay with the handle they belong to */
+  ErrorTo->ExtraRecords= 0;
   strcpy_s(ErrorTo->SqlState, SQLSTATE_LENGTH + 1, ErrorFrom->SqlState);
   strcpy_s(ErrorTo->SqlErrorMsg, SQL_MAX_MESSAGE_LENGTH + 1, ErrorFrom->SqlErrorMsg);
   return ErrorTo->ReturnValue;
@@ -323,9 +334,6 @@ SQLRETURN MADB_GetDiagField(SQLSMALLINT HandleType, SQLHANDLE Handle,
   Error.PrefixLen= 0;
   MADB_CLEAR_ERROR(&Error);
 
-  if (RecNumber > 1)
-    return SQL_NO_DATA;
-
   switch(HandleType) {
   case SQL_HANDLE_DBC:
     Dbc= (MADB_Dbc *)Handle;
@@ -347,6 +355,13 @@ SQLRETURN MADB_GetDiagField(SQLSMALLINT HandleType, SQLHANDLE Handle,
      return SQL_INVALID_HANDLE;
   }
 
+  if (RecNumber > 1)
+  {
+    /* Only statements can have more than one record */
+    if (Stmt == NULL || (Err= Stmt->DiagRecord(RecNumber)) == NULL)
+      return SQL_NO_DATA;
+  }
+
   switch(DiagIdentifier) {
   case SQL_DIAG_CURSOR_ROW_COUNT:
     if (!Stmt)
@@ -364,7 +379,7 @@ SQLRETURN MADB_GetDiagField(SQLSMALLINT HandleType, SQLHANDLE Handle,
     *(SQLINTEGER *)DiagInfoPtr= 0;
     break;
   case SQL_DIAG_NUMBER:
-    *(SQLINTEGER *)DiagInfoPtr= 1;
+    *(SQLINTEGER *)DiagInfoPtr= 1 + Err->ExtraRecords;
     break;
   case SQL_DIAG_RETURNCODE:
     *(SQLRETURN *)DiagInfoPtr= Err->ReturnValue;
@@ -373,7 +388,16 @@ SQLRETURN MADB_GetDiagField(SQLSMALLINT HandleType, SQLHANDLE Handle,
     if (HandleType != SQL_HANDLE_STMT ||
         !Stmt)
       return SQL_ERROR;
-    *(SQLLEN *)DiagInfoPtr= (Stmt->stmt) ? (SQLLEN)Stmt->stmt->getUpdateCount() : 0;
+    if (Stmt->stmt)
+    {
+      /* Next results may be being read in the background, and update counts are added to the same list */
+      std::lock_guard<std::mutex> localScopeLock(Stmt->Connection->guard->getLock());
+      *(SQLLEN *)DiagInfoPtr= (SQLLEN)Stmt->stmt->getUpdateCount();
+    }
+    else
+    {
+      *(SQLLEN *)DiagInfoPtr= 0;
+    }
     break;
   case SQL_DIAG_CLASS_ORIGIN:
     Length= MADB_SetString(isWChar ?  &utf8 : 0, DiagInfoPtr,  isWChar ? BufferLength / sizeof(SQLWCHAR) : BufferLength,
@@ -382,7 +406,7 @@ SQLRETURN MADB_GetDiagField(SQLSMALLINT HandleType, SQLHANDLE Handle,
       *StringLengthPtr= (SQLSMALLINT)Length;
     break;
   case SQL_DIAG_COLUMN_NUMBER:
-    *(SQLINTEGER *)DiagInfoPtr= SQL_COLUMN_NUMBER_UNKNOWN;
+    *(SQLINTEGER *)DiagInfoPtr= Err->ColumnNumber > 0 ? Err->ColumnNumber : SQL_COLUMN_NUMBER_UNKNOWN;
     break;
   case SQL_DIAG_CONNECTION_NAME:
     /* MariaDB ODBC Driver always returns an empty string */
@@ -403,7 +427,7 @@ SQLRETURN MADB_GetDiagField(SQLSMALLINT HandleType, SQLHANDLE Handle,
      if (HandleType != SQL_HANDLE_STMT ||
          RecNumber < 1)
        return SQL_ERROR;
-      *(SQLLEN*)DiagInfoPtr= SQL_ROW_NUMBER_UNKNOWN;
+      *(SQLLEN*)DiagInfoPtr= Err->RowNumber > 0 ? Err->RowNumber : SQL_ROW_NUMBER_UNKNOWN;
     break;
   case SQL_DIAG_SERVER_NAME:
     {
@@ -457,6 +481,9 @@ SQLRETURN MADB_FromException(MADB_Error &Err, SQLException& e)
   }
 
   Err.ReturnValue= SQL_ERROR;
+  Err.RowNumber= 0;
+  Err.ColumnNumber= 0;
+  Err.ExtraRecords= 0;
   strcpy_s(Err.SqlErrorMsg + Err.PrefixLen, SQL_MAX_MESSAGE_LENGTH + 1 - Err.PrefixLen, e.what());
 
   strcpy_s(Err.SqlState, SQLSTATE_LENGTH + 1, SqlState);
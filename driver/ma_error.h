@@ -168,6 +168,9 @@ SQLRETURN MADB_FromException(MADB_Error& Err, SQLException &e);
   (a)->NativeError= 0;\
   (a)->ReturnValue= SQL_SUCCESS;\
   (a)->ErrorNum= 0; \
+  (a)->RowNumber= 0; \
+  (a)->ColumnNumber= 0; \
+  (a)->ExtraRecords= 0; \
 } while (0)
 
 #define MADB_CHECK_ATTRIBUTE(Handle, Attr, ValidAttrs)\
@@ -707,7 +707,7 @@ void MADB_CopyMadbTimeToOdbcTs(MYSQL_TIME *Src, SQL_TIMESTAMP_STRUCT *Dst)
   Dst->fraction=    Src->second_part*1000;
 }
 
-SQLRETURN MADB_CopyMadbTimestamp(MADB_Stmt *Stmt, MYSQL_TIME *tm, SQLPOINTER DataPtr, SQLLEN *Length, SQLLEN *Ind,
+SQLRETURN MADB_CopyMadbTimestamp(MADB_Error *Error, MYSQL_TIME *tm, SQLPOINTER DataPtr, SQLLEN *Length, SQLLEN *Ind,
                                  SQLSMALLINT CType, SQLSMALLINT SqlType)
 {
   SQLLEN Dummy;
@@ -727,14 +727,19 @@ SQLRETURN MADB_CopyMadbTimestamp(MADB_Stmt *Stmt, MYSQL_TIME *tm, SQLPOINTER Dat
         if (SqlType == SQL_TIME || SqlType == SQL_TYPE_TIME)
         {
           time_t sec_time;
-          struct tm * cur_tm;
+          struct tm cur_tm;
 
+          /* Rows can be converted in parallel, thus using reentrant version of localtime */
           sec_time= time(NULL);
-          cur_tm= localtime(&sec_time);
+#ifdef _WIN32
+          localtime_s(&cur_tm, &sec_time);
+#else
+          localtime_r(&sec_time, &cur_tm);
+#endif
 
-          ts->year= 1900 + cur_tm->tm_year;
-          ts->month= cur_tm->tm_mon + 1;
-          ts->day= cur_tm->tm_mday;
+          ts->year= 1900 + cur_tm.tm_year;
+          ts->month= cur_tm.tm_mon + 1;
+          ts->day= cur_tm.tm_mday;
           ts->fraction= 0;
         }
         else
@@ -756,7 +761,7 @@ SQLRETURN MADB_CopyMadbTimestamp(MADB_Stmt *Stmt, MYSQL_TIME *tm, SQLPOINTER Dat
           }
           else
           {
-            return MADB_SetError(&Stmt->Error, MADB_ERR_22002, NULL, 0);
+            return MADB_SetError(Error, MADB_ERR_22002, NULL, 0);
           }
           break;
         }
@@ -774,7 +779,7 @@ SQLRETURN MADB_CopyMadbTimestamp(MADB_Stmt *Stmt, MYSQL_TIME *tm, SQLPOINTER Dat
         /* tm(buffer from MYSQL_BIND) can be NULL. And that happens if ts(app's buffer) is null */
         if (!VALID_TIME(tm))
         {
-          return MADB_SetError(&Stmt->Error, MADB_ERR_22007, NULL, 0);
+          return MADB_SetError(Error, MADB_ERR_22007, NULL, 0);
         }
 
         ts->hour= tm->hour;
@@ -785,7 +790,7 @@ SQLRETURN MADB_CopyMadbTimestamp(MADB_Stmt *Stmt, MYSQL_TIME *tm, SQLPOINTER Dat
 
         if (tm->second_part)
         {
-          return MADB_SetError(&Stmt->Error, MADB_ERR_01S07, NULL, 0);
+          return MADB_SetError(Error, MADB_ERR_01S07, NULL, 0);
         }
       }
     }
@@ -808,7 +813,7 @@ SQLRETURN MADB_CopyMadbTimestamp(MADB_Stmt *Stmt, MYSQL_TIME *tm, SQLPOINTER Dat
           }
           else
           {
-            return MADB_SetError(&Stmt->Error, MADB_ERR_22002, NULL, 0);
+            return MADB_SetError(Error, MADB_ERR_22002, NULL, 0);
           }
           break;
         }
@@ -892,206 +897,345 @@ void MADB_NumericInit(SQL_NUMERIC_STRUCT *number, MADB_DescRecord *Ard)
   memset(number->val, 0, sizeof(number->val));
 }
 
-/* {{{ MADB_CharToSQLNumeric */
-int MADB_CharToSQLNumeric(char *buffer, MADB_Desc *Ard, MADB_DescRecord *ArdRecord, SQL_NUMERIC_STRUCT *dst_buffer, unsigned long RowNumber)
+/* {{{ MADB_Uint128 */
+/* Unsigned 128-bit integer with only operations needed for SQL_NUMERIC_STRUCT conversions. Uses compiler's 128-bit
+   type where there is one, and 32-bit limbs otherwise. Values are taken and stored as 16 little-endian bytes, as in
+   SQL_NUMERIC_STRUCT::val, independently of the host byte order */
+class MADB_Uint128
 {
-  char *p;
-  SQL_NUMERIC_STRUCT *number= dst_buffer != NULL ? dst_buffer :
-    (SQL_NUMERIC_STRUCT *)GetBindOffset(Ard->Header, ArdRecord->DataPtr, RowNumber, ArdRecord->OctetLength);
-  int ret= 0;
-
-  if (!buffer || !number)
-  {
-    return ret;
-  }
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 v;
+#else
+  uint32_t limb[4]; /* least significant first */
+#endif
 
-  p= trim(buffer);
-  MADB_NumericInit(number, ArdRecord);
+public:
+  MADB_Uint128() { clear(); }
 
-  /* Determining the sign of the number. From now on we dean with unsigned number */
-  if (!(number->sign= (*p == '-') ? 0 : 1))
+  void clear()
   {
-    p++;
+#ifdef __SIZEOF_INT128__
+    v= 0;
+#else
+    limb[0]= limb[1]= limb[2]= limb[3]= 0;
+#endif
   }
-  /* Empty string - nothing to do*/
-  if (!*p)
+
+  void fromBytes(const SQLCHAR *Val)
   {
-    return ret;
+    clear();
+    for (int i= SQL_MAX_NUMERIC_LEN - 1; i >= 0; --i)
+    {
+#ifdef __SIZEOF_INT128__
+      v= (v << 8) | Val[i];
+#else
+      limb[i / 4]|= static_cast<uint32_t>(Val[i]) << (8 * (i % 4));
+#endif
+    }
   }
 
-  if (number->precision == 0)
+  void toBytes(SQLCHAR *Val) const
   {
-    number->precision= MADB_DEFAULT_PRECISION;
+    for (int i= 0; i < SQL_MAX_NUMERIC_LEN; ++i)
+    {
+#ifdef __SIZEOF_INT128__
+      Val[i]= static_cast<SQLCHAR>(v >> (8 * i));
+#else
+      Val[i]= static_cast<SQLCHAR>(limb[i / 4] >> (8 * (i % 4)));
+#endif
+    }
   }
 
-  /* Skipping leading zeroes */
-  while (*p == '0')
+  bool isZero() const
   {
-    ++p;
+#ifdef __SIZEOF_INT128__
+    return v == 0;
+#else
+    return (limb[0] | limb[1] | limb[2] | limb[3]) == 0;
+#endif
   }
-  if (*p)
+
+  /* this= this*Mul + Add. Returns false if the result doesn't fit, and then the value is undefined */
+  bool mulAdd(uint32_t Mul, uint32_t Add)
   {
-    int i;
-    unsigned int bit, hval, tv, dig, sta, olen;
-    int leading_zeros= 0;
-    char *dot= strchr(p, '.');
-    char digits[100];
-    unsigned short digits_count= 0; /* integer part digits count*/
-
-    if (dot == NULL)
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 lo= static_cast<unsigned __int128>(static_cast<uint64_t>(v)) * Mul + Add,
+                      hi= (v >> 64) * Mul + (lo >> 64);
+    if (hi >> 64)
     {
-      char* end= p;
-      while (*end && isdigit(0x000000ff & *end))
-        ++end;
-
-      digits_count= (unsigned short)(end - p);
+      return false;
     }
-    else
+    v= (hi << 64) | static_cast<uint64_t>(lo);
+#else
+    uint64_t carry= Add;
+    for (int i= 0; i < 4; ++i)
     {
-      digits_count= (unsigned short)(dot - p);
+      carry+= static_cast<uint64_t>(limb[i]) * Mul;
+      limb[i]= static_cast<uint32_t>(carry);
+      carry>>= 32;
     }
-    /* Overflow checks */
-    if (digits_count > MADB_DEFAULT_PRECISION + 1 ) /* 16 bytes of FF make up 39 digits number */
+    if (carry != 0)
     {
-      return MADB_ERR_22003;
+      return false;
     }
-    if (number->precision > 0 &&  digits_count > number->precision)
+#endif
+    return true;
+  }
+
+  /* this= this/Div. Returns the remainder */
+  uint32_t divMod(uint32_t Div)
+  {
+#ifdef __SIZEOF_INT128__
+    /* Most of real values fit in 64 bits, and then there is no need in the 128-bit division */
+    if ((v >> 64) == 0)
     {
-      /* if scale is negative, and we have just enough zeroes at the end - we are fine, there is no overflow */
-      if (number->scale < 0 && (number->precision - number->scale) >= digits_count)
-      {
-        /* Checking that all digits past presision are '0'. Otherwise - overflow */
-        for (i= digits_count - number->precision; i > 0; --i)
-        {
-          if (*(p + digits_count - i) != '0')
-          {
-            return MADB_ERR_22003;
-          }
-        }
-      }
-      else
-      {
-        return MADB_ERR_22003;
-      }
+      uint64_t lo= static_cast<uint64_t>(v);
+      v= lo / Div;
+      return static_cast<uint32_t>(lo % Div);
     }
+    uint32_t rem= static_cast<uint32_t>(v % Div);
+    v/= Div;
+    return rem;
+#else
+    uint64_t rem= 0;
+    for (int i= 3; i >= 0; --i)
+    {
+      uint64_t cur= (rem << 32) | limb[i];
+      limb[i]= static_cast<uint32_t>(cur / Div);
+      rem= cur % Div;
+    }
+    return static_cast<uint32_t>(rem);
+#endif
+  }
+};
+/* }}} */
 
-    memcpy(digits, p, digits_count);
+static const uint32_t MADB_Pow10[]= {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+/* Appends decimal digits to the 128-bit value. Digits are accumulated in 32-bit chunks of 9, and only full chunks
+   are multiplied into the 128-bit value */
+class MADB_DigitsAccumulator
+{
+  MADB_Uint128 Value;
+  uint32_t     Chunk= 0;
+  unsigned int ChunkDigits= 0;
+  bool         Overflow= false;
 
-    if (dot && number->scale > 0)
+  void flush()
+  {
+    if (ChunkDigits > 0 && !Value.mulAdd(MADB_Pow10[ChunkDigits], Chunk))
     {
-      short digits_total= 0,       /* fractional part total digits */
-            digits_significant= 0; /* fractional part significant digits(not counting 0 at the end) */
+      Overflow= true;
+    }
+    Chunk= 0;
+    ChunkDigits= 0;
+  }
 
-      p= dot + 1;
-      while (*p)
+public:
+  void add(const char *Digits, size_t Count)
+  {
+    for (size_t i= 0; i < Count; ++i)
+    {
+      Chunk= Chunk*10 + static_cast<uint32_t>(Digits[i] - '0');
+      if (++ChunkDigits == 9)
       {
-        /* ignore non numbers */
-        if (!isdigit(0x000000ff & *p))
-          break;
-        ++digits_total;
-        /* ignore trailing zeros */
-        if (*p != '0')
-        {
-          digits_significant= digits_total;
-        }
-        ++p;
+        flush();
       }
+    }
+  }
 
-      /* Kinda tricky. let's say precision is 5.2. 1234.5 is fine, 1234.56 is overflow, 123.456 fractional overflow with rounding and warning */
-      if (digits_count + digits_significant > number->precision && digits_significant <= number->scale)
-      {
-        return MADB_ERR_22003;
-        /* if digits are zero there is no overflow */
-        /*for (p= dot + 1; p <= dot + digits_significant; ++p)
-        {
-          if (*p != '0')
-            
-        }*/
-      }
-      
-      if (digits_significant > number->scale)
-      {
-        ret= MADB_ERR_01S07;
-        memcpy(digits + digits_count, dot + 1, number->scale);
-      }
-      else
+  void addZeros(size_t Count)
+  {
+    while (Count > 0)
+    {
+      size_t Portion= MIN(Count, 9 - ChunkDigits);
+      Chunk*= MADB_Pow10[Portion];
+      ChunkDigits+= static_cast<unsigned int>(Portion);
+      Count-= Portion;
+      if (ChunkDigits == 9)
       {
-        memcpy(digits + digits_count, dot + 1, digits_significant);
-      
-        for (i= digits_count + digits_significant; i < digits_count + number->scale; ++i)
-        {
-          digits[i]= '0';
-        }
+        flush();
       }
-      digits_count+= number->scale;
     }
+  }
+
+  /* Returns false on overflow */
+  bool store(SQLCHAR *Val)
+  {
+    flush();
+    if (Overflow)
+    {
+      return false;
+    }
+    Value.toBytes(Val);
+    return true;
+  }
+};
+
+
+/* {{{ MADB_NumericValToDigits */
+/* Writes decimal digits of the SQL_NUMERIC_STRUCT::val to Digits, which has to have room for
+   MADB_DEFAULT_PRECISION + 2 chars. Returns number of digits, not counting terminating null */
+size_t MADB_NumericValToDigits(const SQLCHAR *Val, char *Digits)
+{
+  MADB_Uint128 Value;
+  uint32_t     Group[(MADB_DEFAULT_PRECISION + 1 + 8) / 9];
+  int          GroupCount= 0;
+  char        *p= Digits;
 
-    /* Rounding */
-    if (number->scale < 0)
+  Value.fromBytes(Val);
+  do
+  {
+    Group[GroupCount++]= Value.divMod(MADB_Pow10[9]);
+  } while (!Value.isZero());
+
+  /* Most significant group goes without leading zeroes, the rest are always 9 digits */
+  p+= _snprintf(p, 10, "%u", Group[--GroupCount]);
+  while (GroupCount > 0)
+  {
+    uint32_t Chunk= Group[--GroupCount];
+    for (int i= 8; i >= 0; --i)
     {
-      int64_t OldVal, Val;
-      int64_t RoundNumber= (int64_t)pow(10.0, -number->scale);
+      p[i]= static_cast<char>('0' + Chunk % 10);
+      Chunk/= 10;
+    }
+    p+= 9;
+  }
+  *p= '\0';
+
+  return p - Digits;
+}
+/* }}} */
+
+/* {{{ MADB_DecimalToNumeric */
+/* Converts decimal number string of given length to the SQL_NUMERIC_STRUCT. Precision and scale have to be set in the
+   structure before the call. The string doesn't have to be null-terminated. Returns 0 or error code - MADB_ERR_22003
+   on overflow, and MADB_ERR_01S07 if fractional part was truncated */
+int MADB_DecimalToNumeric(const char *Str, size_t Length, SQL_NUMERIC_STRUCT *Number)
+{
+  const char *p= Str, *End= Str + Length, *IntDigits, *FracDigits= nullptr;
+  size_t      IntCount, FracSignificant= 0;
+  int         Scale= Number->scale, ret= 0;
+  MADB_DigitsAccumulator Acc;
+
+  memset(Number->val, 0, sizeof(Number->val));
+  while (p < End && isspace(0x000000ff & *p))
+  {
+    ++p;
+  }
+  /* Determining the sign of the number. From now on we deal with unsigned number */
+  if (!(Number->sign= (p < End && *p == '-') ? 0 : 1))
+  {
+    ++p;
+  }
+  /* Empty string - nothing to do*/
+  if (p == End)
+  {
+    return ret;
+  }
+  if (Number->precision == 0)
+  {
+    Number->precision= MADB_DEFAULT_PRECISION;
+  }
+  /* Skipping leading zeroes */
+  while (p < End && *p == '0')
+  {
+    ++p;
+  }
+  IntDigits= p;
+  while (p < End && isdigit(0x000000ff & *p))
+  {
+    ++p;
+  }
+  IntCount= p - IntDigits;
 
-      //if (digits_count <= number->precision)
+  if (p < End && *p == '.')
+  {
+    size_t FracTotal= 0;
+    FracDigits= ++p;
+    while (p < End && isdigit(0x000000ff & *p))
+    {
+      ++FracTotal;
+      /* ignore trailing zeros */
+      if (*p != '0')
       {
-        digits[digits_count/*number->precision*/]= 0;
+        FracSignificant= FracTotal;
       }
-      Val= _atoi64(digits);
+      ++p;
+    }
+  }
 
-      OldVal= Val;
-      Val= (Val + RoundNumber / 2) / RoundNumber * RoundNumber;
-      if (OldVal != Val)
+  /* Overflow checks */
+  if (IntCount > MADB_DEFAULT_PRECISION + 1) /* 16 bytes of FF make up 39 digits number */
+  {
+    return MADB_ERR_22003;
+  }
+  if (IntCount > Number->precision)
+  {
+    /* if scale is negative, and we have just enough zeroes at the end - we are fine, there is no overflow */
+    if (Scale >= 0 || Number->precision - Scale < static_cast<int>(IntCount))
+    {
+      return MADB_ERR_22003;
+    }
+    /* Checking that all digits past precision are '0'. Otherwise - overflow */
+    for (const char *Digit= IntDigits + Number->precision; Digit < IntDigits + IntCount; ++Digit)
+    {
+      if (*Digit != '0')
       {
         return MADB_ERR_22003;
       }
-      /* Assuming that buffer is always big enough */
-      digits_count= _snprintf(digits, sizeof(digits), "%lld", Val/RoundNumber);
-      if (digits_count > number->precision)
-        return MADB_ERR_22003;
     }
+  }
 
-    digits_count= MIN(digits_count, MADB_DEFAULT_PRECISION + 1);
-    for (hval= 0, bit= 1L, sta= 0, olen= 0; sta < digits_count;)
+  if (Scale < 0)
+  {
+    /* Value is stored divided by 10^-scale, and that must not lose anything. Fractional part is ignored */
+    size_t Dropped= MIN(IntCount, static_cast<size_t>(-Scale));
+    for (const char *Digit= IntDigits + IntCount - Dropped; Digit < IntDigits + IntCount; ++Digit)
     {
-      for (dig= 0, i= sta; i < digits_count; i++)
+      if (*Digit != '0')
       {
-        tv= dig * 10 + digits[i] - '0';
-        dig= tv % 2;
-        digits[i]= tv / 2 + '0';
-        if (i == sta && tv < 2)
-          sta++;
+        return MADB_ERR_22003;
       }
-      if (dig > 0)
-        hval |= bit;
-      bit <<= 1;
-      if (bit >= (1L << 8))
-      {
-        if (olen >= SQL_MAX_NUMERIC_LEN)
-        {
-          //number->scale= sta - number->precision;
-          ret= MADB_ERR_22003;
-          break;
-        }
-        number->val[olen++]= hval;
-        hval= 0;
-        bit= 1L;
-
-      } 
     }
-    if (hval != 0)
+    if (IntCount - Dropped > Number->precision)
     {
-      if (olen < SQL_MAX_NUMERIC_LEN)
+      return MADB_ERR_22003;
+    }
+    Acc.add(IntDigits, IntCount - Dropped);
+  }
+  else
+  {
+    Acc.add(IntDigits, IntCount);
+    if (Scale > 0)
+    {
+      /* Kinda tricky. let's say precision is 5.2. 1234.5 is fine, 1234.56 is overflow, 123.456 fractional overflow
+         with rounding and warning */
+      if (IntCount + FracSignificant > Number->precision && FracSignificant <= static_cast<size_t>(Scale))
       {
-        number->val[olen++]= hval;
+        return MADB_ERR_22003;
+      }
+      if (FracSignificant > static_cast<size_t>(Scale))
+      {
+        ret= MADB_ERR_01S07;
+        Acc.add(FracDigits, Scale);
       }
       else
       {
-        ret= MADB_ERR_22003;
+        Acc.add(FracDigits, FracSignificant);
+        Acc.addZeros(Scale - FracSignificant);
       }
     }
-  } 
+  }
+
+  if (!Acc.store(Number->val))
+  {
+    memset(Number->val, 0, sizeof(Number->val));
+    return MADB_ERR_22003;
+  }
   return ret;
 }
+/* }}} */
 
 /* {{{ MADB_GetHexString */
 size_t MADB_GetHexString(char *BinaryBuffer, size_t BinaryLength,
@@ -27,7 +27,7 @@ MYSQL_RES* MADB_ReadDefaultValues(MADB_Dbc *Dbc, const char *Catalog, const char
 int MADB_GetDefaultType(int SQLDataType);
 void MADB_CopyOdbcTsToMadbTime(SQL_TIMESTAMP_STRUCT *Src, MYSQL_TIME *Dst);
 void MADB_CopyMadbTimeToOdbcTs(MYSQL_TIME *Src, SQL_TIMESTAMP_STRUCT *Dst);
-SQLRETURN MADB_CopyMadbTimestamp(MADB_Stmt *Stmt, MYSQL_TIME *tm, SQLPOINTER DataPtr, SQLLEN *Length, SQLLEN *Ind,
+SQLRETURN MADB_CopyMadbTimestamp(MADB_Error *Error, MYSQL_TIME *tm, SQLPOINTER DataPtr, SQLLEN *Length, SQLLEN *Ind,
                                  SQLSMALLINT CType, SQLSMALLINT SqlType);
 int  MADB_GetWCharType(int Type);
 
@@ -60,8 +60,8 @@ MYSQL_RES *   MADB_GetDefaultColumnValues(MADB_Stmt *Stmt, const MYSQL_FIELD *fi
 char *        MADB_GetDefaultColumnValue(MYSQL_RES *res, const char *Column);
 
 /* SQL_NUMERIC stuff */
-int           MADB_CharToSQLNumeric (char *buffer, MADB_Desc *Ard, MADB_DescRecord *ArdRecord,
-                                     SQL_NUMERIC_STRUCT *dst_buffer, unsigned long RowNumber);
+int           MADB_DecimalToNumeric (const char *Str, size_t Length, SQL_NUMERIC_STRUCT *Number);
+size_t        MADB_NumericValToDigits(const SQLCHAR *Val, char *Digits);
 void          MADB_NumericInit      (SQL_NUMERIC_STRUCT *number, MADB_DescRecord *Ard);
 
 int           MADB_FindNextDaeParam     (MADB_Desc *Desc, int InitialParam, SQLSMALLINT RowNumber);
@@ -22,28 +22,28 @@
 // In fact atm for variables it's srangely 81.
 #define MADB_DECIMAL_MAX_PRECISION 65
 
+/* Row of the SQLGetTypeInfo result. Fields have types of the respective result columns */
 typedef struct
 {
-  bytes TypeName;
-  bytes DataType;
-  bytes ColumnSize;
-  bytes LiteralPrefix;
-  bytes LiteralSuffix;
-  bytes CreateParams;
-  bytes Nullable;
-  bytes CaseSensitive;
-  bytes Searchable;
-  bytes Unsigned;
-  bytes FixedPrecScale;
-  bytes AutoUniqueValue;
-  bytes LocalTypeName;
-  bytes MinimumScale;
-  bytes MaximumScale;
-  bytes SqlDataType1;
-  bytes SqlDateTimeSub;
-  bytes NumPrecRadix;
-  bytes IntervalPrecision;
-  bytes SqlDataType;
+  const char *TypeName;
+  SQLSMALLINT DataType;
+  SQLINTEGER  ColumnSize;
+  const char *LiteralPrefix;
+  const char *LiteralSuffix;
+  const char *CreateParams;
+  SQLSMALLINT Nullable;
+  SQLSMALLINT CaseSensitive;
+  SQLSMALLINT Searchable;
+  SQLSMALLINT Unsigned;
+  SQLSMALLINT FixedPrecScale;
+  SQLSMALLINT AutoUniqueValue;
+  const char *LocalTypeName;
+  SQLSMALLINT MinimumScale;
+  SQLSMALLINT MaximumScale;
+  SQLSMALLINT SqlDataType;
+  SQLSMALLINT SqlDateTimeSub;
+  SQLINTEGER  NumPrecRadix;
+  SQLSMALLINT IntervalPrecision;
 } MADB_TypeInfo;
 
 
@@ -22,6 +22,8 @@
 
 #include <memory>
 #include <list>
+#include <mutex>
+#include <atomic>
 #include <map>
 #include "ma_c_stuff.h"
 #include "ma_legacy_helpers.h"
@@ -33,6 +35,8 @@
 
 namespace mariadb
 {
+  class BoundRCodec;
+
   namespace Unique
   {
     typedef std::unique_ptr<mariadb::PsCache<mariadb::ServerPrepareResult>> PsCache;
@@ -41,6 +45,7 @@ namespace mariadb
     typedef std::unique_ptr<mariadb::Protocol> Protocol;
     typedef std::unique_ptr<mariadb::ParamCodec> ParamCodec;
     typedef std::unique_ptr<mariadb::ResultCodec> ResultCodec;
+    typedef std::unique_ptr<mariadb::BoundRCodec> BoundRCodec;
   }
 }
 
@@ -214,6 +219,8 @@ typedef struct
 	SQLUINTEGER	ScrollConcurrency;
   SQLUINTEGER RetrieveData;
 	SQLUINTEGER UseBookmarks;
+  SQLUINTEGER ContinueOnError;
+  SQLUINTEGER LoadData;
   SQLSMALLINT BookmarkType;
 } MADB_StmtOptions;
 
@@ -255,6 +262,7 @@ typedef struct
 {
   uint32_t  ArraySize;
   bool      HasRowsToSkip;
+  bool      LoadData; /* The array has been sent as LOAD DATA LOCAL INFILE input */
 } MADB_BulkOperationInfo;
 
 /* Stmt struct needs definitions from my_parse.h */
@@ -271,22 +279,55 @@ enum MADB_AppType {
 struct MADB_Env {
   typedef /*typename*/std::list<MADB_Dbc*>::iterator ListIterator;
   MADB_Error Error;
-  std::list<MADB_Dbc*> Dbcs;
   SQLUINTEGER Trace;
   SQLINTEGER OdbcVersion;
   enum MADB_AppType AppType;
 
   ListIterator addConnection(MADB_Dbc* conn);
-  void forgetConnection(MADB_Env::ListIterator& it);
+  void forgetConnection(MADB_Dbc* conn, MADB_Env::ListIterator& it);
+  bool hasConnections() const { return DbcCount.load(std::memory_order_acquire) > 0; }
+  std::vector<MADB_Dbc*> getConnections();
+  mariadb::WorkerPool& getWorkerPool();
 
 private:
+  /* Connections are registered in one of the shards picked by the handle address, so threads allocating and freeing
+     connections mostly take different locks. Shards are padded, so neighbour locks are not in the same cache line */
+  static const std::size_t DbcShardCount= 16;
+  struct DbcShard {
+    std::mutex cs;
+    std::list<MADB_Dbc*> Dbcs;
+    char Padding[64];
+  };
+  DbcShard& getShard(const MADB_Dbc* conn);
+
+  DbcShard DbcShards[DbcShardCount];
+  std::atomic<std::size_t> DbcCount{0};
   std::mutex cs;
+  std::unique_ptr<mariadb::WorkerPool> Workers;
 };
 
 // Stmt has to know few things about connection and descriptor
 #include "ma_connection.h"
 #include "ma_desc.h"
 
+/* Grow-only buffers for fetched values, that need conversion before they go to the application's buffers. Addressed
+   by slot and column. Slot is the row number in the rowset if rows conversion is deferred, and 0 otherwise. Buffers
+   live across rows and rowsets, thus the fetch loop does not allocate anything once they have grown big enough */
+class MADB_ScratchBuffers
+{
+  struct Buffer
+  {
+    std::unique_ptr<char[]> Data;
+    std::size_t             Size= 0;
+  };
+  std::vector<std::vector<Buffer>> Slots;
+
+public:
+  /* Returns the buffer of at least Size bytes, or nullptr if it could not be allocated */
+  char* get(std::size_t Slot, std::size_t Column, std::size_t Size);
+  void  clear() { Slots.clear(); }
+};
+
 struct MADB_Stmt
 {
   MADB_StmtOptions          Options;
@@ -312,16 +353,18 @@ struct MADB_Stmt
   char                      *TableName= nullptr;
   char                      *CatalogName= nullptr;
   MADB_ShortTypeInfo        *ColsTypeFixArr= nullptr;
+  MADB_ScratchBuffers       FetchScratch;   /* Conversion buffers of the bound columns */
+  MADB_ScratchBuffers       GetDataScratch; /* and of the columns read with SQLGetData */
   /* Application Descriptors */
   MADB_Desc *Apd= nullptr;
   MADB_Desc *Ard= nullptr;
   MADB_Desc *Ird= nullptr;
   MADB_Desc *Ipd= nullptr;
   /* Internal Descriptors */
-  MADB_Desc *IApd;
-  MADB_Desc *IArd;
-  MADB_Desc *IIrd;
-  MADB_Desc *IIpd;
+  MADB_Desc *IApd= nullptr;
+  MADB_Desc *IArd= nullptr;
+  MADB_Desc *IIrd= nullptr;
+  MADB_Desc *IIpd= nullptr;
   unsigned short            *UniqueIndex= nullptr; /* Insdexes of columns that make best available unique identifier */
   SQLSETPOSIROW             DaeRowNumber= 0;
   int32_t                   ArrayOffset= 0;
@@ -336,6 +379,10 @@ struct MADB_Stmt
   bool                      PositionedCommand= false;
   bool                      RebindParams= false;
   bool                      bind_done= false;
+  /* If failed bulk execution of the query is known to leave nothing behind. -1 - not checked yet */
+  int8_t                    BulkAtomic= -1;
+  /* Diagnostic records following the first one(i.e. Error). Only first Error.ExtraRecords of them are valid */
+  std::vector<MADB_Error>   DiagRecords;
 
   MADB_Stmt(MADB_Dbc *Connection);
   SQLRETURN Prepare(const char* StatementText, SQLINTEGER TextLength, bool ServerSide= true);
@@ -343,6 +390,8 @@ struct MADB_Stmt
   SQLRETURN DoExecuteBatch();
   void AfterExecute();
   void AfterPrepare();// Should go to private at some point
+  /* Returns diagnostic record by its 1-based number, or nullptr if there is no such record */
+  MADB_Error* DiagRecord(SQLSMALLINT RecNumber);
   
   //const SQLString& OriginalQuery() { return Query.Original; }
 
@@ -350,7 +399,7 @@ private:
   Unique::ParamCodec paramRowCallback;
   std::vector<Unique::ParamCodec> paramCodec;
   Unique::ResultCodec nullRCodec;
-  std::map<uint32_t,Unique::ResultCodec> resultCodec;
+  std::vector<Unique::BoundRCodec> resultCodec; /* column indexed, empty pointer if the column is not fetched via callback */
   MADB_Stmt()= delete;
   void ProcessRsMetadata();
 
@@ -360,9 +409,10 @@ public:
   SQLRETURN doBulkOldWay(uint32_t parNr, MADB_DescRecord* CRec, MADB_DescRecord* SqlRec, SQLLEN* IndicatorPtr, SQLLEN* OctetLengthPtr, void* DataPtr,
     MYSQL_BIND* MaBind, unsigned int& IndIdx/* column with indicator array - needed to skip rows */, unsigned int ParamOffset);
   void setupBulkCallbacks(uint32_t parNr, MADB_DescRecord* CRec, MADB_DescRecord* SqlRec, DescArrayIterator& cit, MYSQL_BIND* MaBind);
-  void PrepareBind(int32_t RowNumber);
+  void PrepareBind(int32_t RowNumber, std::size_t ScratchSlot= 0);
   bool setResultCodec(ResultCodec* codec, unsigned long column=(unsigned long)-1/* "null" row level codec */);
   SQLRETURN FixFetchedValues(int RowNumber, int64_t SaveCursor);
+  SQLRETURN FixFetchedValues(int RowNumber, int64_t SaveCursor, MYSQL_BIND* Result, MADB_Error& Err, SQLRETURN& AggRc);
 };
 
 typedef BOOL (__stdcall *PromptDSN)(HWND hwnd, MADB_Dsn *Dsn);
@@ -390,6 +440,16 @@ void  CloseClientCharset(Client_Charset *cc);
 /* Inexistent param id */
 #define MADB_NOPARAM           -1
 
+#ifndef SQL_DRIVER_STMT_ATTR_BASE
+# define SQL_DRIVER_STMT_ATTR_BASE 0x00004000
+#endif
+/* Driver specific statement attribute. If SQL_TRUE, execution of the parameters array goes on after failed parameter
+   sets, and each of them gets own diagnostic record and SQL_PARAM_ERROR status */
+#define SQL_ATTR_MADB_CONTINUE_ON_ERROR (SQL_DRIVER_STMT_ATTR_BASE + 1)
+/* Driver specific statement attribute. If SQL_TRUE, the parameters array of a plain INSERT IGNORE ... VALUES(?,...) is
+   sent as the input of LOAD DATA LOCAL INFILE, generated from the parameters buffers on the fly */
+#define SQL_ATTR_MADB_LOAD_DATA (SQL_DRIVER_STMT_ATTR_BASE + 2)
+
 /* Enabling tracing */
 #define MAODBC_DEBUG 1
 /* Macro checks return of the suplied SQLRETURN function call, checks if it is succeeded, and in case of error pushes error up */
@@ -26,12 +26,20 @@
 #include <ma_odbc.h>
 #include <stdarg.h>
 #include "ma_conv_charset.h"
+#include "ma_simd.h"
 
 extern MARIADB_CHARSET_INFO *DmUnicodeCs;
 extern Client_Charset utf8;
 
 char LogFile[256];
 
+/* UTF-8 connection with 2 bytes SQLWCHAR - conversions for SQL_C_WCHAR and W functions don't need iconv, and are done
+   by the driver */
+static inline bool MADB_IsUtf8ToUtf16(const Client_Charset *cc)
+{
+  return sizeof(SQLWCHAR) == 2 && cc->CodePage == CP_UTF8;
+}
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -163,8 +171,16 @@ SQLWCHAR *MADB_ConvertToWchar(const char *Ptr, SQLLEN PtrLength, Client_Charset*
   if ((WStr= (SQLWCHAR *)MADB_CALLOC(sizeof(SQLWCHAR) * (PtrLength + 1))))
   {
     size_t wstr_octet_len= sizeof(SQLWCHAR) * (PtrLength + 1);
+    int    error;
     /* TODO: Need error processing. i.e. if MADB_ConvertString returns -1 */
-    MADB_ConvertString(Ptr, &Length, cc->cs_info, (char*)WStr, &wstr_octet_len, DmUnicodeCs, NULL);
+    if (MADB_IsUtf8ToUtf16(cc))
+    {
+      MADB_Utf8ToUtf16(Ptr, Length, reinterpret_cast<uint16_t*>(WStr), PtrLength + 1, &error);
+    }
+    else
+    {
+      MADB_ConvertString(Ptr, &Length, cc->cs_info, (char*)WStr, &wstr_octet_len, DmUnicodeCs, &error);
+    }
   }
 
   return WStr;
@@ -211,7 +227,14 @@ char *MADB_ConvertFromWChar(const SQLWCHAR *Ptr, SQLINTEGER PtrLength, SQLULEN *
   if (!(AscStr = (char *)MADB_CALLOC(AscLen)))
     return NULL;
 
-  AscLen= MADB_ConvertString((char*)Ptr, &PtrOctetLen, DmUnicodeCs, AscStr, &AscLen, cc->cs_info, Error);
+  if (MADB_IsUtf8ToUtf16(cc))
+  {
+    AscLen= MADB_Utf16ToUtf8(reinterpret_cast<const uint16_t*>(Ptr), PtrOctetLen / sizeof(SQLWCHAR), AscStr, AscLen, Error);
+  }
+  else
+  {
+    AscLen= MADB_ConvertString((char*)Ptr, &PtrOctetLen, DmUnicodeCs, AscStr, &AscLen, cc->cs_info, Error);
+  }
 
   if (AscLen != (size_t)-1)
   {
@@ -249,7 +272,7 @@ int MADB_ConvertAnsi2Unicode(Client_Charset *cc, const char *AnsiString, SQLLEN
   SQLINTEGER  RequiredLength;
   SQLWCHAR   *Tmp= UnicodeString;
   int         rc= 0, error;
-  size_t      SrcOctetLen, DestOctetLen;
+  size_t      SrcOctetLen, DestOctetLen, ConvertedLen;
 
   if (LengthIndicator)
     *LengthIndicator= 0;
@@ -300,8 +323,21 @@ int MADB_ConvertAnsi2Unicode(Client_Charset *cc, const char *AnsiString, SQLLEN
   SrcOctetLen= AnsiLength + IsNull;
   DestOctetLen= sizeof(SQLWCHAR) * RequiredLength;
 
-  RequiredLength= MADB_ConvertString(AnsiString, &SrcOctetLen, cc->cs_info, 
-                                        (char*)Tmp, &DestOctetLen, DmUnicodeCs, &error);
+  if (MADB_IsUtf8ToUtf16(cc))
+  {
+    ConvertedLen= MADB_Utf8ToUtf16(AnsiString, SrcOctetLen, reinterpret_cast<uint16_t*>(Tmp),
+                                   DestOctetLen / sizeof(SQLWCHAR), &error);
+    if (ConvertedLen != (size_t)-1)
+    {
+      ConvertedLen*= sizeof(SQLWCHAR);
+    }
+  }
+  else
+  {
+    ConvertedLen= MADB_ConvertString(AnsiString, &SrcOctetLen, cc->cs_info,
+                                     (char*)Tmp, &DestOctetLen, DmUnicodeCs, &error);
+  }
+  RequiredLength= ConvertedLen == (size_t)-1 ? -1 : (SQLINTEGER)ConvertedLen;
 
   if (RequiredLength < 1)
   {
@@ -161,10 +161,9 @@ SQLRETURN MADB_StmtMoreResults(SQLHSTMT StatementHandle)
     std::lock_guard<std::mutex> localScopeLock(Stmt->Connection->guard->getLock());
     if (Stmt->stmt->getMoreResults())
     {
-      unsigned int ServerStatus;
-      mariadb_get_infov(Stmt->Connection->mariadb, MARIADB_CONNECTION_SERVER_STATUS, (void*)&ServerStatus);
       Stmt->rs.reset(Stmt->stmt->getResultSet());
-      bool itsOutParams= ServerStatus & SERVER_PS_OUT_PARAMS;
+      /* Connection's status may be of some later result already, if they are read in the background */
+      bool itsOutParams= Stmt->rs && Stmt->rs->isCallableResult();
       bool haveOutParams= HasOutParams(Stmt);
 
       if (Stmt->Query.QueryType == MADB_QUERY_CALL && !itsOutParams && Stmt->Connection->IsMySQL &&
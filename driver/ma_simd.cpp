@@ -0,0 +1,542 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation plc
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+
+#include <cerrno>
+#include <algorithm>
+
+#include "ma_simd.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64)
+# define MADB_SIMD_X86 1
+# include <emmintrin.h>
+# include <immintrin.h>
+# ifdef _MSC_VER
+#  include <intrin.h>
+#  define MADB_TARGET_AVX2
+# else
+/* Only these functions are compiled for AVX2, and they are called only if the CPU has it */
+#  define MADB_TARGET_AVX2 __attribute__((target("avx2")))
+# endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+# define MADB_SIMD_NEON 1
+# include <arm_neon.h>
+#endif
+
+
+struct MADB_SimdKernels
+{
+  std::size_t (*Utf16Len)(const uint16_t *str, std::size_t maxLen);
+  std::size_t (*AsciiPrefixLen)(const char *str, std::size_t len);
+  void        (*AsciiToUtf16)(const char *src, std::size_t len, uint16_t *dst);
+  std::size_t (*Utf16ToAscii)(const uint16_t *src, std::size_t len, char *dst);
+};
+
+
+/* {{{ Plain loops. Also used for heads and tails of vectorized versions */
+static inline std::size_t Utf16LenScalar(const uint16_t *str, std::size_t maxLen)
+{
+  std::size_t i= 0;
+  while (i < maxLen && str[i] != 0)
+  {
+    ++i;
+  }
+  return i;
+}
+
+static inline std::size_t AsciiPrefixLenScalar(const char *str, std::size_t len)
+{
+  std::size_t i= 0;
+  while (i < len && (static_cast<unsigned char>(str[i]) & 0x80) == 0)
+  {
+    ++i;
+  }
+  return i;
+}
+
+static inline void AsciiToUtf16Scalar(const char *src, std::size_t len, uint16_t *dst)
+{
+  for (std::size_t i= 0; i < len; ++i)
+  {
+    dst[i]= static_cast<unsigned char>(src[i]);
+  }
+}
+
+static inline std::size_t Utf16ToAsciiScalar(const uint16_t *src, std::size_t len, char *dst)
+{
+  std::size_t i= 0;
+  while (i < len && src[i] < 0x80)
+  {
+    dst[i]= static_cast<char>(src[i]);
+    ++i;
+  }
+  return i;
+}
+/* }}} */
+
+
+#if defined(MADB_SIMD_X86) || defined(MADB_SIMD_NEON)
+static inline unsigned int FirstBit(uint64_t mask)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return static_cast<unsigned int>(index);
+#else
+  return static_cast<unsigned int>(__builtin_ctzll(mask));
+#endif
+}
+
+/* Units before the vector boundary are checked one by one. Vector loads are aligned after that, and thus never cross
+   the page boundary, even though they may read past the terminating zero. If the string is not aligned on 2 bytes,
+   it never reaches the boundary, and is scanned by the plain loop */
+static inline std::size_t Utf16Prologue(const uint16_t *str, std::size_t maxLen, uintptr_t alignment, bool& found)
+{
+  std::size_t i= 0;
+  found= true;
+  while (i < maxLen && (reinterpret_cast<uintptr_t>(str + i) & (alignment - 1)) != 0)
+  {
+    if (str[i] == 0)
+    {
+      return i;
+    }
+    ++i;
+  }
+  found= (i == maxLen);
+  return i;
+}
+#endif
+
+
+#ifdef MADB_SIMD_X86
+/* {{{ SSE2 - always there on x86_64 */
+static std::size_t Utf16LenSse2(const uint16_t *str, std::size_t maxLen)
+{
+  bool found;
+  std::size_t i= Utf16Prologue(str, maxLen, 16, found);
+  const __m128i zero= _mm_setzero_si128();
+
+  if (found)
+  {
+    return i;
+  }
+  for (; i < maxLen; i+= 8)
+  {
+    int mask= _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(str + i)), zero));
+    if (mask != 0)
+    {
+      i+= FirstBit(static_cast<uint64_t>(mask)) / 2;
+      break;
+    }
+  }
+  return i < maxLen ? i : maxLen;
+}
+
+static std::size_t AsciiPrefixLenSse2(const char *str, std::size_t len)
+{
+  std::size_t i= 0;
+  for (; i + 16 <= len; i+= 16)
+  {
+    int mask= _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i)));
+    if (mask != 0)
+    {
+      return i + FirstBit(static_cast<uint64_t>(mask));
+    }
+  }
+  return i + AsciiPrefixLenScalar(str + i, len - i);
+}
+
+static void AsciiToUtf16Sse2(const char *src, std::size_t len, uint16_t *dst)
+{
+  std::size_t i= 0;
+  const __m128i zero= _mm_setzero_si128();
+
+  for (; i + 16 <= len; i+= 16)
+  {
+    __m128i chunk= _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(chunk, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(chunk, zero));
+  }
+  AsciiToUtf16Scalar(src + i, len - i, dst + i);
+}
+
+/* AVX2 pack works within 128 bit lanes, and would need the permute. SSE2 version serves both */
+static std::size_t Utf16ToAsciiSse2(const uint16_t *src, std::size_t len, char *dst)
+{
+  std::size_t i= 0;
+  const __m128i nonAscii= _mm_set1_epi16(static_cast<short>(0xFF80)), zero= _mm_setzero_si128();
+
+  for (; i + 16 <= len; i+= 16)
+  {
+    __m128i low=  _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i high= _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(low, high), nonAscii), zero)) != 0xFFFF)
+    {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(low, high));
+  }
+  return i + Utf16ToAsciiScalar(src + i, len - i, dst + i);
+}
+/* }}} */
+
+/* {{{ AVX2 */
+MADB_TARGET_AVX2
+static std::size_t Utf16LenAvx2(const uint16_t *str, std::size_t maxLen)
+{
+  bool found;
+  std::size_t i= Utf16Prologue(str, maxLen, 32, found);
+  const __m256i zero= _mm256_setzero_si256();
+
+  if (found)
+  {
+    return i;
+  }
+  for (; i < maxLen; i+= 16)
+  {
+    unsigned int mask= static_cast<unsigned int>(_mm256_movemask_epi8(
+      _mm256_cmpeq_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(str + i)), zero)));
+    if (mask != 0)
+    {
+      i+= FirstBit(mask) / 2;
+      break;
+    }
+  }
+  return i < maxLen ? i : maxLen;
+}
+
+MADB_TARGET_AVX2
+static std::size_t AsciiPrefixLenAvx2(const char *str, std::size_t len)
+{
+  std::size_t i= 0;
+  for (; i + 32 <= len; i+= 32)
+  {
+    unsigned int mask= static_cast<unsigned int>(_mm256_movemask_epi8(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i))));
+    if (mask != 0)
+    {
+      return i + FirstBit(mask);
+    }
+  }
+  return i + AsciiPrefixLenSse2(str + i, len - i);
+}
+
+MADB_TARGET_AVX2
+static void AsciiToUtf16Avx2(const char *src, std::size_t len, uint16_t *dst)
+{
+  std::size_t i= 0;
+  for (; i + 32 <= len; i+= 32)
+  {
+    __m256i low=  _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    __m256i high= _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16), high);
+  }
+  AsciiToUtf16Sse2(src + i, len - i, dst + i);
+}
+/* }}} */
+
+static bool HasAvx2()
+{
+#ifdef _MSC_VER
+  int info[4];
+
+  __cpuid(info, 0);
+  if (info[0] < 7)
+  {
+    return false;
+  }
+  __cpuid(info, 1);
+  /* The CPU has AVX and XSAVE, and the OS saves YMM registers on the context switch */
+  if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+  {
+    return false;
+  }
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif /* MADB_SIMD_X86 */
+
+
+#ifdef MADB_SIMD_NEON
+/* {{{ NEON - always there on aarch64 */
+
+/* Narrows comparison result of 8 units to 64 bit mask with 8 bits per unit */
+static inline uint64_t NeonUnitMask(uint16x8_t eq)
+{
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(eq, 4)), 0);
+}
+
+static std::size_t Utf16LenNeon(const uint16_t *str, std::size_t maxLen)
+{
+  bool found;
+  std::size_t i= Utf16Prologue(str, maxLen, 16, found);
+
+  if (found)
+  {
+    return i;
+  }
+  for (; i < maxLen; i+= 8)
+  {
+    uint64_t mask= NeonUnitMask(vceqq_u16(vld1q_u16(str + i), vdupq_n_u16(0)));
+    if (mask != 0)
+    {
+      i+= FirstBit(mask) / 8;
+      break;
+    }
+  }
+  return i < maxLen ? i : maxLen;
+}
+
+static std::size_t AsciiPrefixLenNeon(const char *str, std::size_t len)
+{
+  std::size_t i= 0;
+  for (; i + 16 <= len; i+= 16)
+  {
+    if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(str + i))) >= 0x80)
+    {
+      break;
+    }
+  }
+  return i + AsciiPrefixLenScalar(str + i, len - i);
+}
+
+static void AsciiToUtf16Neon(const char *src, std::size_t len, uint16_t *dst)
+{
+  std::size_t i= 0;
+  for (; i + 16 <= len; i+= 16)
+  {
+    uint8x16_t chunk= vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    vst1q_u16(dst + i, vmovl_u8(vget_low_u8(chunk)));
+    vst1q_u16(dst + i + 8, vmovl_u8(vget_high_u8(chunk)));
+  }
+  AsciiToUtf16Scalar(src + i, len - i, dst + i);
+}
+
+static std::size_t Utf16ToAsciiNeon(const uint16_t *src, std::size_t len, char *dst)
+{
+  std::size_t i= 0;
+  for (; i + 16 <= len; i+= 16)
+  {
+    uint16x8_t low=  vld1q_u16(src + i);
+    uint16x8_t high= vld1q_u16(src + i + 8);
+    if (vmaxvq_u16(vorrq_u16(low, high)) >= 0x80)
+    {
+      break;
+    }
+    vst1q_u8(reinterpret_cast<uint8_t*>(dst + i), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+  }
+  return i + Utf16ToAsciiScalar(src + i, len - i, dst + i);
+}
+/* }}} */
+#endif /* MADB_SIMD_NEON */
+
+
+static MADB_SimdKernels MADB_SelectKernels()
+{
+#if defined(MADB_SIMD_X86)
+  if (HasAvx2())
+  {
+    return MADB_SimdKernels{ Utf16LenAvx2, AsciiPrefixLenAvx2, AsciiToUtf16Avx2, Utf16ToAsciiSse2 };
+  }
+  return MADB_SimdKernels{ Utf16LenSse2, AsciiPrefixLenSse2, AsciiToUtf16Sse2, Utf16ToAsciiSse2 };
+#elif defined(MADB_SIMD_NEON)
+  return MADB_SimdKernels{ Utf16LenNeon, AsciiPrefixLenNeon, AsciiToUtf16Neon, Utf16ToAsciiNeon };
+#else
+  return MADB_SimdKernels{ Utf16LenScalar, AsciiPrefixLenScalar, AsciiToUtf16Scalar, Utf16ToAsciiScalar };
+#endif
+}
+
+
+static const MADB_SimdKernels& MADB_Kernels()
+{
+  static const MADB_SimdKernels Kernels= MADB_SelectKernels();
+  return Kernels;
+}
+
+
+std::size_t MADB_Utf16Len(const uint16_t *str, std::size_t maxLen)
+{
+  return MADB_Kernels().Utf16Len(str, maxLen);
+}
+
+
+std::size_t MADB_AsciiPrefixLen(const char *str, std::size_t len)
+{
+  return MADB_Kernels().AsciiPrefixLen(str, len);
+}
+
+
+void MADB_AsciiToUtf16(const char *src, std::size_t len, uint16_t *dst)
+{
+  MADB_Kernels().AsciiToUtf16(src, len, dst);
+}
+
+
+std::size_t MADB_Utf16ToAscii(const uint16_t *src, std::size_t len, char *dst)
+{
+  return MADB_Kernels().Utf16ToAscii(src, len, dst);
+}
+
+
+static inline std::size_t TranscodingError(int *errorcode, int error)
+{
+  if (errorcode != nullptr)
+  {
+    *errorcode= error;
+  }
+  return static_cast<std::size_t>(-1);
+}
+
+
+std::size_t MADB_Utf8ToUtf16(const char *from, std::size_t fromLen, uint16_t *to, std::size_t toLen, int *errorcode)
+{
+  const unsigned char *src= reinterpret_cast<const unsigned char*>(from);
+  std::size_t in= 0, out= 0;
+
+  if (errorcode != nullptr)
+  {
+    *errorcode= 0;
+  }
+  while (in < fromLen)
+  {
+    unsigned char lead= src[in];
+    uint32_t codepoint;
+    std::size_t seqLen;
+
+    if (lead < 0x80)
+    {
+      std::size_t ascii= MADB_AsciiPrefixLen(from + in, std::min(fromLen - in, toLen - out));
+      if (ascii == 0)
+      {
+        return TranscodingError(errorcode, E2BIG);
+      }
+      MADB_AsciiToUtf16(from + in, ascii, to + out);
+      in+= ascii;
+      out+= ascii;
+      continue;
+    }
+    /* Overlong forms, surrogates and code points above U+10FFFF are rejected, as iconv does */
+    if (lead < 0xC2 || lead > 0xF4)
+    {
+      return TranscodingError(errorcode, EILSEQ);
+    }
+    seqLen= lead < 0xE0 ? 2 : (lead < 0xF0 ? 3 : 4);
+    if (in + seqLen > fromLen)
+    {
+      return TranscodingError(errorcode, EINVAL);
+    }
+    codepoint= lead & (0xFF >> (seqLen + 1));
+    for (std::size_t i= 1; i < seqLen; ++i)
+    {
+      if ((src[in + i] & 0xC0) != 0x80)
+      {
+        return TranscodingError(errorcode, EILSEQ);
+      }
+      codepoint= (codepoint << 6) | (src[in + i] & 0x3F);
+    }
+    if ((seqLen == 3 && (codepoint < 0x800 || (codepoint >= 0xD800 && codepoint <= 0xDFFF))) ||
+        (seqLen == 4 && (codepoint < 0x10000 || codepoint > 0x10FFFF)))
+    {
+      return TranscodingError(errorcode, EILSEQ);
+    }
+    if (codepoint >= 0x10000)
+    {
+      if (toLen - out < 2)
+      {
+        return TranscodingError(errorcode, E2BIG);
+      }
+      codepoint-= 0x10000;
+      to[out++]= static_cast<uint16_t>(0xD800 | (codepoint >> 10));
+      to[out++]= static_cast<uint16_t>(0xDC00 | (codepoint & 0x3FF));
+    }
+    else
+    {
+      if (out == toLen)
+      {
+        return TranscodingError(errorcode, E2BIG);
+      }
+      to[out++]= static_cast<uint16_t>(codepoint);
+    }
+    in+= seqLen;
+  }
+  return out;
+}
+
+
+std::size_t MADB_Utf16ToUtf8(const uint16_t *from, std::size_t fromLen, char *to, std::size_t toLen, int *errorcode)
+{
+  std::size_t in= 0, out= 0;
+
+  if (errorcode != nullptr)
+  {
+    *errorcode= 0;
+  }
+  while (in < fromLen)
+  {
+    uint32_t codepoint= from[in];
+    std::size_t seqLen;
+
+    if (codepoint < 0x80)
+    {
+      std::size_t ascii= MADB_Utf16ToAscii(from + in, std::min(fromLen - in, toLen - out), to + out);
+      if (ascii == 0)
+      {
+        return TranscodingError(errorcode, E2BIG);
+      }
+      in+= ascii;
+      out+= ascii;
+      continue;
+    }
+    if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+    {
+      if (codepoint > 0xDBFF)
+      {
+        return TranscodingError(errorcode, EILSEQ);
+      }
+      if (in + 1 == fromLen)
+      {
+        return TranscodingError(errorcode, EINVAL);
+      }
+      if (from[in + 1] < 0xDC00 || from[in + 1] > 0xDFFF)
+      {
+        return TranscodingError(errorcode, EILSEQ);
+      }
+      codepoint= 0x10000 + ((codepoint - 0xD800) << 10) + (from[in + 1] - 0xDC00);
+      ++in;
+    }
+    seqLen= codepoint < 0x800 ? 2 : (codepoint < 0x10000 ? 3 : 4);
+    if (toLen - out < seqLen)
+    {
+      return TranscodingError(errorcode, E2BIG);
+    }
+    for (std::size_t i= seqLen - 1; i > 0; --i)
+    {
+      to[out + i]= static_cast<char>(0x80 | (codepoint & 0x3F));
+      codepoint>>= 6;
+    }
+    to[out]= static_cast<char>(((0xFF00 >> seqLen) & 0xFF) | codepoint);
+    out+= seqLen;
+    ++in;
+  }
+  return out;
+}
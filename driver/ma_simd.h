@@ -0,0 +1,43 @@
+/************************************************************************************
+   Copyright (C) 2024 MariaDB Corporation plc
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public
+   License along with this library; if not see <http://www.gnu.org/licenses>
+   or write to the Free Software Foundation, Inc.,
+   51 Franklin St., Fifth Floor, Boston, MA 02110, USA
+*************************************************************************************/
+#ifndef _ma_simd_h_
+#define _ma_simd_h_
+
+#include <cstddef>
+#include <cstdint>
+
+/* Vectorized scanning of strings. Implementation is chosen once, at first use, according to the CPU - AVX2 or SSE2
+   on x86_64, NEON on aarch64, and plain loops everywhere else */
+
+/* Number of 16 bit units before the first zero unit, or maxLen if there is no zero among first maxLen units */
+std::size_t MADB_Utf16Len(const uint16_t *str, std::size_t maxLen);
+/* Number of leading bytes < 0x80 among first len bytes of the string */
+std::size_t MADB_AsciiPrefixLen(const char *str, std::size_t len);
+/* Widens len ASCII bytes to 16 bit units in the host byte order, i.e. to UTF-16 of the platform */
+void        MADB_AsciiToUtf16(const char *src, std::size_t len, uint16_t *dst);
+/* Narrows leading units < 0x80 among first len units to bytes. Returns number of narrowed units */
+std::size_t MADB_Utf16ToAscii(const uint16_t *src, std::size_t len, char *dst);
+
+/* UTF-8 <-> UTF-16 of the platform transcoding, runs of ASCII go thru the kernels above. Both return number of units
+   written to the "to" buffer, or (size_t)-1 and EILSEQ, EINVAL or E2BIG errorcode, like iconv does, if the source is
+   invalid, incomplete, or the result doesn't fit. errorcode may be NULL */
+std::size_t MADB_Utf8ToUtf16(const char *from, std::size_t fromLen, uint16_t *to, std::size_t toLen, int *errorcode);
+std::size_t MADB_Utf16ToUtf8(const uint16_t *from, std::size_t fromLen, char *to, std::size_t toLen, int *errorcode);
+
+#endif
@@ -23,10 +23,15 @@
 #include "ResultSetMetaData.h"
 #include "interface/Exception.h"
 #include "Protocol.h"
+#include "WorkerPool.h"
 
 #include "ma_odbc.h"
 
 #define MADB_MIN_QUERY_LEN 5
+/* Minimal number of rows for a thread to convert, when the rowset conversion is done in parallel */
+#define MADB_MIN_ROWS_PER_FETCH_TASK 64
+/* Maximal number of dropped statements a connection keeps for reuse */
+#define MADB_STMT_POOL_SIZE 16
 
 
 /* {{{ MADB_StmtBulkOperations */
@@ -85,6 +90,7 @@ SQLRETURN MADB_StmtFree(MADB_Stmt *Stmt, SQLUSMALLINT Option)
         MDBUG_C_PRINT(Stmt->Connection, "Closing resultset", Stmt->stmt.get());
         try
         {
+          Stmt->stmt->cancelPrefetch();
           // TODO: that's not right to mess here with Protocol's lock. Protocol should take care of that
           std::lock_guard<std::mutex> localScopeLock(Stmt->Connection->guard->getLock());
           Stmt->rs.reset();
@@ -112,6 +118,7 @@ SQLRETURN MADB_StmtFree(MADB_Stmt *Stmt, SQLUSMALLINT Option)
   case SQL_UNBIND:
     MADB_FREE(Stmt->result);
     MADB_DescFree(Stmt->Ard, TRUE);
+    Stmt->FetchScratch.clear();
     break;
 
   case SQL_RESET_PARAMS:
@@ -134,24 +141,17 @@ SQLRETURN MADB_StmtFree(MADB_Stmt *Stmt, SQLUSMALLINT Option)
     {
       std::lock_guard<std::mutex> localScopeLock(Stmt->Connection->ListsCs);
       RemoveStmtRefFromDesc(Stmt->Apd, Stmt, TRUE);
-      MADB_DescFree(Stmt->IApd, FALSE);
-    }
-    else
-    {
-      MADB_DescFree( Stmt->Apd, FALSE);
     }
     if (Stmt->Ard->AppType)
     {
       std::lock_guard<std::mutex> localScopeLock(Stmt->Connection->ListsCs);
       RemoveStmtRefFromDesc(Stmt->Ard, Stmt, TRUE);
-      MADB_DescFree(Stmt->IArd, FALSE);
     }
-    else
-    {
-      MADB_DescFree(Stmt->Ard, FALSE);
-    }
-    MADB_DescFree(Stmt->Ipd, FALSE);
-    MADB_DescFree(Stmt->Ird, FALSE);
+    /* Implicit descriptors are reset, and not freed, if the statement goes to the connection's pool */
+    MADB_DescReset(Stmt->IApd);
+    MADB_DescReset(Stmt->IArd);
+    MADB_DescReset(Stmt->IIpd);
+    MADB_DescReset(Stmt->IIrd);
 
     MADB_FREE(Stmt->CharOffset);
     MADB_FREE(Stmt->Lengths);
@@ -169,10 +169,24 @@ SQLRETURN MADB_StmtFree(MADB_Stmt *Stmt, SQLUSMALLINT Option)
       MADB_STMT_CLOSE_STMT(Stmt);
     }
     /* Query has to be deleted after multistmt handles are closed, since the depends on info in the Query */
-    std::lock_guard<std::mutex> localScopeLock(Stmt->Connection->ListsCs);
-    Stmt->Connection->Stmts= MADB_ListDelete(Stmt->Connection->Stmts, &Stmt->ListItem);
-    
-    delete Stmt;
+    MADB_Dbc *Dbc= Stmt->Connection;
+    std::lock_guard<std::mutex> localScopeLock(Dbc->ListsCs);
+    Dbc->Stmts= MADB_ListDelete(Dbc->Stmts, &Stmt->ListItem);
+
+    if (Dbc->FreeStmts.size() < MADB_STMT_POOL_SIZE)
+    {
+      MADB_Dbc::StmtShell Shell= {Stmt, Stmt->IApd, Stmt->IArd, Stmt->IIpd, Stmt->IIrd};
+      Stmt->~MADB_Stmt();
+      Dbc->FreeStmts.push_back(Shell);
+    }
+    else
+    {
+      MADB_DescFree(Stmt->IApd, FALSE);
+      MADB_DescFree(Stmt->IArd, FALSE);
+      MADB_DescFree(Stmt->IIpd, FALSE);
+      MADB_DescFree(Stmt->IIrd, FALSE);
+      delete Stmt;
+    }
   } /* End of switch (Option) */
   return SQL_SUCCESS;
 }
@@ -444,6 +458,7 @@ SQLRETURN MADB_Stmt::Prepare(const char *StatementText, SQLINTEGER TextLength, b
 
   MADB_ResetParser(this, StatementText, TextLength);
   MADB_ParseQuery(&Query);
+  BulkAtomic= -1;
 
   if ((Query.QueryType == MADB_QUERY_INSERT || Query.QueryType == MADB_QUERY_UPDATE || Query.QueryType == MADB_QUERY_DELETE)
     && MADB_FindToken(&Query, "RETURNING"))
@@ -931,9 +946,21 @@ SQLRETURN MADB_DoExecute(MADB_Stmt *Stmt)
   }
   try
   {
-    if (MADB_STMT_SHOULD_STREAM(Stmt))
+    /* Limits the memory stored results take, 0 means no limit */
+    Stmt->stmt->setResultMemoryLimit(static_cast<std::size_t>(Stmt->Connection->Dsn->SpillMemory) * 1024 * 1024);
+    Stmt->stmt->setPrefetchThreshold(static_cast<std::size_t>(Stmt->Connection->Dsn->PrefetchStopKb) * 1024);
+    if (MADB_STMT_CURSOR_FETCH(Stmt) && Stmt->stmt->isServerSide())
     {
-      Stmt->stmt->setFetchSize(1); // TODO: In ds should be possible to set number of rows to fetch at once
+      /* Rows are fetched in batches over the cursor, and the result does not hold the connection */
+      Stmt->stmt->setCursorFetch(Stmt->Connection->Dsn->CursorFetch);
+    }
+    else
+    {
+      Stmt->stmt->setCursorFetch(0);
+      if (MADB_STMT_SHOULD_STREAM(Stmt))
+      {
+        Stmt->stmt->setFetchSize(1); // TODO: In ds should be possible to set number of rows to fetch at once
+      }
     }
     if (Stmt->stmt->execute())
     {
@@ -958,6 +985,11 @@ SQLRETURN MADB_DoExecute(MADB_Stmt *Stmt)
     Stmt->State= MADB_SS_OUTPARAMSFETCHED;
     ret= Stmt->GetOutParams(0);
   }
+  else if (Stmt->rs)
+  {
+    /* Next results are read while the application reads this one */
+    Stmt->stmt->prefetchResults();
+  }
   return ret;
 }
 /* }}} */
@@ -966,17 +998,12 @@ void MADB_SetStatusArray(MADB_Stmt *Stmt, SQLUSMALLINT Status)
 {
   if (Stmt->Ipd->Header.ArrayStatusPtr != nullptr)
   {
-    memset(Stmt->Ipd->Header.ArrayStatusPtr, 0x00ff & Status, Stmt->Apd->Header.ArraySize*sizeof(SQLUSMALLINT));
-    if (Stmt->Apd->Header.ArrayStatusPtr != nullptr)
+    unsigned int i;
+    /* Statuses are 2 bytes, memset would do only for SQL_PARAM_SUCCESS */
+    for (i= 0; i < Stmt->Apd->Header.ArraySize; ++i)
     {
-      unsigned int i;
-      for (i= 0; i < Stmt->Apd->Header.ArraySize; ++i)
-      {
-        if (Stmt->Apd->Header.ArrayStatusPtr[i] == SQL_PARAM_IGNORE)
-        {
-          Stmt->Ipd->Header.ArrayStatusPtr[i]= SQL_PARAM_UNUSED;
-        }
-      }
+      Stmt->Ipd->Header.ArrayStatusPtr[i]= (Stmt->Apd->Header.ArrayStatusPtr != nullptr &&
+        Stmt->Apd->Header.ArrayStatusPtr[i] == SQL_PARAM_IGNORE) ? SQL_PARAM_UNUSED : Status;
     }
   }
 }
@@ -1024,9 +1051,18 @@ SQLRETURN MADB_StmtExecute(MADB_Stmt *Stmt, bool ExecDirect)
                /* Will use it for STMT_ATTR_ARRAY_SIZE and as indicator if we are deploying MariaDB bulk insert feature */
   unsigned int MariadbArrSize= MADB_BulkInsertPossible(Stmt) ? (unsigned int)Stmt->Apd->Header.ArraySize : 0;
   SQLULEN      j, Start= Stmt->ArrayOffset;
+  const bool   ContinueOnError= Stmt->Options.ContinueOnError == SQL_TRUE && Stmt->Apd->Header.ArraySize > 1;
+  std::vector<MADB_Error> RowErrors;
 
   MDBUG_C_PRINT(Stmt->Connection, "%sMADB_StmtExecute", "\t->");
 
+  /* Failed parameter sets are looked for by executing parts of the array again. If the failed bulk execution may have
+     applied some rows, that is not possible, and the array goes row by row from the start */
+  if (MariadbArrSize > 0 && ContinueOnError && !MADB_BulkIsAtomic(Stmt))
+  {
+    MariadbArrSize= 0;
+  }
+
   MADB_CLEAR_ERROR(&Stmt->Error);
 
   if (MADB_POSITIONED_COMMAND(Stmt))
@@ -1064,30 +1100,42 @@ SQLRETURN MADB_StmtExecute(MADB_Stmt *Stmt, bool ExecDirect)
     }
     Stmt->Bulk.ArraySize=  MariadbArrSize;
     Stmt->Bulk.HasRowsToSkip= 0;
+    Stmt->Bulk.LoadData= false;
   }
 
   if (MADB_DOING_BULK_OPER(Stmt))
   {
-    if (!SQL_SUCCEEDED(MADB_ExecuteBulk(Stmt, ParamOffset)))
+    if (!SQL_SUCCEEDED(ret= MADB_ExecuteBulk(Stmt, ParamOffset)))
     {
       /* Doing just the same thing as we would do in general case */
       MADB_CleanBulkOperData(Stmt, ParamOffset);
-      ErrorCount= (unsigned int)Stmt->Apd->Header.ArraySize;
-      MADB_SetStatusArray(Stmt, SQL_PARAM_DIAG_UNAVAILABLE);
-      goto end;
+      /* Looking for failed parameter sets makes sense only if the server has failed the execution */
+      if (!ContinueOnError || Stmt->Error.NativeError == 0)
+      {
+        ErrorCount= (unsigned int)Stmt->Apd->Header.ArraySize;
+        MADB_SetStatusArray(Stmt, SQL_PARAM_DIAG_UNAVAILABLE);
+        goto end;
+      }
+      ErrorCount= MADB_ExecuteBulkByParts(Stmt, ParamOffset, MariadbArrSize, RowErrors);
     }
-    else if (!Stmt->rs)
+    else
     {
-      Stmt->AffectedRows+= Stmt->stmt->getUpdateCount();
+      /* LOAD DATA has counted affected rows already */
+      if (!Stmt->rs && !Stmt->Bulk.LoadData)
+      {
+        Stmt->AffectedRows+= Stmt->stmt->getUpdateCount();
+      }
+      /* Suboptimal, but more reliable and simple */
+      MADB_CleanBulkOperData(Stmt, ParamOffset);
+      /* Warnings of LOAD DATA are not attributed to parameter sets */
+      MADB_SetStatusArray(Stmt, ret == SQL_SUCCESS ? SQL_PARAM_SUCCESS : SQL_PARAM_DIAG_UNAVAILABLE);
+      IntegralRc= ret;
     }
-    /* Suboptimal, but more reliable and simple */
-    MADB_CleanBulkOperData(Stmt, ParamOffset);
     Stmt->ArrayOffset+= (int)Stmt->Apd->Header.ArraySize;
     if (Stmt->Ipd->Header.RowsProcessedPtr)
     {
       *Stmt->Ipd->Header.RowsProcessedPtr= *Stmt->Ipd->Header.RowsProcessedPtr + Stmt->Apd->Header.ArraySize;
     }
-    MADB_SetStatusArray(Stmt, SQL_PARAM_SUCCESS);
   }
   else
   {
@@ -1152,6 +1200,14 @@ SQLRETURN MADB_StmtExecute(MADB_Stmt *Stmt, bool ExecDirect)
             else
             {
               ++ErrorCount;
+              if (ContinueOnError)
+              {
+                /* Conversion error is reported for the parameter, and the parameter set is skipped */
+                RowErrors.push_back(Stmt->Error);
+                RowErrors.back().RowNumber=    static_cast<SQLLEN>(j - Start + 1);
+                RowErrors.back().ColumnNumber= static_cast<SQLINTEGER>(i - ParamOffset + 1);
+                break;
+              }
             }
             goto end;
           }
@@ -1159,6 +1215,17 @@ SQLRETURN MADB_StmtExecute(MADB_Stmt *Stmt, bool ExecDirect)
         }
       }                 /* End of for() on parameters */
 
+      if (i < ParamOffset + MADB_STMT_PARAM_COUNT(Stmt))
+      {
+        /* Parameters conversion has failed, and we go on with next parameter set */
+        ++Stmt->ArrayOffset;
+        if (Stmt->Ipd->Header.ArrayStatusPtr)
+        {
+          Stmt->Ipd->Header.ArrayStatusPtr[j - Start]= SQL_PARAM_ERROR;
+        }
+        continue;
+      }
+
       if (Stmt->RebindParams && MADB_STMT_PARAM_COUNT(Stmt))
       {
         // TODO: was it really needed
@@ -1176,10 +1243,15 @@ SQLRETURN MADB_StmtExecute(MADB_Stmt *Stmt, bool ExecDirect)
       if (!SQL_SUCCEEDED(ret))
       {
         ++ErrorCount;
+        if (ContinueOnError)
+        {
+          RowErrors.push_back(Stmt->Error);
+          RowErrors.back().RowNumber= static_cast<SQLLEN>(j - Start + 1);
+        }
         if (Stmt->Ipd->Header.ArrayStatusPtr)
         {
           Stmt->Ipd->Header.ArrayStatusPtr[j - Start]= 
-            (j == Start + Stmt->Apd->Header.ArraySize - 1) ? SQL_PARAM_ERROR : SQL_PARAM_DIAG_UNAVAILABLE;
+            (ContinueOnError || j == Start + Stmt->Apd->Header.ArraySize - 1) ? SQL_PARAM_ERROR : SQL_PARAM_DIAG_UNAVAILABLE;
         }
         if (j == Start + Stmt->Apd->Header.ArraySize - 1)
         {
@@ -1214,6 +1286,15 @@ end:
       IntegralRc= SQL_ERROR;
   }
 
+  if (!RowErrors.empty())
+  {
+    /* Each failed parameter set gets own record, in the order of parameter sets */
+    Stmt->Error= RowErrors.front();
+    Stmt->DiagRecords.assign(RowErrors.begin() + 1, RowErrors.end());
+    Stmt->Error.ExtraRecords= static_cast<unsigned int>(Stmt->DiagRecords.size());
+    Stmt->Error.ReturnValue=  IntegralRc;
+  }
+
   if (IntegralRc == SQL_NEED_DATA && !Stmt->stmt->isServerSide()) {
     
     try {
@@ -1422,9 +1503,31 @@ BOOL MADB_BinaryFieldType(SQLSMALLINT FieldType)
 }
 /* }}} */
 
+/* {{{ MADB_ScratchBuffers::get */
+char* MADB_ScratchBuffers::get(std::size_t Slot, std::size_t Column, std::size_t Size)
+{
+  if (Slot >= Slots.size())
+  {
+    Slots.resize(Slot + 1);
+  }
+  std::vector<Buffer> &Columns= Slots[Slot];
+  if (Column >= Columns.size())
+  {
+    Columns.resize(Column + 1);
+  }
+  Buffer &Buf= Columns[Column];
+  if (Buf.Size < Size)
+  {
+    Buf.Data.reset(new (std::nothrow) char[Size]());
+    Buf.Size= Buf.Data ? Size : 0;
+  }
+  return Buf.Data.get();
+}
+/* }}} */
+
 /* {{{ MADB_Stmt::PrepareBind
-       Filling bind structures in */
-void MADB_Stmt::PrepareBind(int32_t RowNumber)
+       Filling bind structures in. Values, that need conversion, are fetched to the ScratchSlot buffers */
+void MADB_Stmt::PrepareBind(int32_t RowNumber, std::size_t ScratchSlot)
 {
   MADB_DescRecord *IrdRec, *ArdRec;
   int             i;
@@ -1432,6 +1535,8 @@ void MADB_Stmt::PrepareBind(int32_t RowNumber)
   bool            canDoCallbacks= Connection->Dsn->ResultCallbacks && !rs->setCallbackData((void*)this),
     didCallbacks= false;
 
+  resultCodec.resize(MADB_STMT_COLUMN_COUNT(this));
+
   for (i= 0; i < MADB_STMT_COLUMN_COUNT(this); ++i)
   {
     SQLSMALLINT ConciseType;
@@ -1444,15 +1549,16 @@ void MADB_Stmt::PrepareBind(int32_t RowNumber)
     if (ArdRec == nullptr || !ArdRec->inUse)
     {      
       result[i].flags|= MADB_BIND_DUMMY;
+      setResultCodec(nullptr, i);
       continue;
     }
 
     DataPtr= (SQLLEN *)GetBindOffset(Ard->Header, ArdRec->DataPtr, RowNumber, ArdRec->OctetLength);
 
-    MADB_FREE(ArdRec->InternalBuffer);
     if (!DataPtr)
     {
       result[i].flags|= MADB_BIND_DUMMY;
+      setResultCodec(nullptr, i);
       continue;
     }
     else
@@ -1471,52 +1577,46 @@ void MADB_Stmt::PrepareBind(int32_t RowNumber)
 
     DescArrayIterator cit(Ard->Header, *ArdRec, RowNumber);
 
-    switch(ConciseType) {
-    case SQL_C_WCHAR:
-      switch (IrdRec->ConciseType)
+    if (canDoCallbacks)
+    {
+      const MYSQL_FIELD *field= metadata->getField(i);
+      BoundRCodec *codec= resultCodec[i].get();
+
+      /* Codec is created once per binding, for next rows it's only moved to the row's buffers */
+      if (codec != nullptr && codec->fits(ArdRec, ConciseType, field))
       {
-      case WCHAR_TYPES:
-      case CHAR_BINARY_TYPES:
-        if (canDoCallbacks)
-        {
-          setResultCodec(new WcharRCodec(IrdRec, cit), i);
-          didCallbacks=  true;
-          break;
-        }
-      default:
-        /* In worst case for 2 bytes of UTF16 in result, we need 3 bytes of utf8.
-            For ASCII  we need 2 times less(for 2 bytes of UTF16 - 1 byte UTF8,
-            in other cases we need same 2 of 4 bytes. */
-        ArdRec->InternalBuffer=        (char *)MADB_CALLOC((size_t)((ArdRec->OctetLength) * 1.5));
-        result[i].buffer=        ArdRec->InternalBuffer;
-        result[i].buffer_length= (unsigned long)(ArdRec->OctetLength * 1.5);
-        result[i].buffer_type=   MYSQL_TYPE_STRING;
+        codec->moveTo(cit);
       }
-      break;
-    case SQL_C_CHAR:
-      switch (IrdRec->ConciseType)
+      else
       {
-      case WCHAR_TYPES:
-      case CHAR_BINARY_TYPES:
-        // If we only need to copy strings - just to avoid alloc and double copy, as strings can be long
-        if (canDoCallbacks)
-        {
-          setResultCodec(new StringRCodec(IrdRec, cit), i);
-          didCallbacks=  true;
-          break;
-        }
-      default:
-        result[i].buffer=        DataPtr;
-        result[i].buffer_length= (unsigned long)ArdRec->OctetLength;
-        result[i].buffer_type=   MYSQL_TYPE_STRING;
+        codec= createResultCodec(IrdRec, field, ConciseType, cit);
       }
+      setResultCodec(codec, i);
+      if (codec != nullptr)
+      {
+        result[i].flags|= MADB_BIND_DUMMY;
+        didCallbacks= true;
+        continue;
+      }
+    }
+
+    switch(ConciseType) {
+    case SQL_C_WCHAR:
+      /* In worst case for 2 bytes of UTF16 in result, we need 3 bytes of utf8.
+          For ASCII  we need 2 times less(for 2 bytes of UTF16 - 1 byte UTF8,
+          in other cases we need same 2 of 4 bytes. */
+      result[i].buffer_length= (unsigned long)(ArdRec->OctetLength * 1.5);
+      result[i].buffer=        FetchScratch.get(ScratchSlot, i, MAX(result[i].buffer_length, 1));
+      result[i].buffer_type=   MYSQL_TYPE_STRING;
+      break;
+    case SQL_C_CHAR:
+      result[i].buffer=        DataPtr;
+      result[i].buffer_length= (unsigned long)ArdRec->OctetLength;
+      result[i].buffer_type=   MYSQL_TYPE_STRING;
       break;
     case SQL_C_NUMERIC:
-      MADB_FREE(ArdRec->InternalBuffer);
       result[i].buffer_length= MADB_DEFAULT_PRECISION + 1/*-*/ + 1/*.*/;
-      ArdRec->InternalBuffer=       (char *)MADB_CALLOC(result[i].buffer_length);
-      result[i].buffer=        ArdRec->InternalBuffer;
-      
+      result[i].buffer=        FetchScratch.get(ScratchSlot, i, result[i].buffer_length);
       result[i].buffer_type=   MYSQL_TYPE_STRING;
       break;
     case SQL_TYPE_TIMESTAMP:
@@ -1525,26 +1625,23 @@ void MADB_Stmt::PrepareBind(int32_t RowNumber)
     case SQL_C_TIMESTAMP:
     case SQL_C_TIME:
     case SQL_C_DATE:
-      MADB_FREE(ArdRec->InternalBuffer);
       if (IrdRec->ConciseType == SQL_CHAR || IrdRec->ConciseType == SQL_VARCHAR)
       {
         const MYSQL_FIELD *field= metadata->getField(i);
         result[i].buffer_length= (field->max_length != 0 ?
           field->max_length : field->length) + 1;
-        ArdRec->InternalBuffer= (char *)MADB_CALLOC(result[i].buffer_length);
-        if (ArdRec->InternalBuffer == nullptr)
+        result[i].buffer= FetchScratch.get(ScratchSlot, i, result[i].buffer_length);
+        if (result[i].buffer == nullptr)
         {
           MADB_SetError(&Error, MADB_ERR_HY001, nullptr, 0);
           throw Error;
         }
-        result[i].buffer=        ArdRec->InternalBuffer;
         result[i].buffer_type=   MYSQL_TYPE_STRING;
       }
       else
       {
-        ArdRec->InternalBuffer=       (char *)MADB_CALLOC(sizeof(MYSQL_TIME));
-        result[i].buffer=        ArdRec->InternalBuffer;
         result[i].buffer_length= sizeof(MYSQL_TIME);
+        result[i].buffer=        FetchScratch.get(ScratchSlot, i, result[i].buffer_length);
         result[i].buffer_type=   MYSQL_TYPE_TIMESTAMP;
       }
       break;
@@ -1552,25 +1649,22 @@ void MADB_Stmt::PrepareBind(int32_t RowNumber)
     case SQL_C_INTERVAL_HOUR_TO_SECOND:
       {
         const MYSQL_FIELD *Field= metadata->getField(i);
-        MADB_FREE(ArdRec->InternalBuffer);
         if (IrdRec->ConciseType == SQL_CHAR || IrdRec->ConciseType == SQL_VARCHAR)
         {
           result[i].buffer_length= (Field->max_length != 0 ?
             Field->max_length : Field->length) + 1;
-          ArdRec->InternalBuffer= (char *)MADB_CALLOC(result[i].buffer_length);
-          if (ArdRec->InternalBuffer == nullptr)
+          result[i].buffer= FetchScratch.get(ScratchSlot, i, result[i].buffer_length);
+          if (result[i].buffer == nullptr)
           {
             MADB_SetError(&Error, MADB_ERR_HY001, nullptr, 0);
             throw Error;
           }
-          result[i].buffer=        ArdRec->InternalBuffer;
           result[i].buffer_type=   MYSQL_TYPE_STRING;
         }
         else
         {
-          ArdRec->InternalBuffer=       (char *)MADB_CALLOC(sizeof(MYSQL_TIME));
-          result[i].buffer=        ArdRec->InternalBuffer;
           result[i].buffer_length= sizeof(MYSQL_TIME);
+          result[i].buffer=        FetchScratch.get(ScratchSlot, i, result[i].buffer_length);
           result[i].buffer_type=   Field && Field->type == MYSQL_TYPE_TIME ? MYSQL_TYPE_TIME : MYSQL_TYPE_TIMESTAMP;
         }
       }
@@ -1591,10 +1685,13 @@ void MADB_Stmt::PrepareBind(int32_t RowNumber)
       {
         /* To keep things simple - we will use internal buffer of the column size, and later(in the FixFetchedValues) will copy (correct part of)
            it to the application's buffer taking care of endianness. Perhaps it'd be better just not to support this type of conversion */
-        MADB_FREE(ArdRec->InternalBuffer);
-        ArdRec->InternalBuffer=        (char *)MADB_CALLOC(IrdRec->OctetLength);
-        result[i].buffer=        ArdRec->InternalBuffer;
         result[i].buffer_length= (unsigned long)IrdRec->OctetLength;
+        result[i].buffer=        FetchScratch.get(ScratchSlot, i, MAX(result[i].buffer_length, 1));
+        /* Shorter value has to be padded with zeroes in front, what FixFetchedValues counts on */
+        if (result[i].buffer != nullptr)
+        {
+          memset(result[i].buffer, 0, result[i].buffer_length);
+        }
         result[i].buffer_type=   MYSQL_TYPE_BLOB;
         break;
       }
@@ -1612,10 +1709,14 @@ void MADB_Stmt::PrepareBind(int32_t RowNumber)
                                                             &result[i].buffer_length);
       break;
     }
-    if (didCallbacks)
+  }
+  if (didCallbacks)
+  {
+    if (!nullRCodec)
     {
-      setResultCodec(new NullRCodec(ArdRec));
+      nullRCodec.reset(new NullRCodec(nullptr));
     }
+    setResultCodec(nullRCodec.get());
   }
 }
 /* }}} */
@@ -1644,6 +1745,17 @@ void SwitchEndianness(char *Src, SQLLEN SrcBytes, char *Dst, SQLLEN DstBytes)
 /* {{{ MADB_Stmt::FixFetchedValues 
        Converting and/or fixing fetched values if needed */
 SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
+{
+  return FixFetchedValues(RowNumber, SaveCursor, result, Error, aggRc);
+}
+/* }}} */
+
+/* {{{ MADB_Stmt::FixFetchedValues
+       Does the job for the row, which fetched values are in Result bind array. Values, that need conversion, are in the
+       scratch buffers Result points to. Does not change the statement, and can be run for different rows in parallel,
+       if SaveCursor is -1 */
+SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor, MYSQL_BIND* Result, MADB_Error& Err,
+  SQLRETURN& AggRc)
 {
   MADB_DescRecord *IrdRec, *ArdRec;
   int             i;
@@ -1654,7 +1766,7 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
   for (i= 0; i < MADB_STMT_COLUMN_COUNT(this); ++i)
   {
     if ((ArdRec= MADB_DescGetInternalRecord(Ard, i, MADB_DESC_READ)) && ArdRec->inUse &&
-      resultCodec.find(static_cast<uint32_t>(i)) == resultCodec.end())
+      (static_cast<std::size_t>(i) >= resultCodec.size() || !resultCodec[i]))
     {
       /* set indicator and dataptr */
       LengthPtr=    (SQLLEN *)GetBindOffset(Ard->Header, ArdRec->OctetLengthPtr, RowNumber, sizeof(SQLLEN));
@@ -1673,8 +1785,9 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
 
       IrdRec= MADB_DescGetInternalRecord(Ird, i, MADB_DESC_READ);
       /* assert(IrdRec != NULL) */
+      char *InternalBuffer= static_cast<char*>(Result[i].buffer);
 
-      if (*result[i].is_null)
+      if (*Result[i].is_null)
       {
         if (IndicatorPtr)
         {
@@ -1686,7 +1799,7 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
           {
             rs->absolute(SaveCursor);
           }
-          aggRc= MADB_SetError(&Error, MADB_ERR_22002, NULL, 0);
+          AggRc= MADB_SetError(&Err, MADB_ERR_22002, NULL, 0);
           continue;
         }
       }
@@ -1696,7 +1809,7 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
         {
         case SQL_C_BIT:
         {
-          char *p= (char *)result[i].buffer;
+          char *p= (char *)Result[i].buffer;
           if (p)
           {
             // Since it's temporily anyway(before fixed in server). For text protocol it can and should be cared in the resultset class
@@ -1728,28 +1841,28 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
 
               try
               {
-                MADB_Str2Ts(ArdRec->InternalBuffer, *result[i].length, &tm, FALSE, &Error, &isTime);
+                MADB_Str2Ts(InternalBuffer, *Result[i].length, &tm, FALSE, &Err, &isTime);
                 Intermidiate= &tm;
               }
               catch (MADB_Error& /*Err*/)
               {
-                CALC_ALL_FLDS_RC(aggRc, SQL_ERROR);
+                CALC_ALL_FLDS_RC(AggRc, SQL_ERROR);
                 break;
               }
             }
             else
             {
-              Intermidiate= (MYSQL_TIME *)ArdRec->InternalBuffer;
+              Intermidiate= (MYSQL_TIME *)InternalBuffer;
             }
 
-            FieldRc= MADB_CopyMadbTimestamp(this, Intermidiate, DataPtr, LengthPtr, IndicatorPtr, ArdRec->Type, IrdRec->ConciseType);
-            CALC_ALL_FLDS_RC(aggRc, FieldRc);
+            FieldRc= MADB_CopyMadbTimestamp(&Err, Intermidiate, DataPtr, LengthPtr, IndicatorPtr, ArdRec->Type, IrdRec->ConciseType);
+            CALC_ALL_FLDS_RC(AggRc, FieldRc);
           }
           break;
         case SQL_C_INTERVAL_HOUR_TO_MINUTE:
         case SQL_C_INTERVAL_HOUR_TO_SECOND:
         {
-          MYSQL_TIME          *tm= (MYSQL_TIME*)ArdRec->InternalBuffer, ForConversion;
+          MYSQL_TIME          *tm= (MYSQL_TIME*)InternalBuffer, ForConversion;
           SQL_INTERVAL_STRUCT *ts= (SQL_INTERVAL_STRUCT *)DataPtr;
 
           if (IrdRec->ConciseType == SQL_CHAR || IrdRec->ConciseType == SQL_VARCHAR)
@@ -1758,12 +1871,12 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
 
             try
             {
-              MADB_Str2Ts(ArdRec->InternalBuffer, *result[i].length, &ForConversion, FALSE, &Error, &isTime);
+              MADB_Str2Ts(InternalBuffer, *Result[i].length, &ForConversion, FALSE, &Err, &isTime);
               tm= &ForConversion;
             }
             catch (MADB_Error &/*Err*/)
             {
-              CALC_ALL_FLDS_RC(aggRc, SQL_ERROR);
+              CALC_ALL_FLDS_RC(AggRc, SQL_ERROR);
               break;
             }
           }
@@ -1773,8 +1886,8 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
           {
             if (tm->hour > 99999)
             {
-              FieldRc= MADB_SetError(&Error, MADB_ERR_22015, NULL, 0);
-              CALC_ALL_FLDS_RC(aggRc, FieldRc);
+              FieldRc= MADB_SetError(&Err, MADB_ERR_22015, NULL, 0);
+              CALC_ALL_FLDS_RC(AggRc, FieldRc);
               break;
             }
 
@@ -1788,8 +1901,8 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
               ts->interval_type= /*SQLINTERVAL::*/SQL_IS_HOUR_TO_MINUTE;
               if (tm->second)
               {
-                FieldRc= MADB_SetError(&Error, MADB_ERR_01S07, NULL, 0);
-                CALC_ALL_FLDS_RC(aggRc, FieldRc);
+                FieldRc= MADB_SetError(&Err, MADB_ERR_01S07, NULL, 0);
+                CALC_ALL_FLDS_RC(AggRc, FieldRc);
                 break;
               }
             }
@@ -1806,50 +1919,56 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
         case SQL_C_NUMERIC:
         {
           int LocalRc= 0;
-          MADB_CLEAR_ERROR(&Error);
-          if (DataPtr != NULL && result[i].buffer_length < *result[i].length)
+          MADB_CLEAR_ERROR(&Err);
+          if (DataPtr != NULL && Result[i].buffer_length < *Result[i].length)
           {
-            MADB_SetError(&Error, MADB_ERR_22003, NULL, 0);
-            ArdRec->InternalBuffer[result[i].buffer_length - 1]= 0;
-            return Error.ReturnValue;
+            MADB_SetError(&Err, MADB_ERR_22003, NULL, 0);
+            InternalBuffer[Result[i].buffer_length - 1]= 0;
+            return Err.ReturnValue;
           }
 
-          if ((LocalRc= MADB_CharToSQLNumeric(ArdRec->InternalBuffer, Ard, ArdRec, NULL, RowNumber)))
+          if (DataPtr != NULL)
           {
-            FieldRc= MADB_SetError(&Error, LocalRc, NULL, 0);
-            CALC_ALL_FLDS_RC(aggRc, FieldRc);
+            SQL_NUMERIC_STRUCT *Number= static_cast<SQL_NUMERIC_STRUCT*>(DataPtr);
+            MADB_NumericInit(Number, ArdRec);
+            /* The value is not null-terminated, if it takes the whole buffer - its length has to be used */
+            if ((LocalRc= MADB_DecimalToNumeric(InternalBuffer, *Result[i].length, Number)))
+            {
+              FieldRc= MADB_SetError(&Err, LocalRc, NULL, 0);
+              CALC_ALL_FLDS_RC(AggRc, FieldRc);
+            }
           }
           /* TODO: why is it here individually for Numeric type?! */
           if (Ard->Header.ArrayStatusPtr)
           {
-            Ard->Header.ArrayStatusPtr[RowNumber]= Error.ReturnValue;
+            Ard->Header.ArrayStatusPtr[RowNumber]= Err.ReturnValue;
           }
           *LengthPtr= sizeof(SQL_NUMERIC_STRUCT);
         }
         break;
         case SQL_C_WCHAR:
         {
-          SQLLEN CharLen= *result[i].length;
+          SQLLEN CharLen= *Result[i].length;
           /* If app buffer len(ArdRec->OctetLength) == 0, we don't have to write there anything.
            * Besides we had allocated buffer of 1. And if we try to calculate chars number based on the result string
-           * full length from *result[i].length, it can get reading past the end of allocated buffer.
+           * full length from *Result[i].length, it can get reading past the end of allocated buffer.
            */
           if (ArdRec->OctetLength)
           {
-            CharLen= MADB_SetString(&Connection->Charset, DataPtr, ArdRec->OctetLength / sizeof(SQLWCHAR), (char *)result[i].buffer,
-              *result[i].length, &Error);
+            CharLen= MADB_SetString(&Connection->Charset, DataPtr, ArdRec->OctetLength / sizeof(SQLWCHAR), (char *)Result[i].buffer,
+              *Result[i].length, &Err);
           }
           /* If returned len is 0 while source len is not - taking it as error occurred */
           if ((CharLen == 0 ||
-            (SQLULEN)CharLen > (ArdRec->OctetLength / sizeof(SQLWCHAR))) && *result[i].length != 0 && result[i].buffer != NULL &&
-            *(char*)result[i].buffer != '\0' && Error.ReturnValue != SQL_SUCCESS)
+            (SQLULEN)CharLen > (ArdRec->OctetLength / sizeof(SQLWCHAR))) && *Result[i].length != 0 && Result[i].buffer != NULL &&
+            *(char*)Result[i].buffer != '\0' && Err.ReturnValue != SQL_SUCCESS)
           {
-            CALC_ALL_FLDS_RC(aggRc, Error.ReturnValue);
+            CALC_ALL_FLDS_RC(AggRc, Err.ReturnValue);
           }
           /* If application didn't give data buffer and only want to know the length of data to fetch */
-          if (CharLen == 0 && *result[i].length != 0 && result[i].buffer == NULL)
+          if (CharLen == 0 && *Result[i].length != 0 && Result[i].buffer == NULL)
           {
-            CharLen= *result[i].length;
+            CharLen= *Result[i].length;
           }
           /* Not quite right */
           *LengthPtr= CharLen * sizeof(SQLWCHAR);
@@ -1871,19 +1990,19 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
           {
             if (DataPtr != NULL)
             {
-              if (result[i].buffer_length >= (unsigned long)ArdRec->OctetLength)
+              if (Result[i].buffer_length >= (unsigned long)ArdRec->OctetLength)
               {
                 if (LittleEndian())
                 {
                   /* We currently got the bigendian number. If we or littleendian machine, we need to switch bytes */
-                  SwitchEndianness((char*)result[i].buffer + result[i].buffer_length - ArdRec->OctetLength,
+                  SwitchEndianness((char*)Result[i].buffer + Result[i].buffer_length - ArdRec->OctetLength,
                     ArdRec->OctetLength,
                     (char*)DataPtr,
                     ArdRec->OctetLength);
                 }
                 else
                 {
-                  memcpy(DataPtr, (void*)((char*)result[i].buffer + result[i].buffer_length - ArdRec->OctetLength), ArdRec->OctetLength);
+                  memcpy(DataPtr, (void*)((char*)Result[i].buffer + Result[i].buffer_length - ArdRec->OctetLength), ArdRec->OctetLength);
                 }
               }
               else
@@ -1892,18 +2011,18 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
                 memset(DataPtr, 0, ArdRec->OctetLength);
                 if (LittleEndian())
                 {
-                  SwitchEndianness((char*)result[i].buffer,
-                    result[i].buffer_length,
+                  SwitchEndianness((char*)Result[i].buffer,
+                    Result[i].buffer_length,
                     (char*)DataPtr,
                     ArdRec->OctetLength);
                 }
                 else
                 {
-                  memcpy((void*)((char*)DataPtr + ArdRec->OctetLength - result[i].buffer_length),
-                    result[i].buffer, result[i].buffer_length);
+                  memcpy((void*)((char*)DataPtr + ArdRec->OctetLength - Result[i].buffer_length),
+                    Result[i].buffer, Result[i].buffer_length);
                 }
               }
-              *LengthPtr= *result[i].length;
+              *LengthPtr= *Result[i].length;
             }
             break;
           }
@@ -1915,21 +2034,21 @@ SQLRETURN MADB_Stmt::FixFetchedValues(int RowNumber, int64_t SaveCursor)
             {
               if (Ard->Header.BindType)
               {
-                result[i].buffer= (char *)result[i].buffer + Ard->Header.BindType;
+                Result[i].buffer= (char *)Result[i].buffer + Ard->Header.BindType;
               }
               else
               {
-                result[i].buffer= (char *)ArdRec->DataPtr + (RowNumber + 1) * ArdRec->OctetLength;
+                Result[i].buffer= (char *)ArdRec->DataPtr + (RowNumber + 1) * ArdRec->OctetLength;
               }
             }
-            *LengthPtr= *result[i].length;
+            *LengthPtr= *Result[i].length;
           }
           break;
         }
       }
     }
   }
-  return aggRc;
+  return AggRc;
 }
 /* }}} */
 
@@ -1994,6 +2113,105 @@ SQLRETURN MADB_ProcessTruncation(MADB_Stmt *Stmt)
   return SQL_SUCCESS;
 }
 
+/* {{{ MADB_PendingRow
+       The state of the fetched row, that is needed to convert it into application buffers later */
+struct MADB_PendingRow
+{
+  std::vector<MYSQL_BIND> Bind;
+  MADB_Error              Error;
+  unsigned int            RowNum;
+  SQLRETURN               RowResult;
+  SQLRETURN               AggRc;
+  SQLRETURN               ConvertRc;
+};
+/* }}} */
+
+/* {{{ MADB_SaveFetchedRow */
+static void MADB_SaveFetchedRow(MADB_Stmt *Stmt, MADB_PendingRow &Row, unsigned int RowNum, SQLRETURN RowResult)
+{
+  const int ColumnCount= MADB_STMT_COLUMN_COUNT(Stmt);
+
+  /* Values needing conversion stay in the row's own scratch slot, next rows are fetched to other slots */
+  Row.Bind.assign(Stmt->result, Stmt->result + ColumnCount);
+  for (int i= 0; i < ColumnCount; ++i)
+  {
+    Row.Bind[i].length=  &Row.Bind[i].length_value;
+    Row.Bind[i].is_null= &Row.Bind[i].is_null_value;
+  }
+  Row.Error=     Stmt->Error;
+  Row.RowNum=    RowNum;
+  Row.RowResult= RowResult;
+  Row.AggRc=     Stmt->aggRc;
+}
+/* }}} */
+
+/* {{{ MADB_ConvertPendingRows
+       Converts rows, which conversion has been deferred, splitting them between threads of the environment's pool.
+       Then merges rows results into the rowset result and row status array in the order rows have been fetched */
+static SQLRETURN MADB_ConvertPendingRows(MADB_Stmt *Stmt, std::vector<MADB_PendingRow> &Pending, SQLRETURN Result)
+{
+  if (Pending.empty())
+  {
+    return Result;
+  }
+  const std::size_t Tasks= std::max<std::size_t>(1, std::min<std::size_t>(Stmt->Connection->Dsn->FetchThreads,
+                                                                           Pending.size() / MADB_MIN_ROWS_PER_FETCH_TASK)),
+                    Step= (Pending.size() + Tasks - 1) / Tasks;
+  auto Convert= [Stmt, &Pending, Step](std::size_t TaskNr)
+  {
+    const std::size_t End= std::min(Pending.size(), (TaskNr + 1) * Step);
+    for (std::size_t i= TaskNr * Step; i < End; ++i)
+    {
+      MADB_PendingRow &Row= Pending[i];
+      try
+      {
+        Row.ConvertRc= Stmt->FixFetchedValues(Row.RowNum, -1, Row.Bind.data(), Row.Error, Row.AggRc);
+      }
+      catch (...)
+      {
+        Row.ConvertRc= MADB_SetError(&Row.Error, MADB_ERR_HY001, NULL, 0);
+      }
+    }
+  };
+
+  if (Tasks > 1)
+  {
+    Stmt->Connection->Environment->getWorkerPool().run(Tasks, Tasks, Convert);
+  }
+  else
+  {
+    Convert(0);
+  }
+
+  for (auto &Row : Pending)
+  {
+    SQLRETURN RowResult= Row.RowResult;
+
+    switch (Row.ConvertRc)
+    {
+    case SQL_ERROR:
+      RowResult= SQL_ERROR;
+      break;
+    case SQL_SUCCESS_WITH_INFO:
+      RowResult= SQL_SUCCESS_WITH_INFO;
+    }
+    if (Row.ConvertRc != SQL_SUCCESS)
+    {
+      Stmt->Error= Row.Error;
+    }
+    CALC_ALL_ROWS_RC(Result, RowResult, Row.RowNum);
+
+    if (Stmt->Ird->Header.ArrayStatusPtr)
+    {
+      Stmt->Ird->Header.ArrayStatusPtr[Row.RowNum]= MADB_MapToRowStatus(RowResult);
+    }
+  }
+  Pending.clear();
+
+  return Result;
+}
+/* }}} */
+
 /* {{{ MADB_StmtFetch */
 SQLRETURN MADB_StmtFetch(MADB_Stmt *Stmt)
 {
@@ -2025,7 +2243,7 @@ SQLRETURN MADB_StmtFetch(MADB_Stmt *Stmt)
 
   Stmt->LastRowFetched= 0;
   Rows2Fetch= MADB_RowsToFetch(&Stmt->Cursor, Stmt->Ard->Header.ArraySize,
-    MADB_STMT_SHOULD_STREAM(Stmt) ? (unsigned long long)-1 : Stmt->rs->rowsCount());
+    MADB_STMT_SHOULD_STREAM(Stmt) || MADB_STMT_CURSOR_RESULT(Stmt) ? (unsigned long long)-1 : Stmt->rs->rowsCount());
 
   if (Stmt->result == NULL)
   {
@@ -2062,6 +2280,16 @@ SQLRETURN MADB_StmtFetch(MADB_Stmt *Stmt)
 
   *ProcessedPtr= 0;
 
+  /* Conversion of the rowset of the cached result into application buffers can be split between threads. Then it's
+     deferred till all rows of the rowset are fetched */
+  std::vector<MADB_PendingRow> Pending;
+  const bool Parallel= Stmt->Connection->Dsn->FetchThreads > 1 && Rows2Fetch >= 2 * MADB_MIN_ROWS_PER_FETCH_TASK &&
+                       !MADB_STMT_SHOULD_STREAM(Stmt) && !MADB_STMT_CURSOR_RESULT(Stmt) && Stmt->rs->isFullyLoaded();
+  if (Parallel)
+  {
+    Pending.reserve(Rows2Fetch);
+  }
+
   /* We need to return to 1st row in the rowset only if there are >1 rows in it. Otherwise we stay on it anyway */
   if (Rows2Fetch > 1 && Stmt->Options.CursorType != SQL_CURSOR_FORWARD_ONLY)
   {
@@ -2091,7 +2319,7 @@ SQLRETURN MADB_StmtFetch(MADB_Stmt *Stmt)
     /*************** Setting up BIND structures ********************/
     /* Basically, nothing should happen here, but if happens, then it will happen on each row.
     Thus it's ok to stop */
-    Stmt->PrepareBind(RowNum);
+    Stmt->PrepareBind(RowNum, Parallel ? RowNum : 0);
 
     /************************ Bind! ********************************/  
     Stmt->rs->bind(Stmt->result);
@@ -2127,6 +2355,7 @@ SQLRETURN MADB_StmtFetch(MADB_Stmt *Stmt)
         {
           UNLOCK_MARIADB(Stmt->Connection);
         }*/
+        MADB_ConvertPendingRows(Stmt, Pending, Result);
         return SQL_NO_DATA;
       }
       // This is for column results, that can be changed by callbacks(what is done by FixFetchedValues otherwise)
@@ -2140,6 +2369,7 @@ SQLRETURN MADB_StmtFetch(MADB_Stmt *Stmt)
     {
       switch (rc) {
       case 1:
+        Result= MADB_ConvertPendingRows(Stmt, Pending, Result);
         RowResult= MADB_SetNativeError(&Stmt->Error, SQL_HANDLE_STMT, Stmt->stmt.get());
         /* If mysql_stmt_fetch returned error, there is no sense to continue */
         if (Stmt->Ird->Header.ArrayStatusPtr)
@@ -2172,6 +2402,12 @@ SQLRETURN MADB_StmtFetch(MADB_Stmt *Stmt)
     ++Stmt->LastRowFetched;
     ++Stmt->PositionedCursor;
 
+    if (Parallel)
+    {
+      Pending.emplace_back();
+      MADB_SaveFetchedRow(Stmt, Pending.back(), RowNum, RowResult);
+      continue;
+    }
     /*Conversion etc. At this point, after fetch we can have RowResult either SQL_SUCCESS or SQL_SUCCESS_WITH_INFO */
     switch (Stmt->FixFetchedValues(RowNum, SaveCursor))
     {
@@ -2194,6 +2430,8 @@ SQLRETURN MADB_StmtFetch(MADB_Stmt *Stmt)
   {
     UNLOCK_MARIADB(Stmt->Connection);
   }*/
+  Result= MADB_ConvertPendingRows(Stmt, Pending, Result);
+
   memset(Stmt->CharOffset, 0, sizeof(long) * Stmt->metadata->getColumnCount());
   memset(Stmt->Lengths, 0, sizeof(long) * Stmt->metadata->getColumnCount());
 
@@ -2314,6 +2552,12 @@ SQLRETURN MADB_StmtGetAttr(MADB_Stmt *Stmt, SQLINTEGER Attribute, SQLPOINTER Val
   case SQL_ATTR_RETRIEVE_DATA:
     *(SQLULEN *)ValuePtr= SQL_RD_ON;
     break;
+  case SQL_ATTR_MADB_CONTINUE_ON_ERROR:
+    *(SQLULEN *)ValuePtr= Stmt->Options.ContinueOnError;
+    break;
+  case SQL_ATTR_MADB_LOAD_DATA:
+    *(SQLULEN *)ValuePtr= Stmt->Options.LoadData;
+    break;
   }
   return ret;
 }
@@ -2533,6 +2777,12 @@ SQLRETURN MADB_StmtSetAttr(MADB_Stmt *Stmt, SQLINTEGER Attribute, SQLPOINTER Val
     MADB_SetError(&Stmt->Error, MADB_ERR_HYC00, NULL, 0);
     return Stmt->Error.ReturnValue;
     break;
+  case SQL_ATTR_MADB_CONTINUE_ON_ERROR:
+    Stmt->Options.ContinueOnError= (SQLUINTEGER)(SQLULEN)ValuePtr != SQL_FALSE ? SQL_TRUE : SQL_FALSE;
+    break;
+  case SQL_ATTR_MADB_LOAD_DATA:
+    Stmt->Options.LoadData= (SQLUINTEGER)(SQLULEN)ValuePtr != SQL_FALSE ? SQL_TRUE : SQL_FALSE;
+    break;
   default:
     MADB_SetError(&Stmt->Error, MADB_ERR_HY024, NULL, 0);
     return Stmt->Error.ReturnValue;
@@ -2678,24 +2928,15 @@ SQLRETURN MADB_StmtGetData(SQLHSTMT StatementHandle,
 
         Bind.buffer_length= (Field->max_length != 0 ? Field->max_length : Field->length) + 1;
 
-        if (IrdRec->InternalBuffer != NULL)
-        {
-          IrdRec->InternalBuffer= (char*)MADB_REALLOC(IrdRec->InternalBuffer, Bind.buffer_length);
-        }
-        else
-        {
-          IrdRec->InternalBuffer= (char*)MADB_ALLOC(Bind.buffer_length);
-        }
-          
-        if (IrdRec->InternalBuffer == NULL)
+        Bind.buffer= Stmt->GetDataScratch.get(0, Offset, Bind.buffer_length);
+        if (Bind.buffer == NULL)
         {
           return MADB_SetError(&Stmt->Error, MADB_ERR_HY001, NULL, 0);
         }
-        Bind.buffer=        IrdRec->InternalBuffer;
         Bind.buffer_type=   MYSQL_TYPE_STRING;
         Stmt->rs->get(&Bind, Offset, 0);
         // We might need to eat the exception here, but probably not
-        MADB_Str2Ts(IrdRec->InternalBuffer, Bind.length_value, &tm, FALSE, &Stmt->Error, &isTime);
+        MADB_Str2Ts(static_cast<char*>(Bind.buffer), Bind.length_value, &tm, FALSE, &Stmt->Error, &isTime);
       }
       else
       {
@@ -2714,7 +2955,7 @@ SQLRETURN MADB_StmtGetData(SQLHSTMT StatementHandle,
         }
         Stmt->rs->get(&Bind, Offset, 0);
       }
-      RETURN_ERROR_OR_CONTINUE(MADB_CopyMadbTimestamp(Stmt, &tm, TargetValuePtr, StrLen_or_IndPtr, StrLen_or_IndPtr, OdbcType, IrdRec->ConciseType));
+      RETURN_ERROR_OR_CONTINUE(MADB_CopyMadbTimestamp(&Stmt->Error, &tm, TargetValuePtr, StrLen_or_IndPtr, StrLen_or_IndPtr, OdbcType, IrdRec->ConciseType));
       break;
     }
     case SQL_C_INTERVAL_HOUR_TO_MINUTE:
@@ -2730,23 +2971,14 @@ SQLRETURN MADB_StmtGetData(SQLHSTMT StatementHandle,
         Bind.buffer_length= (Field->max_length != 0 ? Field->max_length :
           Field->length) + 1;
 
-        if (IrdRec->InternalBuffer != NULL)
-        {
-          IrdRec->InternalBuffer= (char*)MADB_REALLOC(IrdRec->InternalBuffer, Bind.buffer_length);
-        }
-        else
-        {
-          IrdRec->InternalBuffer= (char*)MADB_ALLOC(Bind.buffer_length);
-        }
-
-        if (IrdRec->InternalBuffer == NULL)
+        Bind.buffer= Stmt->GetDataScratch.get(0, Offset, Bind.buffer_length);
+        if (Bind.buffer == NULL)
         {
           return MADB_SetError(&Stmt->Error, MADB_ERR_HY001, NULL, 0);
         }
-        Bind.buffer=        IrdRec->InternalBuffer;
         Bind.buffer_type=   MYSQL_TYPE_STRING;
         Stmt->rs->get(&Bind, Offset, 0);
-        MADB_Str2Ts(IrdRec->InternalBuffer, Bind.length_value, &tm, TRUE, &Stmt->Error, &isTime);
+        MADB_Str2Ts(static_cast<char*>(Bind.buffer), Bind.length_value, &tm, TRUE, &Stmt->Error, &isTime);
       }
       else
       {
@@ -2907,28 +3139,14 @@ SQLRETURN MADB_StmtGetData(SQLHSTMT StatementHandle,
     case SQL_NUMERIC:
     {
       SQLRETURN rc;
-      char *tmp= NULL;
       MADB_DescRecord *Ard= MADB_DescGetInternalRecord(Stmt->Ard, Offset, MADB_DESC_READ);
 
       Bind.buffer_length= MADB_DEFAULT_PRECISION + 1/*-*/ + 1/*.*/;
-      if (IrdRec->InternalBuffer != NULL)
-      {
-        tmp= (char*)MADB_REALLOC(IrdRec->InternalBuffer, Bind.buffer_length);
-      }
-      else
-      {
-        tmp= (char*)MADB_ALLOC(Bind.buffer_length);
-      }
-
-      if (tmp == NULL)
+      Bind.buffer=        Stmt->GetDataScratch.get(0, Offset, Bind.buffer_length);
+      if (Bind.buffer == NULL)
       {
         return MADB_SetError(&Stmt->Error, MADB_ERR_HY001, NULL, 0);
       }
-      else
-      {
-        IrdRec->InternalBuffer= tmp;
-      }
-      Bind.buffer=        IrdRec->InternalBuffer;
       Bind.buffer_type=   MadbType;
 
       Stmt->rs->get(&Bind, Offset, 0);
@@ -2941,7 +3159,8 @@ SQLRETURN MADB_StmtGetData(SQLHSTMT StatementHandle,
         return Stmt->Error.ReturnValue;
       }
 
-      rc= MADB_CharToSQLNumeric(IrdRec->InternalBuffer, Stmt->Ard, Ard, static_cast<SQL_NUMERIC_STRUCT*>(TargetValuePtr), 0);
+      MADB_NumericInit(static_cast<SQL_NUMERIC_STRUCT*>(TargetValuePtr), Ard);
+      rc= MADB_DecimalToNumeric(static_cast<char*>(Bind.buffer), *Bind.length, static_cast<SQL_NUMERIC_STRUCT*>(TargetValuePtr));
 
       /* Ugly */
       if (rc != SQL_SUCCESS)
@@ -3435,6 +3654,142 @@ SQLRETURN MADB_RefreshDynamicCursor(MADB_Stmt *Stmt)
 #define MADB_SETPOS_AGG_RESULT(agg_result, row_result) if (MADB_SETPOS_FIRSTROW(agg_result)) agg_result= row_result; \
     else if (row_result != agg_result) agg_result= SQL_SUCCESS_WITH_INFO
 
+/* {{{ MADB_RefreshRowset
+       Re-reads rows Start..End of the result with one query, every row by its key values, and writes them into the ARD
+       buffers at their rowset positions. Rows, that the query did not find anymore, get SQL_ROW_DELETED status */
+static SQLRETURN MADB_RefreshRowset(MADB_Stmt *Stmt, char *TableName, my_ulonglong Start, my_ulonglong End)
+{
+  const MYSQL_FIELD *Field=       Stmt->metadata->getFields();
+  const int64_t     SaveRow=      Stmt->rs->getRow();
+  const my_ulonglong FirstInRowset= Stmt->Cursor.Position > 0 ? Stmt->Cursor.Position : 1;
+  std::vector<int>  BoundColumns;
+  std::vector<bool> Found(static_cast<std::size_t>(End - Start + 1), false);
+  SQLString         Columns, Query;
+  MADB_Stmt        *RefreshStmt= nullptr;
+  SQLRETURN         Result=      SQL_INVALID_HANDLE, rc;
+  my_ulonglong      Row;
+
+  for (int column= 0; column < MADB_STMT_COLUMN_COUNT(Stmt); ++column)
+  {
+    MADB_DescRecord *Rec= MADB_DescGetInternalRecord(Stmt->Ard, column, MADB_DESC_READ);
+
+    if (!Rec->inUse || Rec->DataPtr == nullptr)
+    {
+      continue;
+    }
+    if (Field[column].org_name == nullptr || *Field[column].org_name == '\0')
+    {
+      return MADB_SetError(&Stmt->Error, MADB_ERR_HYC00, "Refresh of the columns, that are not table columns, is not supported", 0);
+    }
+    BoundColumns.push_back(column);
+    Columns.append(",`").append(Field[column].org_name).append(1, '`');
+  }
+  if (BoundColumns.empty())
+  {
+    return SQL_SUCCESS;
+  }
+
+  /* (SELECT <rowset position>, <bound columns> FROM <table> WHERE <key of the row> LIMIT 1) UNION ALL (...) */
+  Query.reserve(8192);
+  for (Row= Start; Row <= End; ++Row)
+  {
+    MADB_StmtDataSeek(Stmt, Row);
+    Stmt->Methods->RefreshRowPtrs(Stmt);
+
+    if (Row > Start)
+    {
+      Query.append(" UNION ALL ");
+    }
+    Query.append("(SELECT ").append(std::to_string(Row - FirstInRowset)).append(Columns).append(" FROM `").append(TableName).append(1, '`');
+    if (MADB_DynStrGetWhere(Stmt, Query, TableName, false))
+    {
+      Stmt->rs->absolute(SaveRow);
+      return Stmt->Error.ReturnValue;
+    }
+    Query.append(1, ')');
+  }
+  Stmt->rs->absolute(SaveRow);
+
+  if (!SQL_SUCCEEDED(MA_SQLAllocHandle(SQL_HANDLE_STMT, Stmt->Connection, (SQLHANDLE *)&RefreshStmt)))
+  {
+    return MADB_CopyError(&Stmt->Error, &Stmt->Connection->Error);
+  }
+  if (!SQL_SUCCEEDED(RefreshStmt->Methods->ExecDirect(RefreshStmt, const_cast<char*>(Query.c_str()), SQL_NTS)))
+  {
+    MADB_CopyError(&Stmt->Error, &RefreshStmt->Error);
+    RefreshStmt->Methods->StmtFree(RefreshStmt, SQL_DROP);
+    return Stmt->Error.ReturnValue;
+  }
+
+  while ((rc= RefreshStmt->Methods->Fetch(RefreshStmt)) != SQL_NO_DATA)
+  {
+    SQLUBIGINT RowIdx= 0;
+    SQLRETURN  RowResult= SQL_SUCCESS;
+
+    if (!SQL_SUCCEEDED(rc) ||
+        !SQL_SUCCEEDED(RefreshStmt->Methods->GetData(RefreshStmt, 1, SQL_C_UBIGINT, &RowIdx, 0, nullptr, true)))
+    {
+      MADB_CopyError(&Stmt->Error, &RefreshStmt->Error);
+      Result= SQL_ERROR;
+      break;
+    }
+
+    for (std::size_t i= 0; i < BoundColumns.size(); ++i)
+    {
+      MADB_DescRecord *Rec= MADB_DescGetInternalRecord(Stmt->Ard, BoundColumns[i], MADB_DESC_READ);
+      SQLLEN Indicator= 0;
+
+      rc= RefreshStmt->Methods->GetData(RefreshStmt, static_cast<SQLUSMALLINT>(i + 2), Rec->ConciseType,
+        GetBindOffset(Stmt->Ard->Header, Rec->DataPtr, RowIdx, Rec->OctetLength), Rec->OctetLength, &Indicator, true);
+
+      if (rc != SQL_SUCCESS)
+      {
+        MADB_CopyError(&Stmt->Error, &RefreshStmt->Error);
+        if (!SQL_SUCCEEDED(rc))
+        {
+          RowResult= SQL_ERROR;
+          continue;
+        }
+        RowResult= RowResult == SQL_ERROR ? SQL_ERROR : SQL_SUCCESS_WITH_INFO;
+      }
+      /* As with SQLFetch - NULL can't be returned without the indicator, and the buffer keeps the stale value */
+      if (Indicator == SQL_NULL_DATA && Rec->IndicatorPtr == nullptr)
+      {
+        MADB_SetError(&Stmt->Error, MADB_ERR_22002, nullptr, 0);
+        RowResult= SQL_ERROR;
+        continue;
+      }
+      if (Rec->IndicatorPtr != nullptr)
+      {
+        *static_cast<SQLLEN*>(GetBindOffset(Stmt->Ard->Header, Rec->IndicatorPtr, RowIdx, sizeof(SQLLEN)))= Indicator;
+      }
+      if (Rec->OctetLengthPtr != nullptr && Rec->OctetLengthPtr != Rec->IndicatorPtr && Indicator != SQL_NULL_DATA)
+      {
+        *static_cast<SQLLEN*>(GetBindOffset(Stmt->Ard->Header, Rec->OctetLengthPtr, RowIdx, sizeof(SQLLEN)))= Indicator;
+      }
+    }
+
+    Found[static_cast<std::size_t>(RowIdx - (Start - FirstInRowset))]= true;
+    if (Stmt->Ird->Header.ArrayStatusPtr)
+    {
+      Stmt->Ird->Header.ArrayStatusPtr[RowIdx]= MADB_MapToRowStatus(RowResult);
+    }
+    MADB_SETPOS_AGG_RESULT(Result, RowResult);
+  }
+  RefreshStmt->Methods->StmtFree(RefreshStmt, SQL_DROP);
+
+  for (std::size_t i= 0; i < Found.size(); ++i)
+  {
+    if (!Found[i] && Stmt->Ird->Header.ArrayStatusPtr)
+    {
+      Stmt->Ird->Header.ArrayStatusPtr[Start - FirstInRowset + i]= SQL_ROW_DELETED;
+    }
+  }
+
+  return Result == SQL_INVALID_HANDLE ? SQL_SUCCESS : Result;
+}
+/* }}} */
+
 /* {{{ MADB_SetPos */
 SQLRETURN MADB_StmtSetPos(MADB_Stmt* Stmt, SQLSETPOSIROW RowNumber, SQLUSMALLINT Operation,
   SQLUSMALLINT LockType, int ArrayOffset)
@@ -3771,8 +4126,36 @@ SQLRETURN MADB_StmtSetPos(MADB_Stmt* Stmt, SQLSETPOSIROW RowNumber, SQLUSMALLINT
     }
     break;
   case SQL_REFRESH:
-    /* todo*/
-    break;
+    {
+      char        *TableName= MADB_GetTableName(Stmt);
+      my_ulonglong Start, End= Stmt->rs->rowsCount();
+
+      if (!TableName)
+      {
+        MADB_SetError(&Stmt->Error, MADB_ERR_IM001, "Updatable Cursors with multiple tables are not supported", 0);
+        return Stmt->Error.ReturnValue;
+      }
+      if (RowNumber > End || (SQLLEN)RowNumber > Stmt->LastRowFetched)
+      {
+        MADB_SetError(&Stmt->Error, MADB_ERR_HY109, NULL, 0);
+        return Stmt->Error.ReturnValue;
+      }
+      if (Stmt->Cursor.Position <= 0)
+      {
+        Stmt->Cursor.Position= 1;
+      }
+      /* Row 0 means the whole rowset */
+      if (RowNumber)
+      {
+        Start= End= Stmt->Cursor.Position + RowNumber - 1;
+      }
+      else
+      {
+        Start= Stmt->Cursor.Position;
+        End= MIN(End, Start + MAX(Stmt->LastRowFetched, 1) - 1);
+      }
+      return MADB_RefreshRowset(Stmt, TableName, Start, End);
+    }
   default:
     MADB_SetError(&Stmt->Error, MADB_ERR_HYC00, "Only SQL_POSITION and SQL_REFRESH Operations are supported", 0);
     return Stmt->Error.ReturnValue;
@@ -3885,7 +4268,8 @@ SQLRETURN MADB_StmtFetchScroll(MADB_Stmt *Stmt, SQLSMALLINT FetchOrientation,
     Stmt->Cursor.Position= (SQLLEN)MIN((my_ulonglong)Position, Stmt->rs->rowsCount() + 1);
   }
 
-  if (Position <= 0 || (!MADB_STMT_SHOULD_STREAM(Stmt) && (my_ulonglong)Position > Stmt->rs->rowsCount()))
+  if (Position <= 0 || (!MADB_STMT_SHOULD_STREAM(Stmt) && !MADB_STMT_CURSOR_RESULT(Stmt) &&
+      (my_ulonglong)Position > Stmt->rs->rowsCount()))
   {
     /* We need to put cursor before RS start, not only return error */
     if (Position <= 0)
@@ -3962,6 +4346,21 @@ struct st_ma_stmt_methods MADB_StmtMethods=
   MADB_RefreshRowPtrs
 };
 
+MADB_Error* MADB_Stmt::DiagRecord(SQLSMALLINT RecNumber)
+{
+  if (RecNumber == 1)
+  {
+    return &Error;
+  }
+  if (RecNumber > 1 && static_cast<unsigned int>(RecNumber - 2) < Error.ExtraRecords &&
+      static_cast<std::size_t>(RecNumber - 2) < DiagRecords.size())
+  {
+    return &DiagRecords[RecNumber - 2];
+  }
+  return nullptr;
+}
+
+
 MADB_Stmt::MADB_Stmt(MADB_Dbc * Dbc)
   : Connection(Dbc),
   DefaultsResult(nullptr, &mysql_free_result)
@@ -3976,7 +4375,25 @@ MADB_Stmt::MADB_Stmt(MADB_Dbc * Dbc)
 /* {{{ MADB_StmtInit */
 SQLRETURN MADB_StmtInit(MADB_Dbc *Connection, SQLHANDLE *pHStmt)
 {
-  MADB_Stmt *Stmt= new MADB_Stmt(Connection);
+  MADB_Stmt *Stmt= nullptr;
+  {
+    std::lock_guard<std::mutex> localScopeLock(Connection->ListsCs);
+    if (!Connection->FreeStmts.empty())
+    {
+      /* Statement dropped earlier on this connection - only the object has to be constructed again */
+      MADB_Dbc::StmtShell &Shell= Connection->FreeStmts.back();
+      Stmt= new (Shell.Memory) MADB_Stmt(Connection);
+      Stmt->IApd= Shell.IApd;
+      Stmt->IArd= Shell.IArd;
+      Stmt->IIpd= Shell.IIpd;
+      Stmt->IIrd= Shell.IIrd;
+      Connection->FreeStmts.pop_back();
+    }
+  }
+  if (Stmt == nullptr)
+  {
+    Stmt= new MADB_Stmt(Connection);
+  }
  
   MADB_PutErrorPrefix(Connection, &Stmt->Error);
   *pHStmt= Stmt;
@@ -3984,10 +4401,10 @@ SQLRETURN MADB_StmtInit(MADB_Dbc *Connection, SQLHANDLE *pHStmt)
  
   Stmt->stmt.reset();
 
-  if (!(Stmt->IApd= MADB_DescInit(Connection, MADB_DESC_APD, FALSE)) ||
-    !(Stmt->IArd= MADB_DescInit(Connection, MADB_DESC_ARD, FALSE)) ||
-    !(Stmt->IIpd= MADB_DescInit(Connection, MADB_DESC_IPD, FALSE)) ||
-    !(Stmt->IIrd= MADB_DescInit(Connection, MADB_DESC_IRD, FALSE)))
+  if ((!Stmt->IApd && !(Stmt->IApd= MADB_DescInit(Connection, MADB_DESC_APD, FALSE))) ||
+    (!Stmt->IArd && !(Stmt->IArd= MADB_DescInit(Connection, MADB_DESC_ARD, FALSE))) ||
+    (!Stmt->IIpd && !(Stmt->IIpd= MADB_DescInit(Connection, MADB_DESC_IPD, FALSE))) ||
+    (!Stmt->IIrd && !(Stmt->IIrd= MADB_DescInit(Connection, MADB_DESC_IRD, FALSE))))
   {
     goto error;
   }
@@ -4032,13 +4449,17 @@ error:
 }
 /* }}} */
 
+/* Makes the codec the one for the column, or row level "null" codec. The statement owns the codec, and the resultset
+   only gets the pointer. Setting the codec the column already has costs nothing */
 bool MADB_Stmt::setResultCodec(ResultCodec* codec, unsigned long column)
 {
   if (column == (unsigned long)-1/* "null" row level codec */) {
-    nullRCodec.reset(codec);
+    if (codec != nullRCodec.get()) {
+      nullRCodec.reset(codec);
+    }
   }
-  else {
-    resultCodec[column].reset(codec);
+  else if (codec != resultCodec[column].get()) {
+    resultCodec[column].reset(static_cast<BoundRCodec*>(codec));
   }
   return rs->setResultCallback(codec, static_cast<uint32_t>(column));
 }
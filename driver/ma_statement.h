@@ -117,8 +117,13 @@ SQLRETURN    MADB_DoExecute         (MADB_Stmt *Stmt);
 #define MADB_STMT_FORGET_NEXT_POS(aStmt) (aStmt)->Cursor.Next= -1
 #define MADB_STMT_RESET_CURSOR(aStmt) (aStmt)->Cursor.Position= 0; MADB_STMT_FORGET_NEXT_POS(aStmt)
 #define MADB_STMT_CLOSE_STMT(aStmt)  (aStmt)->stmt.reset()
+/* Forward-only result should be read via server-side read-only cursor. That is possible only for the server-side prepared statement */
+#define MADB_STMT_CURSOR_FETCH(_a) ((_a)->Connection->Dsn->CursorFetch > 0 &&\
+  (_a)->Options.CursorType == SQL_CURSOR_FORWARD_ONLY)
 #define MADB_STMT_SHOULD_STREAM(_a) (DSN_OPTION((_a)->Connection, MADB_OPT_FLAG_NO_CACHE) &&\
   (_a)->Options.CursorType == SQL_CURSOR_FORWARD_ONLY)
+/* Current result is read via server-side cursor indeed. Like with streamed result, its size is not known till the end */
+#define MADB_STMT_CURSOR_RESULT(_a) ((_a)->rs && (_a)->rs->isCursorFetch())
 /* Checks if given Stmt handle is currently streaming (prev variant (MADB_STMT_SHOULD_STREAM(_a) && STMT_EXECUTED(_a) && MADB_STMT_COLUMN_COUNT(_a) > 0) */
 #define MADB_STMT_IS_STREAMING(_a) ((_a)->Connection->Streamer == _a)
 /* Set given Stmt handle as s current RS streamer on the connection */
@@ -18,6 +18,7 @@
 *************************************************************************************/
 
 #include "ma_odbc.h"
+#include "ma_simd.h"
 
 #include "ResultSetMetaData.h"
 #include "interface/ResultSet.h"
@@ -504,8 +505,18 @@ SQLLEN MbstrCharLen(const char *str, SQLINTEGER OctetLen, MARIADB_CHARSET_INFO *
     {
       return OctetLen;
     }
+    const bool asciiCompatible= cs->char_minlen == 1;
+
     while (ptr < str + OctetLen)
     {
+      /* Run of ASCII bytes is 1 unit per byte, and can be skipped at once */
+      if (asciiCompatible && (unsigned char)*ptr < 0x80)
+      {
+        size_t asciiLen= MADB_AsciiPrefixLen(ptr, str + OctetLen - ptr);
+        ptr+= asciiLen;
+        result+= asciiLen;
+        continue;
+      }
       charlen= cs->mb_charlen((unsigned char)*ptr);
       if (charlen == 0)
       {
@@ -576,6 +587,10 @@ SQLLEN SqlwcsLen(SQLWCHAR *str, SQLLEN buff_length)
 
   if (str)
   {
+    if (sizeof(SQLWCHAR) == 2)
+    {
+      return MADB_Utf16Len(reinterpret_cast<const uint16_t*>(str), buff_length < 0 ? SIZE_MAX : (size_t)buff_length);
+    }
     /* If buff_length is negative - we will never hit 1st condition, otherwise we hit it after last character
        of the buffer is processed */
     while ((--buff_length) != -1 && *str)
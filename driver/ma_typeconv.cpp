@@ -19,6 +19,8 @@
 
 /* ODBC C->SQL and SQL->C type conversion functions */
 
+#include <climits>
+
 #include "ma_odbc.h"
 
 /* Borrowed from C/C and adapted. Reads date/time types from string into MYSQL_TIME */
@@ -167,99 +169,100 @@ char MADB_ConvertCharToBit(MADB_Stmt *Stmt, char *src)
 }
 /* }}} */
 
-/* {{{ MADB_ConvertNumericToChar */
+/* {{{ MADB_ConvertNumericToChar
+       Buffer has to be at least MADB_CHARSIZE_FOR_NUMERIC bytes long */
 size_t MADB_ConvertNumericToChar(SQL_NUMERIC_STRUCT *Numeric, char *Buffer, int *ErrorCode)
 {
-  const double DenominatorTable[]= {1.0, 10.0, 100.0, 1000.0, 10000.0, 100000.0, 1000000.0, 10000000.0, 100000000.0, 1000000000.0/*9*/,
-                                    10000000000.0, 100000000000.0, 1000000000000.0, 10000000000000.0, 100000000000000.0, 1000000000000000.0/*15*/,
-                                    10000000000000000.0, 100000000000000000.0, 1000000000000000000.0, 10000000000000000000.0, 1e+20 /*20*/, 1e+21,
-                                    1e+22, 1e+23, 1e+24, 1e+25, 1e+26, 1e+27, 1e+28, 1e+29, 1e+30, 1e+31, 1e+32, 1e+33, 1e+34, 1e+35, 1e+36, 1e+37, 1e+38 };
-  unsigned long long Numerator= 0;
-  double Denominator;
-  int Scale= 0;
-  unsigned long long ByteDenominator= 1;
-  int i;
-  char* p;
-  size_t Length;
-
-  Buffer[0]= 0;
-  *ErrorCode= 0;
+  char   Digits[MADB_DEFAULT_PRECISION + 2];
+  size_t DigitsCount, IntCount, Length;
+  int    Scale= Numeric->scale;
+  char  *Start= Buffer, *p;
 
-  Scale+= (Numeric->scale < 0) ? -Numeric->scale : Numeric->scale;
+  *ErrorCode= 0;
+  DigitsCount= MADB_NumericValToDigits(Numeric->val, Digits);
 
-  for (i= 0; i < SQL_MAX_NUMERIC_LEN; ++i)
+  if (Numeric->sign == 0)
   {
-    if (i > 7 && Numeric->val[i] != '\0')
-    {
-      *ErrorCode= MADB_ERR_22003;
-      return 0;
-    }
-    Numerator += Numeric->val[i] * ByteDenominator;
-    ByteDenominator <<= 8;
+    *Start++= '-';
   }
+  /* Room for the value in the buffer, besides sign and terminating null */
+  const size_t MaxLength= MADB_CHARSIZE_FOR_NUMERIC - 1 - (Start - Buffer);
 
-  if (Numeric->scale > 0)
+  if (Scale > 0)
   {
-    Denominator= DenominatorTable[Scale];// pow(10, Scale);
-    char tmp[10 /*1 sign + 1 % + 1 dot + 3 scale + 1f + 1\0 */];
-    _snprintf(tmp, sizeof(tmp), "%s%%.%df", Numeric->sign ? "" : "-", Numeric->scale);
-    _snprintf(Buffer, MADB_CHARSIZE_FOR_NUMERIC, tmp, Numerator / Denominator);
-  }
-  else
-  {
-    _snprintf(Buffer, MADB_CHARSIZE_FOR_NUMERIC, "%s%llu", Numeric->sign ? "" : "-", Numerator);
-    /* Checking Truncation for negative/zero scale before adding 0 */
-    Length= strlen(Buffer) - (Numeric->sign ? 0 : 1);
-    if (Length > Numeric->precision)
+    /* Digits are placed exactly, without going thru floating point. The scale can be up to 127, and the result is
+       composed here first, and then cut to what fits the buffer */
+    char Exact[2/* 0. */ + SCHAR_MAX + 1];
+
+    p= Exact;
+    if (DigitsCount > static_cast<size_t>(Scale))
     {
-      *ErrorCode= MADB_ERR_22003;
-      goto end;
+      IntCount= DigitsCount - Scale;
+      memcpy(p, Digits, IntCount);
+      p+= IntCount;
+      *p++= '.';
+      memcpy(p, Digits + IntCount, Scale);
+      p+= Scale;
     }
-    for (i= 0; i < Scale; ++i)
+    else
     {
-      strcat(Buffer, "0");
+      IntCount= 1;
+      *p++= '0';
+      *p++= '.';
+      memset(p, '0', Scale - DigitsCount);
+      p+= Scale - DigitsCount;
+      memcpy(p, Digits, DigitsCount);
+      p+= DigitsCount;
     }
-  }
+    Length= p - Exact;
 
-  if (Buffer[0] == '-')
-  {
-    ++Buffer;
-  }
-
-  Length= strlen(Buffer);
-  /* Truncation checks:
-  1st ensure, that the digits before decimal point will fit */
-  if ((p= strchr(Buffer, '.')))
-  {
-    if (Numeric->precision != 0 && (p - Buffer) > Numeric->precision)
+    /* Truncation checks:
+       1st ensure, that the digits before decimal point will fit */
+    if (Numeric->precision != 0 && IntCount > Numeric->precision)
     {
       *ErrorCode= MADB_ERR_22003;
-      Length= Numeric->precision;
-      Buffer[Numeric->precision]= 0;
-      goto end;
+      *Buffer= '\0';
+      return 0;
     }
-
     /* If scale >= precision, we still can have no truncation */
-    if (Length > (unsigned int)(Numeric->precision + 1)/*dot*/ && Scale < Numeric->precision)
+    if (Length > static_cast<size_t>(Numeric->precision + 1)/*dot*/ && Scale < Numeric->precision)
     {
       *ErrorCode= MADB_ERR_01S07;
       Length= Numeric->precision + 1/*dot*/;
-      Buffer[Length]= 0;
-      goto end;
     }
+    /* Integer part always fits, i.e. only fractional digits get cut off here */
+    if (Length > MaxLength)
+    {
+      *ErrorCode= MADB_ERR_01S07;
+      Length= MaxLength;
+    }
+    /* check if last char is decimal point */
+    if (Length > 0 && Exact[Length - 1] == '.')
+    {
+      --Length;
+    }
+    memcpy(Start, Exact, Length);
+    Start[Length]= '\0';
   }
-
-end:
-  /* check if last char is decimal point */
-  if (Length > 0 && Buffer[Length - 1] == '.')
-  {
-    Buffer[Length - 1]= 0;
-  }
-  if (Numeric->sign == 0)
+  else
   {
-    ++Length;
+    /* Checking Truncation for negative/zero scale before adding 0. -128 scale could also overflow the buffer */
+    if ((Numeric->precision != 0 && DigitsCount > Numeric->precision) || DigitsCount + static_cast<size_t>(-Scale) > MaxLength)
+    {
+      *ErrorCode= MADB_ERR_22003;
+      *Buffer= '\0';
+      return 0;
+    }
+    p= Start;
+    memcpy(p, Digits, DigitsCount);
+    p+= DigitsCount;
+    memset(p, '0', -Scale);
+    p+= -Scale;
+    *p= '\0';
+    Length= p - Start;
   }
-  return Length;
+
+  return Length + (Start - Buffer);
 }
 /* }}} */
 
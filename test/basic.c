@@ -2165,6 +2165,73 @@ ODBC_TEST(connection_reset)
 }
 
 
+/* Statements most recently used before the connection reset are prepared again by the reset with PSWARMUP, and preparing
+   them afterwards does not reach the server */
+ODBC_TEST(ps_cache_warmup)
+{
+#ifdef SQL_ATTR_RESET_CONNECTION
+  SQLHDBC  Hdbc= NULL;
+  SQLHSTMT Hstmt, Hstmt2;
+  int      Prepared;
+
+  if (using_dm(Connection))
+  {
+    skip("Only DM may set SQL_ATTR_RESET_CONNECTION");
+  }
+  CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+  Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "PSWARMUP=1");
+  FAIL_IF(Hstmt == NULL, "Connection error");
+  CHECK_DBC_RC(Hdbc, SQLAllocHandle(SQL_HANDLE_STMT, Hdbc, &Hstmt2));
+
+  /* The cold one is used first, i.e. the other is the most recent one */
+  CHECK_STMT_RC(Hstmt2, SQLPrepare(Hstmt2, "SELECT 2 /*cold*/", SQL_NTS));
+  CHECK_STMT_RC(Hstmt2, SQLPrepare(Hstmt2, "SELECT 1 /*hot*/", SQL_NTS));
+  CHECK_STMT_RC(Hstmt2, SQLExecute(Hstmt2));
+  CHECK_STMT_RC(Hstmt2, SQLFreeStmt(Hstmt2, SQL_CLOSE));
+
+  CHECK_DBC_RC(Hdbc, SQLSetConnectAttr(Hdbc, SQL_ATTR_RESET_CONNECTION, (SQLPOINTER)SQL_RESET_CONNECTION_YES, 0));
+
+  /* Statement status is queried via text protocol, i.e. it does not affect the counter */
+  OK_SIMPLE_STMT(Hstmt, "SHOW SESSION STATUS LIKE 'Com_stmt_prepare'");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  Prepared= my_fetch_int(Hstmt, 2);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  CHECK_STMT_RC(Hstmt2, SQLPrepare(Hstmt2, "SELECT 1 /*hot*/", SQL_NTS));
+  CHECK_STMT_RC(Hstmt2, SQLExecute(Hstmt2));
+  CHECK_STMT_RC(Hstmt2, SQLFetch(Hstmt2));
+  is_num(my_fetch_int(Hstmt2, 1), 1);
+  CHECK_STMT_RC(Hstmt2, SQLFreeStmt(Hstmt2, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Hstmt, "SHOW SESSION STATUS LIKE 'Com_stmt_prepare'");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 2), Prepared);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  /* The one, that has not been warmed up, has to be prepared again */
+  CHECK_STMT_RC(Hstmt2, SQLPrepare(Hstmt2, "SELECT 2 /*cold*/", SQL_NTS));
+  CHECK_STMT_RC(Hstmt2, SQLExecute(Hstmt2));
+  CHECK_STMT_RC(Hstmt2, SQLFetch(Hstmt2));
+  is_num(my_fetch_int(Hstmt2, 1), 2);
+  CHECK_STMT_RC(Hstmt2, SQLFreeStmt(Hstmt2, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Hstmt, "SHOW SESSION STATUS LIKE 'Com_stmt_prepare'");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 2), Prepared + 1);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  CHECK_STMT_RC(Hstmt2, SQLFreeStmt(Hstmt2, SQL_DROP));
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+  CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+
+  return OK;
+#else
+  skip("SQL_ATTR_RESET_CONNECTION is not defined");
+#endif
+}
+
+
 ODBC_TEST(t_odbc399)
 {
   CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_MAX_ROWS, (SQLPOINTER)5, 0));
@@ -2173,6 +2240,253 @@ ODBC_TEST(t_odbc399)
   return OK;
 }
 
+/* Allocation and freeing of connection handles from many threads at once. Nothing may fail, and the environment's
+   handles registry has to stay consistent */
+#define HANDLES_THREADS 8
+#define HANDLES_PER_THREAD 5000
+
+typedef struct
+{
+  int Failures;
+} HandlesThreadResult;
+
+#ifdef _WIN32
+DWORD WINAPI alloc_free_handles(LPVOID arg)
+#else
+#include <pthread.h>
+void *alloc_free_handles(void *arg)
+#endif
+{
+  HandlesThreadResult *Result= (HandlesThreadResult*)arg;
+  SQLHDBC Hdbc;
+  int i;
+
+  for (i= 0; i < HANDLES_PER_THREAD; ++i)
+  {
+    if (!SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_DBC, Env, &Hdbc)))
+    {
+      ++Result->Failures;
+      continue;
+    }
+    if (!SQL_SUCCEEDED(SQLFreeHandle(SQL_HANDLE_DBC, Hdbc)))
+    {
+      ++Result->Failures;
+    }
+  }
+  return 0;
+}
+
+
+static int run_alloc_free_threads(HandlesThreadResult *Result)
+{
+  int i;
+#ifdef _WIN32
+  HANDLE Thread[HANDLES_THREADS];
+#else
+  pthread_t Thread[HANDLES_THREADS];
+#endif
+
+  memset(Result, 0, sizeof(HandlesThreadResult)*HANDLES_THREADS);
+
+  for (i= 0; i < HANDLES_THREADS; ++i)
+  {
+#ifdef _WIN32
+    Thread[i]= CreateThread(NULL, 0, alloc_free_handles, &Result[i], 0, NULL);
+    FAIL_IF(Thread[i] == NULL, "Could not create thread");
+#else
+    FAIL_IF(pthread_create(&Thread[i], NULL, alloc_free_handles, &Result[i]) != 0, "Could not create thread");
+#endif
+  }
+  for (i= 0; i < HANDLES_THREADS; ++i)
+  {
+#ifdef _WIN32
+    WaitForSingleObject(Thread[i], INFINITE);
+    CloseHandle(Thread[i]);
+#else
+    pthread_join(Thread[i], NULL);
+#endif
+  }
+
+  for (i= 0; i < HANDLES_THREADS; ++i)
+  {
+    is_num(Result[i].Failures, 0);
+  }
+
+  return OK;
+}
+
+
+ODBC_TEST(concurrent_handles)
+{
+  HandlesThreadResult Result[HANDLES_THREADS];
+
+  return run_alloc_free_threads(Result);
+}
+
+
+static double handles_now_ms()
+{
+#ifdef _WIN32
+  return (double)GetTickCount64();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+#endif
+}
+
+/* Same as concurrent_handles, but reports the rate, so contention in the environment's handles registry can be
+   compared between builds. The numbers depend on the machine, thus it only runs if TEST_BENCHMARK is set */
+ODBC_TEST(concurrent_handles_benchmark)
+{
+  HandlesThreadResult Result[HANDLES_THREADS];
+  double Start, Elapsed;
+  int rc;
+
+  if (getenv("TEST_BENCHMARK") == NULL)
+  {
+    skip("Benchmark runs only if TEST_BENCHMARK is set");
+  }
+
+  Start= handles_now_ms();
+  rc= run_alloc_free_threads(Result);
+  Elapsed= handles_now_ms() - Start;
+
+  if (rc == OK)
+  {
+    diag("%d threads allocated and freed %d connection handles in %.0fms", HANDLES_THREADS,
+      HANDLES_THREADS*HANDLES_PER_THREAD, Elapsed);
+  }
+
+  return rc;
+}
+
+
+/* Repeated SELECT is served from the results cache, till the connection changes anything, and never inside the
+   transaction */
+ODBC_TEST(result_cache)
+{
+  SQLHDBC  Hdbc= NULL;
+  SQLHSTMT Hstmt;
+  SQLCHAR  val[8];
+  SQLLEN   len;
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_result_cache");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_result_cache (a int not null primary key, b varchar(8))");
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_result_cache VALUES (1, 'one'), (2, NULL), (3, '')");
+
+  /* TTL long enough for nothing to expire during the test */
+  CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+  Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "RESULTCACHE=1024;RESULTCACHETTL=3600;PREPONCLIENT=1");
+  FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+
+  OK_SIMPLE_STMT(Hstmt, "SELECT a, b FROM t_result_cache ORDER BY a");
+  is_num(myrowcount(Hstmt), 3);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  /* Change by other connection is not visible, until the cached result expires or is invalidated */
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_result_cache VALUES (4, 'four')");
+  OK_SIMPLE_STMT(Hstmt, "SELECT a, b FROM t_result_cache ORDER BY a");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 1), 1);
+  IS_STR(my_fetch_str(Hstmt, val, 2), "one", 4);
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 2, SQL_C_CHAR, val, sizeof(val), &len));
+  is_num(len, SQL_NULL_DATA);
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 2, SQL_C_CHAR, val, sizeof(val), &len));
+  is_num(len, 0);
+  EXPECT_STMT(Hstmt, SQLFetch(Hstmt), SQL_NO_DATA);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  /* DML of the connection invalidates the cache */
+  OK_SIMPLE_STMT(Hstmt, "INSERT INTO t_result_cache VALUES (5, 'five')");
+  OK_SIMPLE_STMT(Hstmt, "SELECT a, b FROM t_result_cache ORDER BY a");
+  is_num(myrowcount(Hstmt), 5);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  /* Inside the transaction the query always goes to the server */
+  CHECK_DBC_RC(Hdbc, SQLSetConnectAttr(Hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0));
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_result_cache VALUES (6, 'six')");
+  OK_SIMPLE_STMT(Hstmt, "SELECT a, b FROM t_result_cache ORDER BY a");
+  is_num(myrowcount(Hstmt), 6);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+  CHECK_DBC_RC(Hdbc, SQLEndTran(SQL_HANDLE_DBC, Hdbc, SQL_COMMIT));
+  CHECK_DBC_RC(Hdbc, SQLSetConnectAttr(Hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0));
+
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+
+  /* Separate short-TTL connection: once waited longer than the TTL, the cached result must not be served */
+  Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "RESULTCACHE=1024;RESULTCACHETTL=1;PREPONCLIENT=1");
+  FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+  OK_SIMPLE_STMT(Hstmt, "SELECT a, b FROM t_result_cache ORDER BY a");
+  is_num(myrowcount(Hstmt), 6);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_result_cache VALUES (7, 'seven')");
+  Sleep(2500);
+  OK_SIMPLE_STMT(Hstmt, "SELECT a, b FROM t_result_cache ORDER BY a");
+  is_num(myrowcount(Hstmt), 7);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+
+  /* Zero TTL means no caching */
+  Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "RESULTCACHE=1024;RESULTCACHETTL=0;PREPONCLIENT=1");
+  FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+  OK_SIMPLE_STMT(Hstmt, "SELECT a, b FROM t_result_cache ORDER BY a");
+  is_num(myrowcount(Hstmt), 7);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_result_cache VALUES (8, 'eight')");
+  OK_SIMPLE_STMT(Hstmt, "SELECT a, b FROM t_result_cache ORDER BY a");
+  is_num(myrowcount(Hstmt), 8);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+
+  CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_result_cache");
+
+  return OK;
+}
+
+
+ODBC_TEST(compression)
+{
+  SQLHDBC  Hdbc= NULL;
+  SQLHSTMT Hstmt;
+  SQLCHAR  val[8];
+  const char *Host= (const char*)my_servername;
+  BOOL Local= strcmp(Host, "localhost") == 0 || strncmp(Host, "127.", 4) == 0 || strcmp(Host, "::1") == 0;
+
+  CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+  Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "COMPRESS=1");
+  FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+
+  OK_SIMPLE_STMT(Hstmt, "SHOW SESSION STATUS LIKE 'Compression'");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  IS_STR(my_fetch_str(Hstmt, val, 2), "ON", 3);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  /* Wide enough result to go in several compressed packets */
+  OK_SIMPLE_STMT(Hstmt, "SELECT REPEAT('a', 100000) UNION ALL SELECT REPEAT('b', 10)");
+  is_num(myrowcount(Hstmt), 2);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+
+  /* With COMPRESSREMOTE compression is requested only if the server is not on the local host */
+  Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "COMPRESS=1;COMPRESSREMOTE=1");
+  FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+
+  OK_SIMPLE_STMT(Hstmt, "SHOW SESSION STATUS LIKE 'Compression'");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  IS_STR(my_fetch_str(Hstmt, val, 2), Local ? "OFF" : "ON", Local ? 4 : 3);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+  CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+
+  return OK;
+}
+
+
 MA_ODBC_TESTS my_tests[]=
 {
   {t_disconnect, "t_disconnect",      NORMAL},
@@ -2230,7 +2544,12 @@ MA_ODBC_TESTS my_tests[]=
   {sqlcancelhandle, "sqlcancelhandle", NORMAL},
 #endif
   {connection_reset, "test_SQL_ATTR_RESET_CONNECTION", NORMAL},
+  {ps_cache_warmup, "ps_cache_warmup", NORMAL},
   {t_odbc399,     "odbc399_comment_only",    NORMAL},
+  {concurrent_handles, "concurrent_handles",    NORMAL},
+  {concurrent_handles_benchmark, "concurrent_handles_benchmark", NORMAL},
+  {result_cache,  "result_cache",             NORMAL},
+  {compression,   "compression",              NORMAL},
   {NULL, NULL, 0}
 };
 
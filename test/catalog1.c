@@ -660,7 +660,11 @@ ODBC_TEST(t_current_catalog_unicode)
 
   latin_as_sqlwchar((char*)"test_odbc_current", cur_db);
   rc = SQLSetConnectAttrW(Connection, SQL_ATTR_CURRENT_CATALOG, cur_db, SQL_NTS);
-  FAIL_IF(rc == SQL_SUCCESS, "Error expected");
+  CHECK_DBC_RC(Connection,rc);
+  /* The change is sent with the next statement, and that is where the error comes */
+  EXPECT_STMT(Stmt, SQLExecDirect(Stmt, (SQLCHAR*)"SELECT 1", SQL_NTS), SQL_ERROR);
+  rc = SQLSetConnectAttrW(Connection, SQL_ATTR_CURRENT_CATALOG, db, SQL_NTS);
+  CHECK_DBC_RC(Connection,rc);
 
   OK_SIMPLE_STMT(Stmt, "CREATE DATABASE test_odbc_current");
   rc = SQLFreeStmt(Stmt,SQL_CLOSE);
@@ -707,7 +711,11 @@ ODBC_TEST(t_current_catalog_ansi)
 
   strcpy((char *)cur_db, "test_odbc_current");
   rc = SQLSetConnectAttr(Connection, SQL_ATTR_CURRENT_CATALOG, cur_db, SQL_NTS);
-  FAIL_IF(rc == SQL_SUCCESS, "Error expected");
+  CHECK_DBC_RC(Connection,rc);
+  /* The change is sent with the next statement, and that is where the error comes */
+  EXPECT_STMT(Stmt, SQLExecDirect(Stmt, (SQLCHAR*)"SELECT 1", SQL_NTS), SQL_ERROR);
+  rc = SQLSetConnectAttr(Connection, SQL_ATTR_CURRENT_CATALOG, db, SQL_NTS);
+  CHECK_DBC_RC(Connection,rc);
 
   OK_SIMPLE_STMT(Stmt, "CREATE DATABASE test_odbc_current");
   rc = SQLFreeStmt(Stmt,SQL_CLOSE);
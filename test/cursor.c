@@ -3570,6 +3570,213 @@ ODBC_TEST(odbc356)
   return OK;
 }
 
+/* SQLSetPos(SQL_REFRESH) re-reads the rowset from the table */
+ODBC_TEST(t_setpos_refresh)
+{
+  SQLHSTMT     Stmt2;
+  SQLINTEGER   nData[3];
+  SQLCHAR      szData[3][10];
+  SQLLEN       Len[3];
+  SQLUSMALLINT RowStatus[3];
+
+  if (ForwardOnly == TRUE && NoCache == TRUE)
+  {
+    skip("The test cannot be run if FORWARDONLY and NOCACHE options are selected");
+  }
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_setpos_refresh");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_setpos_refresh (a INT NOT NULL PRIMARY KEY, b VARCHAR(20))");
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_setpos_refresh VALUES (1,'one'),(2,'two'),(3,'three'),(4,'four')");
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)SQL_CURSOR_STATIC, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)3, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_ROW_STATUS_PTR, RowStatus, 0));
+
+  OK_SIMPLE_STMT(Stmt, "SELECT a, b FROM t_setpos_refresh ORDER BY a");
+  CHECK_STMT_RC(Stmt, SQLBindCol(Stmt, 1, SQL_C_LONG, nData, 0, NULL));
+  CHECK_STMT_RC(Stmt, SQLBindCol(Stmt, 2, SQL_C_CHAR, szData, sizeof(szData[0]), Len));
+
+  CHECK_STMT_RC(Stmt, SQLFetchScroll(Stmt, SQL_FETCH_ABSOLUTE, 2));
+  is_num(nData[0], 2);
+  IS_STR(szData[2], "four", 5);
+
+  CHECK_DBC_RC(Connection, SQLAllocHandle(SQL_HANDLE_STMT, Connection, &Stmt2));
+  OK_SIMPLE_STMT(Stmt2, "UPDATE t_setpos_refresh SET b='TWO' WHERE a=2");
+  OK_SIMPLE_STMT(Stmt2, "UPDATE t_setpos_refresh SET b=NULL WHERE a=4");
+  OK_SIMPLE_STMT(Stmt2, "DELETE FROM t_setpos_refresh WHERE a=3");
+
+  /* Single row of the rowset */
+  CHECK_STMT_RC(Stmt, SQLSetPos(Stmt, 1, SQL_REFRESH, SQL_LOCK_NO_CHANGE));
+  IS_STR(szData[0], "TWO", 4);
+  is_num(Len[0], 3);
+  IS_STR(szData[2], "four", 5);
+
+  /* Whole rowset */
+  CHECK_STMT_RC(Stmt, SQLSetPos(Stmt, 0, SQL_REFRESH, SQL_LOCK_NO_CHANGE));
+  is_num(nData[0], 2);
+  IS_STR(szData[0], "TWO", 4);
+  is_num(RowStatus[0], SQL_ROW_SUCCESS);
+  is_num(RowStatus[1], SQL_ROW_DELETED);
+  is_num(nData[2], 4);
+  is_num(Len[2], SQL_NULL_DATA);
+  is_num(RowStatus[2], SQL_ROW_SUCCESS);
+
+  /* NULL into the column bound without indicator is an error of the row */
+  CHECK_STMT_RC(Stmt, SQLBindCol(Stmt, 2, SQL_C_CHAR, szData, sizeof(szData[0]), NULL));
+  EXPECT_STMT(Stmt, SQLSetPos(Stmt, 3, SQL_REFRESH, SQL_LOCK_NO_CHANGE), SQL_ERROR);
+  CHECK_SQLSTATE(Stmt, "22002");
+  is_num(RowStatus[2], SQL_ROW_ERROR);
+
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_UNBIND));
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_ROW_STATUS_PTR, NULL, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)1, 0));
+
+  CHECK_STMT_RC(Stmt2, SQLFreeStmt(Stmt2, SQL_DROP));
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_setpos_refresh");
+
+  return OK;
+}
+
+
+/* Static cursor over the result, that does not fit into the memory limit and is partly spilled to disk */
+ODBC_TEST(t_spilled_static)
+{
+  SQLHDBC  Hdbc= NULL;
+  SQLHSTMT Hstmt;
+  SQLCHAR  val[1024];
+  SQLLEN   len;
+  const char *Options[]= {"SPILLMEM=1;PREPONCLIENT=1", "SPILLMEM=1;PREPONCLIENT=0"};
+  unsigned int i;
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_spilled_static");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_spilled_static (a int not null primary key, b varchar(1000), c int)");
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_spilled_static WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 3000)"
+                       " SELECT i, REPEAT(CHAR(65 + i % 26), 1000), IF(i % 3 = 0, NULL, i) FROM s");
+
+  for (i= 0; i < sizeof(Options)/sizeof(Options[0]); ++i)
+  {
+    CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+    Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, (char*)Options[i]);
+    FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+
+    CHECK_STMT_RC(Hstmt, SQLSetStmtAttr(Hstmt, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)SQL_CURSOR_STATIC, 0));
+    CHECK_STMT_RC(Hstmt, SQLPrepare(Hstmt, "SELECT a, b, c FROM t_spilled_static ORDER BY a", SQL_NTS));
+    CHECK_STMT_RC(Hstmt, SQLExecute(Hstmt));
+
+    CHECK_STMT_RC(Hstmt, SQLFetchScroll(Hstmt, SQL_FETCH_LAST, 0));
+    is_num(my_fetch_int(Hstmt, 1), 3000);
+    CHECK_STMT_RC(Hstmt, SQLFetchScroll(Hstmt, SQL_FETCH_ABSOLUTE, 2500));
+    is_num(my_fetch_int(Hstmt, 1), 2500);
+    CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 2, SQL_C_CHAR, val, sizeof(val), &len));
+    is_num(len, 1000);
+    is_num(val[999], 65 + 2500 % 26);
+    is_num(my_fetch_int(Hstmt, 3), 2500);
+    CHECK_STMT_RC(Hstmt, SQLFetchScroll(Hstmt, SQL_FETCH_PRIOR, 0));
+    is_num(my_fetch_int(Hstmt, 1), 2499);
+    CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 3, SQL_C_LONG, val, 0, &len));
+    is_num(len, SQL_NULL_DATA);
+    CHECK_STMT_RC(Hstmt, SQLFetchScroll(Hstmt, SQL_FETCH_FIRST, 0));
+    is_num(my_fetch_int(Hstmt, 1), 1);
+    CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 2, SQL_C_CHAR, val, sizeof(val), &len));
+    is_num(len, 1000);
+    is_num(val[0], 65 + 1);
+    EXPECT_STMT(Hstmt, SQLFetchScroll(Hstmt, SQL_FETCH_ABSOLUTE, 3001), SQL_NO_DATA);
+
+    CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+    CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+    CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+  }
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_spilled_static");
+
+  return OK;
+}
+
+
+/* Rowset conversion split between fetch threads has to give the same values, indicators and row statuses, as the
+   conversion on the fetching thread */
+#define FETCHTHREADS_ROWS 300
+#define FETCHTHREADS_ROWSET 200
+ODBC_TEST(t_fetch_threads)
+{
+  SQLHDBC      Hdbc= NULL;
+  SQLHSTMT     Hstmt;
+  SQLINTEGER   a[FETCHTHREADS_ROWSET];
+  SQLCHAR      b[FETCHTHREADS_ROWSET][16];
+  SQLINTEGER   c[FETCHTHREADS_ROWSET];
+  SQLLEN       bLen[FETCHTHREADS_ROWSET], cInd[FETCHTHREADS_ROWSET];
+  SQLUSMALLINT Status[FETCHTHREADS_ROWSET];
+  SQLULEN      RowsFetched= 0;
+  const char  *Options[]= {"FETCHTHREADS=4", "FETCHTHREADS=4;PREPONCLIENT=1"};
+  char         expected[16];
+  unsigned int i, j, row;
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_fetch_threads");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_fetch_threads (a int not null primary key, b varchar(32), c int)");
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_fetch_threads WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 300)"
+                       " SELECT i, IF(i % 50 = 0, REPEAT('x', 32), CONCAT('row', i)), IF(i % 3 = 0, NULL, i * 7) FROM s");
+
+  for (i= 0; i < sizeof(Options)/sizeof(Options[0]); ++i)
+  {
+    CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+    Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, (char*)Options[i]);
+    FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+
+    CHECK_STMT_RC(Hstmt, SQLSetStmtAttr(Hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)FETCHTHREADS_ROWSET, 0));
+    CHECK_STMT_RC(Hstmt, SQLSetStmtAttr(Hstmt, SQL_ATTR_ROW_STATUS_PTR, Status, 0));
+    CHECK_STMT_RC(Hstmt, SQLSetStmtAttr(Hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &RowsFetched, 0));
+    CHECK_STMT_RC(Hstmt, SQLBindCol(Hstmt, 1, SQL_C_LONG, a, 0, NULL));
+    CHECK_STMT_RC(Hstmt, SQLBindCol(Hstmt, 2, SQL_C_CHAR, b, sizeof(b[0]), bLen));
+    CHECK_STMT_RC(Hstmt, SQLBindCol(Hstmt, 3, SQL_C_LONG, c, 0, cInd));
+
+    CHECK_STMT_RC(Hstmt, SQLPrepare(Hstmt, "SELECT a, b, c FROM t_fetch_threads ORDER BY a", SQL_NTS));
+    CHECK_STMT_RC(Hstmt, SQLExecute(Hstmt));
+
+    for (row= 1; row <= FETCHTHREADS_ROWS;)
+    {
+      /* Each rowset has rows with truncated values, i.e. SQL_SUCCESS_WITH_INFO is the expected return code */
+      EXPECT_STMT(Hstmt, SQLFetchScroll(Hstmt, SQL_FETCH_NEXT, 0), SQL_SUCCESS_WITH_INFO);
+      CHECK_SQLSTATE(Hstmt, "01004");
+      is_num(RowsFetched, row == 1 ? FETCHTHREADS_ROWSET : FETCHTHREADS_ROWS - FETCHTHREADS_ROWSET);
+
+      for (j= 0; j < RowsFetched; ++j, ++row)
+      {
+        is_num(a[j], row);
+        if (row % 50 == 0)
+        {
+          is_num(Status[j], SQL_ROW_SUCCESS_WITH_INFO);
+          is_num(bLen[j], 32);
+          IS_STR(b[j], "xxxxxxxxxxxxxxx", sizeof(b[0]));
+        }
+        else
+        {
+          is_num(Status[j], SQL_ROW_SUCCESS);
+          _snprintf(expected, sizeof(expected), "row%u", row);
+          is_num(bLen[j], strlen(expected));
+          IS_STR(b[j], expected, bLen[j] + 1);
+        }
+        if (row % 3 == 0)
+        {
+          is_num(cInd[j], SQL_NULL_DATA);
+        }
+        else
+        {
+          is_num(c[j], row * 7);
+        }
+      }
+    }
+    EXPECT_STMT(Hstmt, SQLFetchScroll(Hstmt, SQL_FETCH_NEXT, 0), SQL_NO_DATA);
+
+    CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+    CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+    CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+  }
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_fetch_threads");
+
+  return OK;
+}
+
 
 MA_ODBC_TESTS my_tests[]=
 {
@@ -3625,6 +3832,9 @@ MA_ODBC_TESTS my_tests[]=
   {odbc276, "odbc276-bin_update", NORMAL, SkipIfRsStreaming},
   {odbc289, "odbc289-fech_after_close", NORMAL},
   {odbc356, "odbc356-key_cursor", NORMAL, SkipIfRsStreaming},
+  {t_spilled_static, "t_spilled_static", NORMAL},
+  {t_setpos_refresh, "t_setpos_refresh", NORMAL, SkipIfRsStreaming},
+  {t_fetch_threads, "t_fetch_threads", NORMAL},
   {NULL, NULL, 0, NULL}
 };
 
@@ -938,6 +938,84 @@ ODBC_TEST(t_odbc211)
 }
 
 
+/* Dropped statements are reused by the connection for next allocations. Nothing set on the dropped statement may be
+   seen in the new one. The number of handles is bigger than the connection keeps for reuse */
+#define STMT_REUSE_HANDLES 20
+ODBC_TEST(t_stmt_reuse)
+{
+  SQLHDBC     Hdbc= NULL;
+  SQLHSTMT    Hstmt[STMT_REUSE_HANDLES];
+  SQLHANDLE   ExpArd, Desc;
+  SQLINTEGER  Param= 5, Value[2];
+  SQLLEN      Ind[2];
+  SQLULEN     AttrValue;
+  SQLSMALLINT Count;
+  unsigned int i, round;
+
+  CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+  Hstmt[0]= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, NULL);
+  FAIL_IF(Hstmt[0] == NULL, "Could not connect or allocate stmt handle");
+  CHECK_STMT_RC(Hstmt[0], SQLFreeStmt(Hstmt[0], SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLAllocHandle(SQL_HANDLE_DESC, Hdbc, &ExpArd));
+
+  for (round= 0; round < 3; ++round)
+  {
+    for (i= 0; i < STMT_REUSE_HANDLES; ++i)
+    {
+      CHECK_DBC_RC(Hdbc, SQLAllocHandle(SQL_HANDLE_STMT, Hdbc, &Hstmt[i]));
+
+      CHECK_STMT_RC(Hstmt[i], SQLGetStmtAttr(Hstmt[i], SQL_ATTR_ROW_ARRAY_SIZE, &AttrValue, 0, NULL));
+      is_num(AttrValue, 1);
+      CHECK_STMT_RC(Hstmt[i], SQLGetStmtAttr(Hstmt[i], SQL_ATTR_CURSOR_TYPE, &AttrValue, 0, NULL));
+      is_num(AttrValue, SQL_CURSOR_FORWARD_ONLY);
+      CHECK_STMT_RC(Hstmt[i], SQLGetStmtAttr(Hstmt[i], SQL_ATTR_MAX_ROWS, &AttrValue, 0, NULL));
+      is_num(AttrValue, 0);
+      CHECK_STMT_RC(Hstmt[i], SQLGetStmtAttr(Hstmt[i], SQL_ATTR_APP_ROW_DESC, &Desc, SQL_IS_POINTER, NULL));
+      FAIL_IF(Desc == ExpArd, "Implicit ARD expected");
+      CHECK_DESC_RC(Desc, SQLGetDescField(Desc, 0, SQL_DESC_COUNT, &Count, SQL_IS_SMALLINT, NULL));
+      is_num(Count, 0);
+      CHECK_STMT_RC(Hstmt[i], SQLGetStmtAttr(Hstmt[i], SQL_ATTR_APP_PARAM_DESC, &Desc, SQL_IS_POINTER, NULL));
+      CHECK_DESC_RC(Desc, SQLGetDescField(Desc, 0, SQL_DESC_COUNT, &Count, SQL_IS_SMALLINT, NULL));
+      is_num(Count, 0);
+      CHECK_STMT_RC(Hstmt[i], SQLGetStmtAttr(Hstmt[i], SQL_ATTR_IMP_ROW_DESC, &Desc, SQL_IS_POINTER, NULL));
+      CHECK_DESC_RC(Desc, SQLGetDescField(Desc, 0, SQL_DESC_COUNT, &Count, SQL_IS_SMALLINT, NULL));
+      is_num(Count, 0);
+
+      /* Leaving the statement with attributes changed, parameters and columns bound, and the cursor open. The array
+         size is the ARD field, thus it is set after the ARD switch */
+      if (i % 2)
+      {
+        CHECK_STMT_RC(Hstmt[i], SQLSetStmtAttr(Hstmt[i], SQL_ATTR_APP_ROW_DESC, ExpArd, 0));
+      }
+      CHECK_STMT_RC(Hstmt[i], SQLSetStmtAttr(Hstmt[i], SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)2, 0));
+      CHECK_STMT_RC(Hstmt[i], SQLSetStmtAttr(Hstmt[i], SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)SQL_CURSOR_STATIC, 0));
+      CHECK_STMT_RC(Hstmt[i], SQLSetStmtAttr(Hstmt[i], SQL_ATTR_MAX_ROWS, (SQLPOINTER)10, 0));
+      CHECK_STMT_RC(Hstmt[i], SQLBindParameter(Hstmt[i], 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER, 0, 0, &Param, 0, NULL));
+      CHECK_STMT_RC(Hstmt[i], SQLBindCol(Hstmt[i], 1, SQL_C_LONG, Value, 0, Ind));
+      OK_SIMPLE_STMT(Hstmt[i], "SELECT ? + 1 UNION ALL SELECT 1");
+      /* Nothing may be left in the buffers from the previous handle */
+      memset(Value, 0, sizeof(Value));
+      memset(Ind, 0, sizeof(Ind));
+      CHECK_STMT_RC(Hstmt[i], SQLFetch(Hstmt[i]));
+      is_num(Value[0], 6);
+      is_num(Ind[0], sizeof(SQLINTEGER));
+      is_num(Value[1], 1);
+      is_num(Ind[1], sizeof(SQLINTEGER));
+    }
+    for (i= 0; i < STMT_REUSE_HANDLES; ++i)
+    {
+      CHECK_STMT_RC(Hstmt[i], SQLFreeHandle(SQL_HANDLE_STMT, Hstmt[i]));
+    }
+  }
+
+  CHECK_DESC_RC(ExpArd, SQLFreeHandle(SQL_HANDLE_DESC, ExpArd));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+  CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+
+  return OK;
+}
+
+
 MA_ODBC_TESTS my_tests[]=
 {
   {t_desc_paramset,"t_desc_paramset"},
@@ -959,6 +1037,7 @@ MA_ODBC_TESTS my_tests[]=
   {t_odbc213, "t_odbc213_param_type"},
   {t_odbc216, "t_odbc216_fixed_prec_scale"},
   {t_odbc211, "t_odbc211_zero_scale"},
+  {t_stmt_reuse, "t_stmt_reuse"},
   {NULL, NULL}
 };
 
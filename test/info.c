@@ -203,6 +203,48 @@ ODBC_TEST(t_bug14639)
 }
 
 
+/* With PINGIDLE the connection, that has been used recently, is not pinged. Its socket is checked instead, and the
+   connection killed on the server side still has to be reported dead */
+ODBC_TEST(connection_dead_pingidle)
+{
+  SQLINTEGER connection_id;
+  SQLUINTEGER is_dead;
+  char buf[100];
+  SQLHANDLE  Connection2= NULL;
+  SQLHANDLE  Stmt2;
+
+  SKIPIF(IsMaxScale || IsSkySqlHa, "Doesn't make sense with Maxscale, as we kill connection from MaxScale to one of servers, and our connection to MaxScale persists");
+
+  CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Connection2));
+  /* 10 minutes - the test does not last that long */
+  Stmt2= DoConnect(Connection2, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "PINGIDLE=600000");
+  FAIL_IF(Stmt2 == NULL, "Could not connect or allocate stmt handle");
+  OK_SIMPLE_STMT(Stmt2, "SELECT connection_id()");
+  CHECK_STMT_RC(Stmt2, SQLFetch(Stmt2));
+  connection_id= my_fetch_int(Stmt2, 1);
+  CHECK_STMT_RC(Stmt2, SQLFreeStmt(Stmt2, SQL_CLOSE));
+
+  CHECK_DBC_RC(Connection2, SQLGetConnectAttr(Connection2, SQL_ATTR_CONNECTION_DEAD, &is_dead, sizeof(is_dead), 0));
+  is_num(is_dead, SQL_CD_FALSE);
+  /* Repeated checks of the idle connection give the same answer */
+  CHECK_DBC_RC(Connection2, SQLGetConnectAttr(Connection2, SQL_ATTR_CONNECTION_DEAD, &is_dead, sizeof(is_dead), 0));
+  is_num(is_dead, SQL_CD_FALSE);
+
+  sprintf(buf, "KILL %d", connection_id);
+  OK_SIMPLE_STMT(Stmt, buf);
+  /* Giving the server time to close the socket */
+  Sleep(1000);
+
+  CHECK_DBC_RC(Connection2, SQLGetConnectAttr(Connection2, SQL_ATTR_CONNECTION_DEAD, &is_dead, sizeof(is_dead), 0));
+  is_num(is_dead, SQL_CD_TRUE);
+
+  CHECK_STMT_RC(Stmt2, SQLFreeStmt(Stmt2, SQL_DROP));
+  CHECK_DBC_RC(Connection2, SQLDisconnect(Connection2));
+  CHECK_DBC_RC(Connection2, SQLFreeHandle(SQL_HANDLE_DBC, Connection2));
+  return OK;
+}
+
+
 /**
  Bug #31055: Uninitiated memory returned by SQLGetFunctions() with
  SQL_API_ODBC3_ALL_FUNCTION
@@ -887,6 +929,63 @@ ODBC_TEST(odbc430)
   return OK;
 }
 
+/* Type info values are served in their types, and can be fetched as any numeric C type, or as string */
+ODBC_TEST(typeinfo_typed_values)
+{
+  SQLSMALLINT DataType, MinScale;
+  SQLINTEGER  ColumnSize;
+  SQLCHAR     TypeName[64], Buffer[64];
+  SQLLEN      TypeNameLen, DataTypeLen, Len;
+  SQLDOUBLE   Radix;
+  int         Rows= 0;
+
+  CHECK_STMT_RC(Stmt, SQLGetTypeInfo(Stmt, SQL_INTEGER));
+  CHECK_STMT_RC(Stmt, SQLBindCol(Stmt, 1, SQL_C_CHAR, TypeName, sizeof(TypeName), &TypeNameLen));
+  CHECK_STMT_RC(Stmt, SQLBindCol(Stmt, 2, SQL_C_SHORT, &DataType, 0, &DataTypeLen));
+  CHECK_STMT_RC(Stmt, SQLBindCol(Stmt, 3, SQL_C_LONG, &ColumnSize, 0, NULL));
+
+  while (SQLFetch(Stmt) != SQL_NO_DATA)
+  {
+    ++Rows;
+    is_num(DataType, SQL_INTEGER);
+    FAIL_IF(strncmp((const char*)TypeName, "INT", 3) != 0 && strncmp((const char*)TypeName, "MEDIUMINT", 9) != 0,
+      "Wrong type name");
+
+    CHECK_STMT_RC(Stmt, SQLGetData(Stmt, 2, SQL_C_CHAR, Buffer, sizeof(Buffer), &Len));
+    IS_STR(Buffer, "4", 2);
+    CHECK_STMT_RC(Stmt, SQLGetData(Stmt, 14, SQL_C_SHORT, &MinScale, 0, NULL));
+    is_num(MinScale, 0);
+    CHECK_STMT_RC(Stmt, SQLGetData(Stmt, 18, SQL_C_DOUBLE, &Radix, 0, NULL));
+    FAIL_IF(Radix != 10.0, "Wrong NUM_PREC_RADIX");
+  }
+  is_num(Rows, 6);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_UNBIND));
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  CHECK_STMT_RC(Stmt, SQLGetTypeInfo(Stmt, SQL_DECIMAL));
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  /* String read in chunks - only the chunks, that do not fit, are truncated */
+  EXPECT_STMT(Stmt, SQLGetData(Stmt, 1, SQL_C_CHAR, Buffer, 5, &Len), SQL_SUCCESS_WITH_INFO);
+  CHECK_SQLSTATE(Stmt, "01004");
+  IS_STR(Buffer, "DECI", sizeof("DECI"));
+  EXPECT_STMT(Stmt, SQLGetData(Stmt, 1, SQL_C_CHAR, Buffer, sizeof(Buffer), &Len), SQL_SUCCESS);
+  IS_STR(Buffer, "MAL", sizeof("MAL"));
+  EXPECT_STMT(Stmt, SQLGetData(Stmt, 1, SQL_C_CHAR, Buffer, sizeof(Buffer), &Len), SQL_NO_DATA);
+  is_num(my_fetch_int(Stmt, 3), 65);
+  CHECK_STMT_RC(Stmt, SQLGetData(Stmt, 14, SQL_C_SHORT, &MinScale, 0, NULL));
+  is_num(MinScale, -308);
+  EXPECT_STMT(Stmt, SQLFetch(Stmt), SQL_NO_DATA);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  /* Type, that is not in the table */
+  CHECK_STMT_RC(Stmt, SQLGetTypeInfo(Stmt, SQL_GUID));
+  EXPECT_STMT(Stmt, SQLFetch(Stmt), SQL_NO_DATA);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  return OK;
+}
+
+
 MA_ODBC_TESTS my_tests[]=
 {
   { t_gettypeinfo, "t_gettypeinfo", NORMAL },
@@ -894,6 +993,7 @@ MA_ODBC_TESTS my_tests[]=
   { t_stmt_attr_status, "t_stmt_attr_status", NORMAL },
   { t_msdev_bug, "t_msdev_bug", NORMAL },
   { t_bug14639, "t_bug14639", NORMAL },
+  { connection_dead_pingidle, "connection_dead_pingidle", NORMAL },
   { t_bug31055, "t_bug31055", NORMAL },
   { t_bug3780, "t_bug3780", NORMAL },
   { t_bug16653, "t_bug16653", NORMAL },
@@ -913,6 +1013,7 @@ MA_ODBC_TESTS my_tests[]=
   { odbc326, "odbc326", NORMAL },
   { odbc313, "odbc313", NORMAL },
   { odbc430, "odbc430", NORMAL },
+  { typeinfo_typed_values, "typeinfo_typed_values", NORMAL },
   { NULL, NULL }
 };
 
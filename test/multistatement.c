@@ -961,6 +961,142 @@ ODBC_TEST(multirs_skip)
   return OK;
 }
 
+/* Next results are read in the background, while the current one is fetched */
+ODBC_TEST(multirs_prefetch)
+{
+  SQLHDBC  Hdbc= NULL;
+  SQLHSTMT Hstmt, Hstmt1;
+  SQLCHAR  buffer[2048];
+  SQLLEN   len;
+
+  CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+  /* 1KB is less than the 2nd result takes, so the prefetch stops after it, and is restarted as the app moves on */
+  Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "PREFETCHSTOPKB=1");
+  FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+  CHECK_STMT_RC(Hstmt, SQLAllocHandle(SQL_HANDLE_STMT, Hdbc, &Hstmt1));
+
+  OK_SIMPLE_STMT(Hstmt, "SELECT 1 UNION SELECT 2;SELECT REPEAT('a', 1500);SET @t_prefetch=3;SELECT @t_prefetch;SELECT 5");
+  is_num(myrowcount(Hstmt), 2);
+  CHECK_STMT_RC(Hstmt, SQLMoreResults(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 1, SQL_C_CHAR, buffer, sizeof(buffer), &len));
+  is_num(len, 1500);
+  CHECK_STMT_RC(Hstmt, SQLMoreResults(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLMoreResults(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 1), 3);
+  CHECK_STMT_RC(Hstmt, SQLMoreResults(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 1), 5);
+  EXPECT_STMT(Hstmt, SQLMoreResults(Hstmt), SQL_NO_DATA);
+
+  /* The error read in the background is returned, when the app gets to that result */
+  OK_SIMPLE_STMT(Hstmt, "SELECT 1;SELECT 2;SELECT * FROM t_prefetch_nonexistent");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLMoreResults(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 1), 2);
+  EXPECT_STMT(Hstmt, SQLMoreResults(Hstmt), SQL_ERROR);
+  CHECK_SQLSTATE(Hstmt, "42S02");
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  /* Closing the cursor, cancelling, and other statement's query, while the prefetch may be going on */
+  OK_SIMPLE_STMT(Hstmt, "SELECT 1;SELECT 2;SELECT 3");
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+  OK_SIMPLE_STMT(Hstmt, "SELECT 1;SELECT 2;SELECT 3");
+  CHECK_STMT_RC(Hstmt, SQLCancel(Hstmt));
+  OK_SIMPLE_STMT(Hstmt, "SELECT 1;SELECT 2;SELECT 3");
+  OK_SIMPLE_STMT(Hstmt1, "SELECT 100");
+  CHECK_STMT_RC(Hstmt1, SQLFetch(Hstmt1));
+  is_num(my_fetch_int(Hstmt1, 1), 100);
+  CHECK_STMT_RC(Hstmt1, SQLFreeStmt(Hstmt1, SQL_CLOSE));
+  CHECK_STMT_RC(Hstmt, SQLMoreResults(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLMoreResults(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 1), 3);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  /* Checking, that results have been read in the background indeed, and that the threshold is the one to stop after.
+     Big results are far more than socket buffers can take, and the server can't get to the INSERT, till somebody
+     reads both of them. The 1st is read in the background, though it alone takes more than the threshold. The
+     prefetch stops after it, and the 2nd is read only when the app moves to the 1st */
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_prefetch_ran");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_prefetch_ran (id INT NOT NULL)");
+  OK_SIMPLE_STMT(Hstmt, "SELECT 1;"
+    "WITH RECURSIVE r(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM r WHERE i < 24) SELECT REPEAT('a', 1048576) FROM r;"
+    "WITH RECURSIVE r(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM r WHERE i < 24) SELECT REPEAT('b', 1048576) FROM r;"
+    "INSERT INTO t_prefetch_ran VALUES(1)");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 1), 1);
+  Sleep(3000);
+  OK_SIMPLE_STMT(Stmt, "SELECT COUNT(*) FROM t_prefetch_ran");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  is_num(my_fetch_int(Stmt, 1), 0);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  CHECK_STMT_RC(Hstmt, SQLMoreResults(Hstmt));
+  {
+    int i, count= 0;
+    for (i= 0; i < 30 && count == 0; ++i)
+    {
+      Sleep(1000);
+      OK_SIMPLE_STMT(Stmt, "SELECT COUNT(*) FROM t_prefetch_ran");
+      CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+      count= my_fetch_int(Stmt, 1);
+      CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+    }
+    is_num(count, 1);
+  }
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 1, SQL_C_CHAR, buffer, 2, &len));
+  is_num(len, 1048576);
+  IS_STR(buffer, "a", 2);
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_prefetch_ran");
+
+  CHECK_STMT_RC(Hstmt1, SQLFreeStmt(Hstmt1, SQL_DROP));
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+  CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+
+  return OK;
+}
+
+/* SQLCancel, while the next result is being read in the background, and the server is busy with it. The query
+   has to be killed, and SQLCancel must not wait for it to finish */
+ODBC_TEST(multirs_prefetch_cancel)
+{
+  SQLHDBC  Hdbc= NULL;
+  SQLHSTMT Hstmt;
+  time_t   start;
+
+  CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+  Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "PREFETCHSTOPKB=1024");
+  FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+
+  start= time(NULL);
+  OK_SIMPLE_STMT(Hstmt, "SELECT 1;SELECT SLEEP(600);SELECT 3");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 1), 1);
+  /* Giving the prefetch time to get to the SLEEP */
+  Sleep(1000);
+  CHECK_STMT_RC(Hstmt, SQLCancel(Hstmt));
+  FAIL_IF(time(NULL) - start > 60, "SQLCancel has waited for the query");
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_CLOSE));
+
+  /* The connection is still usable */
+  OK_SIMPLE_STMT(Hstmt, "SELECT 2");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  is_num(my_fetch_int(Hstmt, 1), 2);
+
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+  CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+
+  return OK;
+}
+
+
 MA_ODBC_TESTS my_tests[]=
 {
   {test_multi_statements, "test_multi_statements"},
@@ -983,6 +1119,8 @@ MA_ODBC_TESTS my_tests[]=
   {multirs_caching, "t_odbc432_test_multirs_caching"},
   {otherstmts_result, "t_odbc433_otherstmts_results"},
   {multirs_skip, "test_multirs_skip"},
+  {multirs_prefetch, "test_multirs_prefetch"},
+  {multirs_prefetch_cancel, "test_multirs_prefetch_cancel"},
   {NULL, NULL}
 };
 
@@ -1696,6 +1696,232 @@ ODBC_TEST(odbc279)
 }
 
 
+/* Driver specific statement attribute, continuing the parameters array execution after failed parameter sets */
+#define SQL_ATTR_MADB_CONTINUE_ON_ERROR (0x00004000 + 1)
+
+ODBC_TEST(paramarray_continue_on_error)
+{
+#define PARAMSET_SIZE 10
+  SQLINTEGER   c1[PARAMSET_SIZE]= {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  SQLINTEGER   c2[PARAMSET_SIZE]= {9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+  SQLUSMALLINT Status[PARAMSET_SIZE];
+  SQLULEN      Processed= 0, Attr= 0;
+  SQLCHAR      SqlState[6], Message[255];
+  SQLINTEGER   NativeError, DiagCount= 0;
+  SQLLEN       RowNumber= 0;
+  SQLSMALLINT  MsgLen;
+  int i;
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_paramarray_continue");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_paramarray_continue (c1 INT PRIMARY KEY NOT NULL, c2 INT)");
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_paramarray_continue VALUES (1, 1), (8, 8)");
+
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_MADB_CONTINUE_ON_ERROR, (SQLPOINTER)SQL_TRUE, 0));
+  CHECK_STMT_RC(Stmt, SQLGetStmtAttr(Stmt, SQL_ATTR_MADB_CONTINUE_ON_ERROR, &Attr, 0, NULL));
+  is_num(Attr, SQL_TRUE);
+
+  CHECK_STMT_RC(Stmt, SQLPrepare(Stmt, (SQLCHAR *)"INSERT INTO t_paramarray_continue VALUES (?, ?)", SQL_NTS));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)PARAMSET_SIZE, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAM_STATUS_PTR, Status, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &Processed, 0));
+  CHECK_STMT_RC(Stmt, SQLBindParameter(Stmt, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER, 0, 0, c1, 0, NULL));
+  CHECK_STMT_RC(Stmt, SQLBindParameter(Stmt, 2, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER, 0, 0, c2, 0, NULL));
+
+  EXPECT_STMT(Stmt, SQLExecute(Stmt), SQL_SUCCESS_WITH_INFO);
+  is_num(Processed, PARAMSET_SIZE);
+
+  for (i= 0; i < PARAMSET_SIZE; ++i)
+  {
+    is_num(Status[i], (i == 1 || i == 8) ? SQL_PARAM_ERROR : SQL_PARAM_SUCCESS);
+  }
+
+  /* Record for each failed parameter set */
+  CHECK_STMT_RC(Stmt, SQLGetDiagField(SQL_HANDLE_STMT, Stmt, 0, SQL_DIAG_NUMBER, &DiagCount, SQL_IS_INTEGER, NULL));
+  is_num(DiagCount, 2);
+
+  CHECK_STMT_RC(Stmt, SQLGetDiagRec(SQL_HANDLE_STMT, Stmt, 1, SqlState, &NativeError, Message, sizeof(Message), &MsgLen));
+  IS_STR(SqlState, "23000", 6);
+  FAIL_IF(strstr((char*)Message, "Duplicate entry '1'") == NULL, "Wrong error for the 1st record");
+  CHECK_STMT_RC(Stmt, SQLGetDiagField(SQL_HANDLE_STMT, Stmt, 1, SQL_DIAG_ROW_NUMBER, &RowNumber, SQL_IS_INTEGER, NULL));
+  is_num(RowNumber, 2);
+
+  CHECK_STMT_RC(Stmt, SQLGetDiagRec(SQL_HANDLE_STMT, Stmt, 2, SqlState, &NativeError, Message, sizeof(Message), &MsgLen));
+  FAIL_IF(strstr((char*)Message, "Duplicate entry '8'") == NULL, "Wrong error for the 2nd record");
+  CHECK_STMT_RC(Stmt, SQLGetDiagField(SQL_HANDLE_STMT, Stmt, 2, SQL_DIAG_ROW_NUMBER, &RowNumber, SQL_IS_INTEGER, NULL));
+  is_num(RowNumber, 9);
+
+  EXPECT_STMT(Stmt, SQLGetDiagRec(SQL_HANDLE_STMT, Stmt, 3, SqlState, &NativeError, Message, sizeof(Message), &MsgLen), SQL_NO_DATA);
+
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAM_STATUS_PTR, NULL, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMS_PROCESSED_PTR, NULL, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_MADB_CONTINUE_ON_ERROR, (SQLPOINTER)SQL_FALSE, 0));
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_RESET_PARAMS));
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt, "SELECT COUNT(*) FROM t_paramarray_continue");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  is_num(my_fetch_int(Stmt, 1), 10);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_paramarray_continue");
+
+  return OK;
+#undef PARAMSET_SIZE
+}
+
+
+/* Driver specific statement attribute, sending the parameters array of plain INSERT IGNORE as LOAD DATA LOCAL INFILE
+   input */
+#define SQL_ATTR_MADB_LOAD_DATA (0x00004000 + 2)
+
+ODBC_TEST(paramarray_load_data)
+{
+#define PARAMSET_SIZE 4
+  SQLINTEGER   a[PARAMSET_SIZE]= {1, 2, 3, 4};
+  SQLCHAR      b[PARAMSET_SIZE][16]= {"one", "tab\there", "new\nline", "back\\slash"};
+  SQLLEN       bLen[PARAMSET_SIZE]= {SQL_NTS, SQL_NTS, SQL_NULL_DATA, SQL_NTS};
+  SQLDOUBLE    c[PARAMSET_SIZE]= {0.1, -1e-10, 12345.678, 0};
+  SQLUSMALLINT Status[PARAMSET_SIZE];
+  SQLULEN      Attr= 0;
+  SQLLEN       RowCount= 0, len;
+  SQLCHAR      buffer[16];
+  int i, LocalInfile;
+
+  OK_SIMPLE_STMT(Stmt, "SELECT @@local_infile");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  LocalInfile= my_fetch_int(Stmt, 1);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_paramarray_load");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_paramarray_load (a INT PRIMARY KEY NOT NULL, b VARCHAR(16), c DOUBLE)");
+
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_MADB_LOAD_DATA, (SQLPOINTER)SQL_TRUE, 0));
+  CHECK_STMT_RC(Stmt, SQLGetStmtAttr(Stmt, SQL_ATTR_MADB_LOAD_DATA, &Attr, 0, NULL));
+  is_num(Attr, SQL_TRUE);
+
+  CHECK_STMT_RC(Stmt, SQLPrepare(Stmt, (SQLCHAR *)"INSERT IGNORE INTO t_paramarray_load (a, b, c) VALUES (?, ?, ?)", SQL_NTS));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)PARAMSET_SIZE, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAM_STATUS_PTR, Status, 0));
+  CHECK_STMT_RC(Stmt, SQLBindParameter(Stmt, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER, 0, 0, a, 0, NULL));
+  CHECK_STMT_RC(Stmt, SQLBindParameter(Stmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 16, 0, b, sizeof(b[0]), bLen));
+  CHECK_STMT_RC(Stmt, SQLBindParameter(Stmt, 3, SQL_PARAM_INPUT, SQL_C_DOUBLE, SQL_DOUBLE, 0, 0, c, 0, NULL));
+
+  CHECK_STMT_RC(Stmt, SQLExecute(Stmt));
+  CHECK_STMT_RC(Stmt, SQLRowCount(Stmt, &RowCount));
+  is_num(RowCount, PARAMSET_SIZE);
+  for (i= 0; i < PARAMSET_SIZE; ++i)
+  {
+    is_num(Status[i], SQL_PARAM_SUCCESS);
+  }
+
+  /* With LOAD DATA, duplicates are skipped with warnings, and it can't tell which parameter sets they were */
+  if (LocalInfile)
+  {
+    a[0]= 5;
+    EXPECT_STMT(Stmt, SQLExecute(Stmt), SQL_SUCCESS_WITH_INFO);
+    CHECK_SQLSTATE(Stmt, "01000");
+    CHECK_STMT_RC(Stmt, SQLRowCount(Stmt, &RowCount));
+    is_num(RowCount, 1);
+    for (i= 0; i < PARAMSET_SIZE; ++i)
+    {
+      is_num(Status[i], SQL_PARAM_DIAG_UNAVAILABLE);
+    }
+    a[0]= 1;
+  }
+
+  /* LOAD DATA is not used without IGNORE - failing rows of plain INSERT may not be silently skipped */
+  CHECK_STMT_RC(Stmt, SQLPrepare(Stmt, (SQLCHAR *)"INSERT INTO t_paramarray_load (a, b, c) VALUES (?, ?, ?)", SQL_NTS));
+  EXPECT_STMT(Stmt, SQLExecute(Stmt), SQL_ERROR);
+  CHECK_SQLSTATE(Stmt, "23000");
+
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAM_STATUS_PTR, NULL, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_MADB_LOAD_DATA, (SQLPOINTER)SQL_FALSE, 0));
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_RESET_PARAMS));
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt, "SELECT a, b, c FROM t_paramarray_load WHERE a < 5 ORDER BY a");
+  for (i= 0; i < PARAMSET_SIZE; ++i)
+  {
+    CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+    is_num(my_fetch_int(Stmt, 1), a[i]);
+    CHECK_STMT_RC(Stmt, SQLGetData(Stmt, 2, SQL_C_CHAR, buffer, sizeof(buffer), &len));
+    if (bLen[i] == SQL_NULL_DATA)
+    {
+      is_num(len, SQL_NULL_DATA);
+    }
+    else
+    {
+      IS_STR(buffer, b[i], strlen((char*)b[i]) + 1);
+    }
+  }
+  EXPECT_STMT(Stmt, SQLFetch(Stmt), SQL_NO_DATA);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt, "SELECT COUNT(*) FROM t_paramarray_load WHERE a = 5 OR c = -1e-10");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  is_num(my_fetch_int(Stmt, 1), LocalInfile ? 2 : 1);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_paramarray_load");
+
+  return OK;
+#undef PARAMSET_SIZE
+}
+
+
+/* Same with non-transactional table. Rows before the failed one stay inserted after the failure, and must not be
+   inserted again - that would be duplicate key errors for successful parameter sets */
+ODBC_TEST(paramarray_continue_on_error_myisam)
+{
+#define PARAMSET_SIZE 10
+  SQLINTEGER   c1[PARAMSET_SIZE]= {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  SQLUSMALLINT Status[PARAMSET_SIZE];
+  SQLULEN      Processed= 0;
+  SQLINTEGER   DiagCount= 0;
+  int i;
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_paramarray_continue_myisam");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_paramarray_continue_myisam (c1 INT PRIMARY KEY NOT NULL) ENGINE=MyISAM");
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_paramarray_continue_myisam VALUES (3), (7)");
+
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_MADB_CONTINUE_ON_ERROR, (SQLPOINTER)SQL_TRUE, 0));
+  CHECK_STMT_RC(Stmt, SQLPrepare(Stmt, (SQLCHAR *)"INSERT INTO t_paramarray_continue_myisam VALUES (?)", SQL_NTS));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)PARAMSET_SIZE, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAM_STATUS_PTR, Status, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &Processed, 0));
+  CHECK_STMT_RC(Stmt, SQLBindParameter(Stmt, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER, 0, 0, c1, 0, NULL));
+
+  EXPECT_STMT(Stmt, SQLExecute(Stmt), SQL_SUCCESS_WITH_INFO);
+  is_num(Processed, PARAMSET_SIZE);
+
+  for (i= 0; i < PARAMSET_SIZE; ++i)
+  {
+    is_num(Status[i], (i == 3 || i == 7) ? SQL_PARAM_ERROR : SQL_PARAM_SUCCESS);
+  }
+  CHECK_STMT_RC(Stmt, SQLGetDiagField(SQL_HANDLE_STMT, Stmt, 0, SQL_DIAG_NUMBER, &DiagCount, SQL_IS_INTEGER, NULL));
+  is_num(DiagCount, 2);
+
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAM_STATUS_PTR, NULL, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_PARAMS_PROCESSED_PTR, NULL, 0));
+  CHECK_STMT_RC(Stmt, SQLSetStmtAttr(Stmt, SQL_ATTR_MADB_CONTINUE_ON_ERROR, (SQLPOINTER)SQL_FALSE, 0));
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_RESET_PARAMS));
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt, "SELECT COUNT(*) FROM t_paramarray_continue_myisam");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  is_num(my_fetch_int(Stmt, 1), 10);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_paramarray_continue_myisam");
+
+  return OK;
+#undef PARAMSET_SIZE
+}
+
+
 MA_ODBC_TESTS my_tests[]=
 {
   {my_init_table, "my_init_table"},
@@ -1726,6 +1952,9 @@ MA_ODBC_TESTS my_tests[]=
   {timestruct_param, "timestruct_param-seconds"},
   {consequent_direxec, "consequent_direxec"},
   {odbc279, "odbc-279-timestruct"},
+  {paramarray_continue_on_error, "paramarray_continue_on_error"},
+  {paramarray_continue_on_error_myisam, "paramarray_continue_on_error_myisam"},
+  {paramarray_load_data, "paramarray_load_data"},
   {NULL, NULL}
 };
 
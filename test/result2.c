@@ -1241,6 +1241,42 @@ ODBC_TEST(t_odbc133)
   return OK;
 }
 
+/* Decimal value, that takes the whole buffer of the fetched numeric - it is not null-terminated there. The shorter
+   value fetched after it may not be mixed up with its leftovers */
+ODBC_TEST(t_numeric_full_buffer)
+{
+  SQL_NUMERIC_STRUCT F1;
+  SQLHANDLE Ard;
+
+  OK_SIMPLE_STMT(Stmt, "SELECT CAST(-1234567890123456789012345678901234567.8 AS DECIMAL(38,1)) UNION ALL "
+                       "SELECT CAST(2.5 AS DECIMAL(38,1))");
+
+  CHECK_STMT_RC(Stmt, SQLBindCol(Stmt, 1, SQL_C_NUMERIC, &F1, sizeof(F1), NULL));
+  CHECK_HANDLE_RC(SQL_HANDLE_STMT, Stmt, SQLGetStmtAttr(Stmt, SQL_ATTR_APP_ROW_DESC, &Ard, 0, NULL));
+  CHECK_HANDLE_RC(SQL_HANDLE_DESC, Ard, SQLSetDescField(Ard, 1, SQL_DESC_PRECISION,
+    (SQLPOINTER)38, SQL_IS_INTEGER));
+  CHECK_HANDLE_RC(SQL_HANDLE_DESC, Ard, SQLSetDescField(Ard, 1, SQL_DESC_SCALE,
+    (SQLPOINTER)1, SQL_IS_INTEGER));
+  CHECK_HANDLE_RC(SQL_HANDLE_DESC, Ard, SQLSetDescField(Ard, 1, SQL_DESC_DATA_PTR,
+    &F1, SQL_IS_POINTER));
+
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  is_num(F1.sign, 0);
+  is_num(F1.scale, 1);
+  IS(!memcmp(F1.val, "\x4e\xf3\x38\xde\x50\x90\x49\xc4\x13\x33\x02\xf0\xf6\xb0\x49\x09", SQL_MAX_NUMERIC_LEN));
+
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  is_num(F1.sign, 1);
+  is_num(F1.scale, 1);
+  IS(!memcmp(F1.val, "\x19\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0", SQL_MAX_NUMERIC_LEN));
+
+  EXPECT_STMT(Stmt, SQLFetch(Stmt), SQL_NO_DATA);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  return OK;
+}
+
+
 /* ODBC-146 - boils down to incorrect conversion into SQL_NUMERIC in case of SQLGetData,
    and with binding it worked well */
 ODBC_TEST(t_odbc146)
@@ -1669,6 +1705,7 @@ MA_ODBC_TESTS my_tests[]=
   {t_odbc73, "t_odbc-73-bin_collation"},
   {t_odbc134, "t_odbc-134-fetch_unbound_null"},
   {t_odbc133, "t_odbc-133-numeric"},
+  {t_numeric_full_buffer, "t_numeric_full_buffer"},
   {t_odbc146, "t_odbc146_numeric_getdata"},
   { t_odbc194, "t_odbc194_null_date"},
   {t_odbc192, "t_odbc192"},
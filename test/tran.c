@@ -250,6 +250,97 @@ ODBC_TEST(t_isolation3)
   return OK;
 }
 
+/* Autocommit, isolation level and catalog are sent to the server along with the next command, if they don't need to
+   go right away. Checking, that the pending state is applied, and that the change, rejected by the server, is neither
+   lost nor blocks the connection, after the application has set the attribute again */
+static int check_deferred_session_state(SQLHANDLE dbc, SQLHANDLE Stmt1)
+{
+  SQLINTEGER isolation= 0;
+  SQLCHAR buffer[64];
+
+  /* Both changes go with the single SET in front of the SELECT, or before it, if multi-statements are not enabled */
+  CHECK_DBC_RC(dbc, SQLSetConnectAttr(dbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0));
+  CHECK_DBC_RC(dbc, SQLSetConnectAttr(dbc, SQL_ATTR_TXN_ISOLATION, (SQLPOINTER)SQL_TXN_READ_COMMITTED, 0));
+  CHECK_DBC_RC(dbc, SQLGetConnectAttr(dbc, SQL_ATTR_TXN_ISOLATION, &isolation, SQL_IS_POINTER, NULL));
+  is_num(isolation, SQL_TXN_READ_COMMITTED);
+
+  if (ServerNotOlderThan(Connection, 11, 1, 1) || IsMysql)
+  {
+    OK_SIMPLE_STMT(Stmt1, "SELECT @@autocommit, @@transaction_isolation");
+  }
+  else
+  {
+    OK_SIMPLE_STMT(Stmt1, "SELECT @@autocommit, @@tx_isolation");
+  }
+  CHECK_STMT_RC(Stmt1, SQLFetch(Stmt1));
+  is_num(my_fetch_int(Stmt1, 1), 0);
+  IS_STR(my_fetch_str(Stmt1, buffer, 2), "READ-COMMITTED", sizeof("READ-COMMITTED"));
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_CLOSE));
+
+  /* Switching autocommit on commits the transaction, and that must not wait for the next command */
+  OK_SIMPLE_STMT(Stmt1, "INSERT INTO t_deferred_state VALUES(1)");
+  CHECK_DBC_RC(dbc, SQLSetConnectAttr(dbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0));
+
+  /* Catalog change is applied with the next statement */
+  CHECK_DBC_RC(dbc, SQLSetConnectAttr(dbc, SQL_ATTR_CURRENT_CATALOG, (SQLPOINTER)"information_schema", SQL_NTS));
+  OK_SIMPLE_STMT(Stmt1, "SELECT DATABASE()");
+  CHECK_STMT_RC(Stmt1, SQLFetch(Stmt1));
+  IS_STR(my_fetch_str(Stmt1, buffer, 1), "information_schema", sizeof("information_schema"));
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_CLOSE));
+
+  /* Non-existent catalog fails the statement it comes with, and stays pending - the statement after fails too */
+  OK_SIMPLE_STMT(Stmt1, "DROP DATABASE IF EXISTS t_deferred_state_nodb");
+  CHECK_DBC_RC(dbc, SQLSetConnectAttr(dbc, SQL_ATTR_CURRENT_CATALOG, (SQLPOINTER)"t_deferred_state_nodb", SQL_NTS));
+  EXPECT_STMT(Stmt1, SQLExecDirect(Stmt1, (SQLCHAR*)"SELECT 1", SQL_NTS), SQL_ERROR);
+  CHECK_SQLSTATE(Stmt1, "42000");
+  EXPECT_STMT(Stmt1, SQLExecDirect(Stmt1, (SQLCHAR*)"SELECT 1", SQL_NTS), SQL_ERROR);
+  CHECK_SQLSTATE(Stmt1, "42000");
+
+  /* Setting the catalog again replaces the rejected change */
+  CHECK_DBC_RC(dbc, SQLSetConnectAttr(dbc, SQL_ATTR_CURRENT_CATALOG, (SQLPOINTER)my_schema, SQL_NTS));
+  OK_SIMPLE_STMT(Stmt1, "SELECT DATABASE()");
+  CHECK_STMT_RC(Stmt1, SQLFetch(Stmt1));
+  IS_STR(my_fetch_str(Stmt1, buffer, 1), my_schema, strlen((const char*)my_schema) + 1);
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_CLOSE));
+
+  return OK;
+}
+
+
+ODBC_TEST(t_deferred_session_state)
+{
+  SQLHANDLE dbc= NULL, Stmt1= NULL;
+  unsigned long noMsOptions= my_options & (~67108864);
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_deferred_state");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_deferred_state (id INT NOT NULL) ENGINE=InnoDB");
+
+  IS(AllocEnvConn(&Env, &dbc));
+  Stmt1= DoConnect(dbc, FALSE, NULL, NULL, NULL, 0, NULL, 0, NULL, NULL);
+  FAIL_IF(Stmt1 == NULL, "Could not connect and/or allocate statement");
+  IS(check_deferred_session_state(dbc, Stmt1) == OK);
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_DROP));
+  CHECK_DBC_RC(dbc, SQLDisconnect(dbc));
+
+  /* Same, but the changes have to be sent separately */
+  Stmt1= DoConnect(dbc, FALSE, NULL, NULL, NULL, 0, NULL, &noMsOptions, NULL, NULL);
+  FAIL_IF(Stmt1 == NULL, "Could not connect and/or allocate statement");
+  IS(check_deferred_session_state(dbc, Stmt1) == OK);
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_DROP));
+  CHECK_DBC_RC(dbc, SQLDisconnect(dbc));
+  CHECK_DBC_RC(dbc, SQLFreeConnect(dbc));
+
+  /* The rows have been committed before disconnect */
+  OK_SIMPLE_STMT(Stmt, "SELECT COUNT(*) FROM t_deferred_state");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  is_num(my_fetch_int(Stmt, 1), 2);
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_deferred_state");
+
+  return OK;
+}
+
 MA_ODBC_TESTS my_tests[]=
 {
   {my_transaction,"my_transaction"},
@@ -257,6 +348,7 @@ MA_ODBC_TESTS my_tests[]=
   {t_isolation, "t_isolation"},
   {t_isolation2, "t_isolation2_value_change_tracking"},
   {t_isolation3, "t_isolation3_set_before_connect"},
+  {t_deferred_session_state, "t_deferred_session_state"},
   {NULL, NULL}
 };
 
@@ -1146,8 +1146,22 @@ ODBC_TEST(t_sqlnum_to_str)
 
   {SQLCHAR numdata[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0,0,0,0,0,0,0,0 };
   IS(OK == sqlnum_test_to_str(Stmt, numdata, 21, 0, 1, "18446744073709551615", "")); } /* Current MAX */
+  /* All 16 bytes of the value are used */
   {SQLCHAR numdata[] = { 0x00, 0x00, 0x00, 0x00, 0,0,0,0,0x01,0,0,0,0,0,0,0 };
-  IS(OK == sqlnum_test_to_str(Stmt, numdata, 21, 0, 1, "18446744073709551616", "22003")); } /* Current MAX+1 */
+  IS(OK == sqlnum_test_to_str(Stmt, numdata, 21, 0, 1, "18446744073709551616", "")); }
+  {SQLCHAR numdata[] = { 0x00, 0x00, 0x00, 0x00, 0,0,0,0,0x01,0,0,0,0,0,0,0 };
+  IS(OK == sqlnum_test_to_str(Stmt, numdata, 19, 0, 1, "18446744073709551616", "22003")); }
+  {SQLCHAR numdata[] = { 0x00, 0x00, 0x00, 0x00, 0,0,0,0,0,0,0,0,0,0,0,0x01 };
+  IS(OK == sqlnum_test_to_str(Stmt, numdata, 38, 2, 0, "-13292279957849158729038070602803445.76", "")); }
+
+  /* Extreme scales must not write past the conversion buffer */
+  {SQLCHAR numdata[]= {0xD5, 0x50, 0x94, 0x49, 0,0,0,0,0,0,0,0,0,0,0,0};
+   IS(OK == sqlnum_test_to_str(Stmt, numdata, 10, -128, 1, "", "22003"));}
+  {SQLCHAR numdata[]= {0xD5, 0x50, 0x94, 0x49, 0,0,0,0,0,0,0,0,0,0,0,0};
+   IS(OK == sqlnum_test_to_str(Stmt, numdata, 10, 127, 1, "0.00000000000000000000000000001234456789", ""));}
+  /* Max value does not fit the precision */
+  {SQLCHAR numdata[]= {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+   IS(OK == sqlnum_test_to_str(Stmt, numdata, 20, 0, 0, "", "22003"));}
 
   return OK;
 }
@@ -1386,6 +1400,96 @@ ODBC_TEST(t_odbc405)
 }
 
 
+/* Numbers of text protocol results are parsed by 8 digits at once, and doubles have the fast path. Checking values
+   around chunk boundaries and limits of both, signs, leading zeros and exponents */
+ODBC_TEST(text_number_parsing)
+{
+  SQLHDBC    Hdbc= NULL;
+  SQLHSTMT   Hstmt;
+  SQLBIGINT  sbig;
+  SQLUBIGINT ubig;
+  SQLINTEGER i, slong;
+  double     dbl;
+  const SQLBIGINT  Ints[]= {0, -7, 12345678, -12345678, 123456789, -1234567890123456LL, 12345678901234567LL,
+                            9223372036854775807LL, -9223372036854775807LL - 1};
+  const double     Doubles[]= {0.1, -0.5, 1e22, 1e23, 1e-22, 1.2345e-5, 9007199254740992.0, -1.5e-22,
+                               123456789012345678901234567890.0, 2.2250738585072014e-308, 1.7976931348623157e308};
+
+  OK_SIMPLE_STMT(Stmt, "SELECT 0, -7, 12345678, -12345678, 123456789, -1234567890123456, 12345678901234567,"
+    "9223372036854775807, CAST(-9223372036854775808 AS SIGNED)");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  for (i= 0; i < (SQLINTEGER)(sizeof(Ints)/sizeof(Ints[0])); ++i)
+  {
+    CHECK_STMT_RC(Stmt, SQLGetData(Stmt, (SQLUSMALLINT)(i + 1), SQL_C_SBIGINT, &sbig, 0, NULL));
+    FAIL_IF(sbig != Ints[i], "Wrong integer value");
+  }
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  /* Leading zeros: 20 digits of the unsigned max length, and zeros taking whole chunks before the significant digits */
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE IF EXISTS t_text_number_parsing");
+  OK_SIMPLE_STMT(Stmt, "CREATE TABLE t_text_number_parsing (z BIGINT(20) UNSIGNED ZEROFILL, y INT(12) ZEROFILL,"
+    "d DOUBLE(22,2) ZEROFILL)");
+  OK_SIMPLE_STMT(Stmt, "INSERT INTO t_text_number_parsing VALUES (42, 123456789, 1.5)");
+  OK_SIMPLE_STMT(Stmt, "SELECT z, y, d FROM t_text_number_parsing");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  CHECK_STMT_RC(Stmt, SQLGetData(Stmt, 1, SQL_C_UBIGINT, &ubig, 0, NULL));
+  FAIL_IF(ubig != 42, "Wrong unsigned value");
+  CHECK_STMT_RC(Stmt, SQLGetData(Stmt, 2, SQL_C_SBIGINT, &sbig, 0, NULL));
+  FAIL_IF(sbig != 123456789, "Wrong integer value");
+  CHECK_STMT_RC(Stmt, SQLGetData(Stmt, 3, SQL_C_DOUBLE, &dbl, 0, NULL));
+  FAIL_IF(dbl != 1.5, "Wrong double value");
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+  OK_SIMPLE_STMT(Stmt, "DROP TABLE t_text_number_parsing");
+
+  /* Max unsigned, and values overflowing the target type */
+  OK_SIMPLE_STMT(Stmt, "SELECT 18446744073709551615, 9223372036854775808, 4294967296, -2147483649");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  CHECK_STMT_RC(Stmt, SQLGetData(Stmt, 1, SQL_C_UBIGINT, &ubig, 0, NULL));
+  FAIL_IF(ubig != 18446744073709551615ULL, "Wrong unsigned value");
+  EXPECT_STMT(Stmt, SQLGetData(Stmt, 2, SQL_C_SBIGINT, &sbig, 0, NULL), SQL_ERROR);
+  CHECK_SQLSTATE(Stmt, "22003");
+  EXPECT_STMT(Stmt, SQLGetData(Stmt, 3, SQL_C_LONG, &slong, 0, NULL), SQL_ERROR);
+  CHECK_SQLSTATE(Stmt, "22003");
+  EXPECT_STMT(Stmt, SQLGetData(Stmt, 4, SQL_C_LONG, &slong, 0, NULL), SQL_ERROR);
+  CHECK_SQLSTATE(Stmt, "22003");
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  /* Doubles within and outside of the fast path - exponents beyond 22, significands longer than 53 bits, and the
+     limits of the type. 2^53+1 is not representable, and is rounded by the server already */
+  OK_SIMPLE_STMT(Stmt, "SELECT 0.1e0, -0.5e0, 1e22, 1e23, 1e-22, 1.2345e-5, 9007199254740993e0, -1.5e-22,"
+    "123456789012345678901234567890e0, 2.2250738585072014e-308, 1.7976931348623157e308");
+  CHECK_STMT_RC(Stmt, SQLFetch(Stmt));
+  for (i= 0; i < (SQLINTEGER)(sizeof(Doubles)/sizeof(Doubles[0])); ++i)
+  {
+    CHECK_STMT_RC(Stmt, SQLGetData(Stmt, (SQLUSMALLINT)(i + 1), SQL_C_DOUBLE, &dbl, 0, NULL));
+    FAIL_IF(dbl != Doubles[i], "Wrong double value");
+  }
+  CHECK_STMT_RC(Stmt, SQLFreeStmt(Stmt, SQL_CLOSE));
+
+  /* Values in the local rows store are not NUL-terminated. Numbers below exactly fill 8 byte slots, and are followed
+     by the length of the next value, which first byte is a digit(55 is '7', 53 is '5'). Parser must stop at the
+     value length */
+  CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+  Hstmt= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "SPILLMEM=1;PREPONCLIENT=1");
+  FAIL_IF(Hstmt == NULL, "Could not connect or allocate stmt handle");
+  CHECK_STMT_RC(Hstmt, SQLSetStmtAttr(Hstmt, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)SQL_CURSOR_STATIC, 0));
+  OK_SIMPLE_STMT(Hstmt, "SELECT 12345678, REPEAT('1', 55), 1234567812345678, REPEAT('2', 55), 12345.25e0,"
+    "REPEAT('3', 53)");
+  CHECK_STMT_RC(Hstmt, SQLFetch(Hstmt));
+  CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 1, SQL_C_SBIGINT, &sbig, 0, NULL));
+  FAIL_IF(sbig != 12345678, "Wrong integer value");
+  CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 3, SQL_C_UBIGINT, &ubig, 0, NULL));
+  FAIL_IF(ubig != 1234567812345678ULL, "Wrong unsigned value");
+  CHECK_STMT_RC(Hstmt, SQLGetData(Hstmt, 5, SQL_C_DOUBLE, &dbl, 0, NULL));
+  FAIL_IF(dbl != 12345.25, "Wrong double value");
+  CHECK_STMT_RC(Hstmt, SQLFreeStmt(Hstmt, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+  CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+
+  return OK;
+}
+
+
 MA_ODBC_TESTS my_tests[]=
 {
   {t_longlong1,        "t_longlong1",       NORMAL},
@@ -1414,6 +1518,7 @@ MA_ODBC_TESTS my_tests[]=
   {t_odbc158,          "odbc158_bigintcolumn_as_c_long", NORMAL},
   {t_odbc305,          "odbc305_numeric_as_numeric", NORMAL},
   {t_odbc405,          "odbc405_dec_precision", NORMAL},
+  {text_number_parsing, "text_number_parsing", NORMAL},
   {NULL, NULL, NORMAL}
 };
 
@@ -1845,6 +1845,106 @@ ODBC_TEST(t_odbc443)
 }
 
 
+/* Strings with long ASCII runs around multibyte characters - both, SQLWCHAR units counting, and the conversion take
+   vectorized path for the ASCII parts, and have to stay exact at their edges */
+ODBC_TEST(wstr_ascii_runs)
+{
+  SQLWCHAR chunk[33], value[145], param[71];
+  SQLLEN   len, total= 0;
+  SQLRETURN rc;
+  unsigned int i;
+
+  if (iOdbc())
+  {
+    skip("The test requires 2 bytes SQLWCHAR");
+  }
+
+  OK_SIMPLE_STMTW(wStmt, WW("SELECT CONCAT(REPEAT('a',100), _utf8mb4 0xC3A9, REPEAT('b',40))"));
+  CHECK_STMT_RC(wStmt, SQLFetch(wStmt));
+
+  /* Reading by 32 units, to make the offsets fall in the middle of ASCII runs and of the vector width */
+  while ((rc= SQLGetData(wStmt, 1, SQL_C_WCHAR, chunk, sizeof(chunk), &len)) != SQL_NO_DATA)
+  {
+    SQLLEN got;
+    FAIL_IF(!SQL_SUCCEEDED(rc), "SQLGetData failed");
+    if (total == 0)
+    {
+      is_num(len, 141 * sizeof(SQLWCHAR));
+    }
+    got= rc == SQL_SUCCESS_WITH_INFO ? 32 : len / (SQLLEN)sizeof(SQLWCHAR);
+    FAIL_IF(total + got > 141, "Too much data returned");
+    memcpy(value + total, chunk, got * sizeof(SQLWCHAR));
+    total+= got;
+  }
+  is_num(total, 141);
+  for (i= 0; i < 141; ++i)
+  {
+    is_num(value[i], i < 100 ? 'a' : (i == 100 ? 0xe9 : 'b'));
+  }
+  CHECK_STMT_RC(wStmt, SQLFreeStmt(wStmt, SQL_CLOSE));
+
+  /* SQL_NTS length of the wide parameter */
+  for (i= 0; i < 70; ++i)
+  {
+    param[i]= i == 35 ? 0xe9 : 'x';
+  }
+  param[70]= 0;
+  CHECK_STMT_RC(wStmt, SQLPrepareW(wStmt, WW("SELECT ?"), SQL_NTS));
+  CHECK_STMT_RC(wStmt, SQLBindParameter(wStmt, 1, SQL_PARAM_INPUT, SQL_C_WCHAR, SQL_WVARCHAR, 70, 0, param,
+    sizeof(param), NULL));
+  CHECK_STMT_RC(wStmt, SQLExecute(wStmt));
+  CHECK_STMT_RC(wStmt, SQLFetch(wStmt));
+  CHECK_STMT_RC(wStmt, SQLGetData(wStmt, 1, SQL_C_WCHAR, value, sizeof(value), &len));
+  is_num(len, 70 * sizeof(SQLWCHAR));
+  IS_WSTR(value, param, 71);
+  CHECK_STMT_RC(wStmt, SQLFreeStmt(wStmt, SQL_CLOSE));
+
+  return OK;
+}
+
+
+/* Both directions of the UTF-8 <-> UTF-16 transcoding of the UTF-8 connection, for characters of all UTF-8 sequence
+   lengths including supplementary ones, around ASCII runs */
+ODBC_TEST(wchar_utf8_transcoding)
+{
+  SQLWCHAR param[51], value[64];
+  SQLCHAR  hex[128], hexRef[128]= "616263C3A9E282ACF09F9880";
+  SQLLEN   len, paramLen= SQL_NTS;
+  unsigned int i;
+
+  if (iOdbc())
+  {
+    skip("The test requires 2 bytes SQLWCHAR");
+  }
+
+  param[0]= 'a'; param[1]= 'b'; param[2]= 'c'; param[3]= 0xe9; param[4]= 0x20ac; param[5]= 0xd83d; param[6]= 0xde00;
+  for (i= 7; i < 50; ++i)
+  {
+    param[i]= 'z';
+    strcat((char*)hexRef, "7A");
+  }
+  param[50]= 0;
+
+  CHECK_STMT_RC(wStmt, SQLPrepareW(wStmt, WW("SELECT ?, HEX(CAST(? AS CHAR CHARACTER SET utf8mb4))"), SQL_NTS));
+  CHECK_STMT_RC(wStmt, SQLBindParameter(wStmt, 1, SQL_PARAM_INPUT, SQL_C_WCHAR, SQL_WVARCHAR, 50, 0, param,
+    sizeof(param), &paramLen));
+  CHECK_STMT_RC(wStmt, SQLBindParameter(wStmt, 2, SQL_PARAM_INPUT, SQL_C_WCHAR, SQL_WVARCHAR, 50, 0, param,
+    sizeof(param), &paramLen));
+  CHECK_STMT_RC(wStmt, SQLExecute(wStmt));
+  CHECK_STMT_RC(wStmt, SQLFetch(wStmt));
+
+  CHECK_STMT_RC(wStmt, SQLGetData(wStmt, 1, SQL_C_WCHAR, value, sizeof(value), &len));
+  is_num(len, 50 * sizeof(SQLWCHAR));
+  IS_WSTR(value, param, 51);
+  CHECK_STMT_RC(wStmt, SQLGetData(wStmt, 2, SQL_C_CHAR, hex, sizeof(hex), &len));
+  IS_STR(hex, hexRef, strlen((char*)hexRef) + 1);
+  CHECK_STMT_RC(wStmt, SQLFreeStmt(wStmt, SQL_CLOSE));
+  CHECK_STMT_RC(wStmt, SQLFreeStmt(wStmt, SQL_RESET_PARAMS));
+
+  return OK;
+}
+
+
 MA_ODBC_TESTS my_tests[]=
 {
   {test_CONO1,        "test_CONO1",         NORMAL},
@@ -1880,6 +1980,8 @@ MA_ODBC_TESTS my_tests[]=
   {t_odbc418,         "t_odbc418_0in_string", NORMAL},
   {t_odbc437,         "t_odbc437_stringlen", NORMAL},
   {t_odbc443,         "t_odbc443_SQLGetData_surrogatePair", NORMAL},
+  {wstr_ascii_runs,   "wstr_ascii_runs",    NORMAL},
+  {wchar_utf8_transcoding, "wchar_utf8_transcoding", NORMAL},
 
   {NULL, NULL}
 };
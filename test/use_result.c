@@ -366,6 +366,74 @@ ODBC_TEST(multirs_caching)
 }
 
 
+/* Forward-only result read via server-side cursor in batches of 2 rows. Other statements have to be possible
+   between the batches, and the rows must not be read in advance */
+ODBC_TEST(cursor_fetch)
+{
+  SQLHDBC  Hdbc= NULL;
+  SQLHSTMT Stmt1, Stmt2;
+  SQLINTEGER i;
+  SQLLEN   RowCount= 0;
+
+  CHECK_ENV_RC(Env, SQLAllocConnect(Env, &Hdbc));
+  Stmt1= DoConnect(Hdbc, FALSE, NULL, NULL, NULL, 0, NULL, NULL, NULL, "CURSORFETCH=2;PREPONCLIENT=0");
+  FAIL_IF(Stmt1 == NULL, "Could not connect or allocate stmt handle");
+  CHECK_DBC_RC(Hdbc, SQLAllocHandle(SQL_HANDLE_STMT, Hdbc, &Stmt2));
+
+  OK_SIMPLE_STMT(Stmt1, "DROP TABLE IF EXISTS t_cursor_fetch");
+  OK_SIMPLE_STMT(Stmt1, "CREATE TABLE t_cursor_fetch (a int)");
+  OK_SIMPLE_STMT(Stmt1, "INSERT INTO t_cursor_fetch VALUES (1),(2),(3),(4),(5)");
+
+  CHECK_STMT_RC(Stmt1, SQLPrepare(Stmt1, "SELECT a FROM t_cursor_fetch ORDER BY a", SQL_NTS));
+  CHECK_STMT_RC(Stmt1, SQLExecute(Stmt1));
+
+  for (i= 1; i <= 5; ++i)
+  {
+    CHECK_STMT_RC(Stmt1, SQLFetch(Stmt1));
+    is_num(my_fetch_int(Stmt1, 1), i);
+    /* The row inserted after the cursor has been opened, is not in its result */
+    if (i == 1)
+    {
+      OK_SIMPLE_STMT(Stmt2, "INSERT INTO t_cursor_fetch VALUES (6)");
+    }
+    OK_SIMPLE_STMT(Stmt2, "SELECT COUNT(*) FROM t_cursor_fetch");
+    CHECK_STMT_RC(Stmt2, SQLFetch(Stmt2));
+    is_num(my_fetch_int(Stmt2, 1), 6);
+    CHECK_STMT_RC(Stmt2, SQLFreeStmt(Stmt2, SQL_CLOSE));
+  }
+  EXPECT_STMT(Stmt1, SQLFetch(Stmt1), SQL_NO_DATA);
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_CLOSE));
+
+  /* Closing cursor in the middle of the result */
+  CHECK_STMT_RC(Stmt1, SQLExecute(Stmt1));
+  CHECK_STMT_RC(Stmt1, SQLFetch(Stmt1));
+  is_num(my_fetch_int(Stmt1, 1), 1);
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_CLOSE));
+  CHECK_STMT_RC(Stmt1, SQLExecute(Stmt1));
+  for (i= 1; i <= 6; ++i)
+  {
+    CHECK_STMT_RC(Stmt1, SQLFetch(Stmt1));
+    is_num(my_fetch_int(Stmt1, 1), i);
+  }
+  EXPECT_STMT(Stmt1, SQLFetch(Stmt1), SQL_NO_DATA);
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_CLOSE));
+
+  /* Direct execution is client-side prepared, does not use cursor, and its result is cached as usual */
+  OK_SIMPLE_STMT(Stmt1, "SELECT a FROM t_cursor_fetch");
+  CHECK_STMT_RC(Stmt1, SQLRowCount(Stmt1, &RowCount));
+  is_num(RowCount, 6);
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_CLOSE));
+
+  OK_SIMPLE_STMT(Stmt1, "DROP TABLE t_cursor_fetch");
+  CHECK_STMT_RC(Stmt2, SQLFreeStmt(Stmt2, SQL_DROP));
+  CHECK_STMT_RC(Stmt1, SQLFreeStmt(Stmt1, SQL_DROP));
+  CHECK_DBC_RC(Hdbc, SQLDisconnect(Hdbc));
+  CHECK_DBC_RC(Hdbc, SQLFreeConnect(Hdbc));
+
+  return OK;
+}
+
+
 ODBC_TEST(streaming_is_on)
 {
   // Relying on what the framework has detected for us
@@ -382,6 +450,7 @@ MA_ODBC_TESTS my_tests[]=
   {unbuffered_result, "unbuffered_result"},
   {unbuffered_result_binary, "unbuffered_binary_result"},
   //{multirs_caching, "multiresultset_caching"},
+  {cursor_fetch,      "cursor_fetch"},
   {streaming_is_on,   "streaming_is_on"},
   {NULL, NULL}
 };